@@ -7,85 +7,10545 @@
  */
 
 // Headers
+#include <stddef.h>
+#include <errno.h>
 #include <dict/dict.h>
+#include <dict/dict_define.h>
+
+// POSIX platforms. The expiry thread, journals, shared memory dictionaries and 
+// placement are only available on them
+#if defined(__unix__) || defined(__APPLE__)
+    #define DICT_POSIX
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+
+    // NUMA system calls
+    #ifdef __linux__
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+// Hardware CRC-32C
+#if ( defined(__x86_64__) || defined(_M_X64) ) && ( defined(__GNUC__) || defined(__clang__) )
+    #define DICT_HASH_SSE42
+    #include <nmmintrin.h>
+#endif
+
+// Timer wheel geometry. Each level has 2^DICT_WHEEL_BITS slots of 2^(level * DICT_WHEEL_BITS) wheel ticks
+#define DICT_WHEEL_BITS   6
+#define DICT_WHEEL_SLOTS  ( 1 << DICT_WHEEL_BITS )
+#define DICT_WHEEL_LEVELS 4
+
+// Expiry clock. A test may define DICT_CLOCK as a function of the same type as
+// timer_high_precision, to drive the timer wheel without waiting
+#ifndef DICT_CLOCK
+    #define DICT_CLOCK timer_high_precision
+#else
+    timestamp DICT_CLOCK ( void );
+#endif
+
+// Hash kernels. A test may define DICT_HASH_TEST to call each dict_hash kernel by name
+#ifdef DICT_HASH_TEST
+    unsigned long long dict_hash_with_kernel ( bool sse42, const void *const k, size_t l );
+#endif
+
+// Placed arrays. Hash tables and iterable arrays of at least DICT_PLACEMENT_MIN bytes are
+// mapped, instead of allocated from the heap, when a dictionary has a placement. Huge
+// page backed arrays are rounded up to, and aligned on, DICT_HUGE_PAGE_SIZE bytes
+#define DICT_PLACEMENT_MIN       ( (size_t) 1 << 20 )
+#define DICT_HUGE_PAGE_SIZE      ( (size_t) 2 << 20 )
+#define DICT_MPOL_BIND           2
+#define DICT_MPOL_INTERLEAVE     3
+#define DICT_MPOL_F_MEMS_ALLOWED 4
+
+// Replicated dictionaries. A thread looks its NUMA node up again every
+// DICT_NUMA_NODE_REFRESH reads, and a writer brings every replica up to date once
+// REPLICATED_DICT_LOG_MAX operations are waiting in the log
+#define DICT_NUMA_NODES_MAX     64
+#define DICT_NUMA_NODE_REFRESH  1024
+#define REPLICATED_DICT_LOG_MAX 1024
+
+// Membership filter. Each property counts once in each of DICT_FILTER_HASHES counters
+// of a counting Bloom filter. A counter that reaches DICT_FILTER_SATURATED stays there,
+// since it no longer knows how many properties share it
+#define DICT_FILTER_HASHES    3
+#define DICT_FILTER_SATURATED 0xFF
+
+// Journal layout. The file starts with an 8 byte magic and the 8 byte value size. Each
+// record is a 1 byte type, 4 byte key length, 4 byte value length, the key, the value,
+// and an 8 byte FNV-1a checksum of the bytes before it, all in host byte order
+#define DICT_JOURNAL_MAGIC    "DICTJNL1"
+#define DICT_JOURNAL_HEADER   16
+#define DICT_JOURNAL_OVERHEAD 17
+#define DICT_JOURNAL_ADD      'A'
+#define DICT_JOURNAL_POP      'P'
+#define DICT_JOURNAL_CLEAR    'C'
+
+// Shared memory layout. A region starts with a shm_dict_header, followed by the hash
+// table and an arena. Every reference inside the region is a byte offset from its
+// start, so each process may map it at a different address. Offset 0 is the header,
+// so it doubles as the null reference
+#define SHM_DICT_MAGIC 0x314D485354434944ULL // "DICTSHM1"
+#define SHM_DICT_ALIGN ( (uint64_t) _Alignof(max_align_t) )
+#define SHM_DICT_AT(p_header, offset) ( (void *) ( (unsigned char *) (p_header) + (offset) ) )
 
 // Internal type definitions
-typedef struct dict_item_s dict_item;
+typedef struct dict_item_s  dict_item;
+typedef struct dict_lru_links_s  dict_lru_links;
+typedef struct dict_ttl_links_s  dict_ttl_links;
+typedef struct dict_tree_links_s dict_tree_links;
+typedef struct dict_layout_s     dict_layout;
+typedef struct dict_ext_s        dict_ext;
+typedef struct dict_wheel_s dict_wheel;
+typedef struct dict_op_s    dict_op;
+typedef struct dict_replica_s dict_replica;
+typedef struct dict_journal_s dict_journal;
+typedef struct shm_dict_header_s shm_dict_header;
+typedef struct shm_dict_node_s   shm_dict_node;
+
+// Optional blocks that follow a dict_item, at the offsets in the dictionary's layout.
+// Each block is only allocated if the dictionary uses the feature, so check the
+// offset before using an accessor
+#define DICT_ITEM_BLOCK(property, offset) ( (void *) ( (unsigned char *) (property) + (offset) ) )
+#define DICT_ITEM_LRU(p_dict, property)   ( (dict_lru_links  *) DICT_ITEM_BLOCK(property, (p_dict)->layout.lru ) )
+#define DICT_ITEM_TTL(p_dict, property)   ( (dict_ttl_links  *) DICT_ITEM_BLOCK(property, (p_dict)->layout.ttl ) )
+#define DICT_ITEM_TREE(p_dict, property)  ( (dict_tree_links *) DICT_ITEM_BLOCK(property, (p_dict)->layout.tree) )
 
 // Structure definitions
 struct dict_item_s
 {
-    char   *key;   // The key
-    void   *value; // The value
-    size_t  index; // The index in the iterable lists
+    char               *key;   // The key
+    void               *value; // The value
+    size_t              index; // The index in the iterable lists
+    unsigned long long  hash;  // The hash of the key
 
     dict_item *next; // The next entry
 };
 
+struct dict_lru_links_s
+{
+    dict_item *prev, // The next more recently used entry
+              *next; // The next less recently used entry
+};
+
+struct dict_ttl_links_s
+{
+    timestamp   expiry; // When the entry expires, or 0 if it does not
+    dict_item  *next,   // The next entry in the same timer wheel slot
+              **pprev;  // The link that points to this entry, or null pointer if it is not scheduled
+};
+
+struct dict_tree_links_s
+{
+    dict_item *left,   // Entries with smaller keys
+              *right,  // Entries with larger keys
+              *parent; // The parent entry
+};
+
+struct dict_layout_s
+{
+    size_t lru,   // Offset of the recency links in a dict_item, or 0 if not in LRU mode
+           ttl,   // Offset of the expiry and timer wheel links, or 0 without a timer wheel
+           tree,  // Offset of the sorted index links, or 0 without a sorted index
+           value, // Offset of the inline value, or 0 for pointer values
+           size;  // Bytes of a dict_item, including its blocks and inline value
+};
+
+struct dict_wheel_s
+{
+    dict_item *slots[DICT_WHEEL_LEVELS][DICT_WHEEL_SLOTS]; // Scheduled entries
+    timestamp  resolution;                                // Timer ticks per wheel tick
+    uint64_t   now;                                       // The next wheel tick to process
+    size_t     count;                                     // Scheduled entries
+
+    struct
+    {
+        #ifdef DICT_POSIX
+            pthread_t        thread;    // Background expiry thread
+            pthread_mutex_t  mutex;     // Guards stop
+            pthread_cond_t   cond;      // Signalled to stop the thread
+        #endif
+        bool             running,   // Is the thread running?
+                         stop;      // Should the thread exit?
+        timestamp        interval;  // Timer ticks between steps
+        size_t           max_ticks; // Most wheel ticks per step
+    } thread;
+};
+
+struct dict_journal_s
+{
+    int                  fd;       // Log file, opened for appending
+    char                *path;     // Log file path
+    size_t               size,     // Bytes written to the log file
+                         snapshot; // Bytes in the log file after the last compaction
+    bool                 failed,   // A write failed, so the log is missing records
+                         compacting; // Is a compaction writing the new log file?
+    dict_journal_config  config;   // Sync, batching and compaction policy
+
+    struct
+    {
+        unsigned char *data;  // Records not yet written
+        size_t         count, // Bytes
+                       max;   // Buffer bound
+    } buffer;
+
+    struct
+    {
+        char   **data;  // Keys recovered from the log, which the dictionary borrows
+        size_t   count, // Keys
+                 max,   // Key array bound
+                 bytes; // Bytes of key strings
+    } keys;
+
+    struct
+    {
+        #ifdef DICT_POSIX
+            pthread_t       thread;  // Flushes and compacts the log every interval
+            pthread_mutex_t mutex;   // Guards stop
+            pthread_cond_t  cond;    // Signalled to stop
+        #endif
+        bool            running, // Is the thread running?
+                        stop;    // Should the thread exit?
+    } thread;
+};
+
+struct dict_op_s
+{
+    const char         *key;     // The name of the property, or null pointer to clear, in a replicated dictionary's log
+    void               *p_value; // The value to add, unused by a pop
+    unsigned long long  h;       // The hash of the key, computed by dict_apply_batch
+    bool                pop;     // Remove the property, instead of adding it
+};
+
+struct dict_batch_s
+{
+    dict_op *ops;   // Recorded operations, in order
+    size_t   count, // Operations
+             max;   // Operation array bound
+};
+
+// State only some dictionaries use. Dictionaries without any share dict_ext_none
+struct dict_ext_s
+{
+
+    struct
+    {
+        size_t     capacity; // Most entries before eviction, or 0 if not in LRU mode
+        dict_item *head,     // Most recently used entry
+                  *tail;     // Least recently used entry
+    } lru;
+
+    struct
+    {
+        bool                enabled; // Maintain the sorted index?
+        dict_item          *root;    // Root of the sorted index
+        unsigned long long  seed;    // Mixed with each hash into the property's heap priority
+    } tree;
+
+    struct
+    {
+        dict_item **nodes; // Properties allocated by dict_apply_batch before it took the lock
+        size_t      count; // Properties not yet inserted
+    } spare;
+
+    struct
+    {
+        unsigned char *counters; // Counting Bloom filter over the properties' hashes -OR- null pointer
+        size_t         mask;     // Counters - 1. The counter count is a power of two
+    } filter;
+
+    dict_placement_config placement; // Page size and NUMA policy of the hash table and iterable arrays
+
+    dict_wheel   *p_wheel;   // Timer wheel for entries with a TTL -OR- null pointer
+    dict_journal *p_journal; // Log of every change -OR- null pointer
+    size_t        budget;    // Most bytes the dictionary may allocate, or 0 for no limit
+};
+
 struct dict_s
 {
 
     struct
     {
-        dict_item **data;  // Hash table contents
+        dict_item **data;  // Hash table contents, or null pointer while the dictionary is small
         size_t      max,   // Hash table elements
                     count; // Entries
     } entries;
 
     struct
     {
-        char   **keys;   // Iterable keys
+        char   **keys;   // Iterable keys, in insertion order. A null key is a tombstone left by a pop
         void   **values; // Iterable values
-        size_t   max;    // Iterable array bound
+        size_t   count,  // Slots in use, including tombstones
+                 max;    // Iterable array bound
     } iterable;
 
-    fn_hash64 *pfn_hash_function; // Pointer to the hash function
+    union
+    {
+        struct
+        {
+            unsigned long long  hashes[DICT_SMALL_MAX]; // Cached hashes
+            char               *keys  [DICT_SMALL_MAX]; // Keys
+            void               *values[DICT_SMALL_MAX]; // Values
+        } small; // Inline properties, used until the dictionary outgrows them
+
+        dict_ext ext; // The rare state, in the small properties' place once the dictionary is promoted
+    };
+
+    dict_ext    *p_ext;  // Rare state, in ext -OR- allocated while the dictionary is small -OR- &dict_ext_none
+    dict_layout  layout; // Which blocks follow each dict_item, and where
+
+    void     (*pfn_evict)(const char *const key, void *const value); // Called on each evicted or expired entry -OR- null pointer
+    size_t     value_size;                                            // Bytes of each value, stored inline after its dict_item, or 0 for pointer values
+    fn_hash64 *pfn_hash_function;                                     // Pointer to the hash function
+
+    #ifdef BUILD_DICT_WITH_STATS
+    struct
+    {
+        bool             enabled; // Record statistics?
+        dict_statistics *p_data;  // Counters, allocated by dict_stats_enable -OR- null pointer
+    } stats;
+    #endif
 
     mutex _lock; // Locked when writing values
 };
 
+struct sharded_dict_s
+{
+    dict      **shards;            // Independent dictionaries
+    size_t      count,             // Number of shards, a power of two
+                bits;              // log2(count)
+    fn_hash64  *pfn_hash_function; // Pointer to the hash function shared by every shard
+};
+
+struct dict_replica_s
+{
+    dict   *p_dict;  // Copy of the properties, with its hash table on one NUMA node
+    size_t  applied; // Operations of the log this replica has applied, counted from the first
+};
+
+struct replicated_dict_s
+{
+    dict_replica *replicas;                         // One replica per NUMA node
+    size_t        count,                            // Number of replicas
+                  node_replica[DICT_NUMA_NODES_MAX]; // Index of the replica read by each node
+
+    struct
+    {
+        dict_op *ops;   // Operations not yet applied by every replica, oldest first
+        size_t   count, // Operations
+                 max,   // Operation array bound
+                 base,  // Operations trimmed from the front of the log
+                 end;   // base + count, published to readers that do not hold the lock
+    } log;
+
+    fn_hash64 *pfn_hash_function; // Pointer to the hash function shared by every replica
+
+    mutex _lock; // Locked when writing the log, or applying it to a replica
+};
+
+// Integer keyed dictionary. The table and its unlocked helpers, int_dict_table_find,
+// _resize, _insert and _remove, are the ones DICT_DEFINE generates
+DICT_DEFINE_TABLE(int_dict, int_dict_table, uint64_t, void *, dict_mix64, DICT_EQ)
+
+struct intern_table_s
+{
+    dict *p_dict; // Canonical strings. Each value is the string's ID, which is also its iterable index
+};
+
+#ifdef DICT_POSIX
+struct shm_dict_header_s
+{
+    uint64_t magic;  // SHM_DICT_MAGIC, stored last by shm_dict_create
+    uint64_t layout; // sizeof(shm_dict_header), so a build with a different lock layout refuses to attach
+    uint64_t bytes,      // Size of the region
+             arena,      // Offset of the first byte after the hash table
+             used,       // Offset of the first free byte. Bytes below it are not reused until a clear
+             generation; // Bumped by each clear, before the arena is reused
+
+    struct
+    {
+        uint64_t offset, // Offset of the hash table, an array of node offsets
+                 max,    // Hash table elements
+                 count;  // Entries
+    } buckets;
+
+    struct
+    {
+        uint64_t offset, // Offset of the node offsets, in insertion order. A 0 is a tombstone left by a pop
+                 count,  // Slots in use, including tombstones
+                 max;    // Iterable array bound
+    } iterable;
+
+    pthread_rwlock_t lock; // Process shared. Read locked by lookups, write locked by changes
+};
+
+struct shm_dict_node_s
+{
+    uint64_t hash,  // The hash of the key
+             next,  // Offset of the next node in the same bucket, or 0
+             key,   // Offset of the key, stored after the node
+             value, // Offset of the value
+             size,  // Bytes of the value
+             index; // The index in the iterable array
+};
+#endif
+
+struct shm_dict_s
+{
+    shm_dict_header *p_header; // Start of this process's mapping of the region
+    size_t           bytes;    // Bytes mapped
+    int              fd;       // Shared memory object, or -1 for an anonymous region
+};
+
 // Data
-static bool initialized = false;
+static bool          initialized          = false;
+static unsigned int  crc32c_table[8][256] = { { 0 } };
+static fn_hash64    *pfn_dict_hash        = 0;
+static const dict_ext dict_ext_none       = { 0 };
 
-void dict_init ( void )
+/** !
+ *  Load 8 bytes as a little endian word, on any host
+ *
+ * @param p pointer to 8 bytes
+ *
+ * @return the word
+ */
+static unsigned long long dict_hash_load ( const unsigned char *const p )
 {
 
-    // State check
-    if ( initialized == true ) return;
+    // Initialized data
+    unsigned long long w = 0;
 
-    // Initialize the log library
-    log_init();
+    // Load
+    memcpy(&w, p, sizeof(w));
 
-    // Initialize the sync library
-    sync_init();
+    // Swap bytes on big endian hosts
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        w = __builtin_bswap64(w);
+    #endif
 
-    // Initialize the hash cache library
-    hash_cache_init();
+    // Done
+    return w;
+}
 
-    // Set the initialized flag
-    initialized = true;
+/** !
+ *  Mix the two CRC lanes and the key length into 64 well distributed bits
+ *
+ * @param a first lane
+ * @param b second lane
+ * @param l length of the key
+ *
+ * @return the hash
+ */
+static unsigned long long dict_hash_finalize ( unsigned long long a, unsigned long long b, size_t l )
+{
+
+    // Initialized data
+    unsigned long long h = ( ( a << 32 ) | ( b & 0xFFFFFFFFULL ) ) ^ ( (unsigned long long) l * 0x9E3779B97F4A7C15ULL );
+
+    // MurmurHash3 finalizer
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+
+    // Done
+    return h;
+}
+
+/** !
+ *  CRC-32C of 8 little endian bytes, without pre or post inversion. Slicing by 8.
+ *
+ * @param crc running CRC
+ * @param w   8 bytes
+ *
+ * @return the updated CRC
+ */
+static unsigned long long dict_hash_crc32c_u64 ( unsigned long long crc, unsigned long long w )
+{
+
+    // Initialized data
+    unsigned long long x = crc ^ w;
+
+    // Done
+    return crc32c_table[7][ x        & 0xFF] ^ crc32c_table[6][(x >>  8) & 0xFF] ^
+           crc32c_table[5][(x >> 16) & 0xFF] ^ crc32c_table[4][(x >> 24) & 0xFF] ^
+           crc32c_table[3][(x >> 32) & 0xFF] ^ crc32c_table[2][(x >> 40) & 0xFF] ^
+           crc32c_table[1][(x >> 48) & 0xFF] ^ crc32c_table[0][ x >> 56        ];
+}
+
+/** !
+ *  Portable dict_hash kernel
+ *
+ * @param k pointer to the key
+ * @param l length of the key
+ *
+ * @return the hash
+ */
+static unsigned long long dict_hash_portable ( const void *const k, size_t l )
+{
+
+    // Initialized data
+    const unsigned char *p    = k;
+    unsigned long long   a    = 0xFFFFFFFFULL,
+                         b    = 0x9E3779B9ULL,
+                         w    = 0;
+    size_t               left = l;
+
+    // Two lanes over each 8 byte word. The second lane sees the word rotated by 32
+    for (; left >= 8; p += 8, left -= 8)
+    {
+        w = dict_hash_load(p);
+        a = dict_hash_crc32c_u64(a, w);
+        b = dict_hash_crc32c_u64(b, ( w << 32 ) | ( w >> 32 ));
+    }
+
+    // Zero pad the tail
+    if ( left )
+    {
+
+        // Little endian, byte by byte
+        w = 0;
+        for (size_t i = 0; i < left; i++) w |= (unsigned long long) p[i] << ( i * 8 );
+
+        // Same as a whole word
+        a = dict_hash_crc32c_u64(a, w);
+        b = dict_hash_crc32c_u64(b, ( w << 32 ) | ( w >> 32 ));
+    }
+
+    // Done
+    return dict_hash_finalize(a, b, l);
+}
+
+#ifdef DICT_HASH_SSE42
+
+/** !
+ *  SSE4.2 dict_hash kernel. Same result as dict_hash_portable
+ *
+ * @param k pointer to the key
+ * @param l length of the key
+ *
+ * @return the hash
+ */
+__attribute__((target("sse4.2")))
+static unsigned long long dict_hash_sse42 ( const void *const k, size_t l )
+{
+
+    // Initialized data
+    const unsigned char *p    = k;
+    unsigned long long   a    = 0xFFFFFFFFULL,
+                         b    = 0x9E3779B9ULL,
+                         w    = 0;
+    size_t               left = l;
+
+    // Two independent lanes, so the crc32 instructions overlap
+    for (; left >= 8; p += 8, left -= 8)
+    {
+        memcpy(&w, p, sizeof(w));
+        a = _mm_crc32_u64(a, w);
+        b = _mm_crc32_u64(b, ( w << 32 ) | ( w >> 32 ));
+    }
+
+    // Zero pad the tail
+    if ( left )
+    {
+
+        // Initialized data
+        unsigned int   w32 = 0;
+        unsigned short w16 = 0;
+        size_t         i   = 0;
+
+        // Load 4, 2 and 1 byte pieces, which compile to single moves
+        w = 0;
+        if ( left & 4 ) { memcpy(&w32, p, 4); w = w32; i = 4; }
+        if ( left & 2 ) { memcpy(&w16, p + i, 2); w |= (unsigned long long) w16 << ( i * 8 ); i += 2; }
+        if ( left & 1 ) { w |= (unsigned long long) p[i] << ( i * 8 ); }
+
+        // Same as a whole word
+        a = _mm_crc32_u64(a, w);
+        b = _mm_crc32_u64(b, ( w << 32 ) | ( w >> 32 ));
+    }
+
+    // Done
+    return dict_hash_finalize(a, b, l);
+}
+#endif
+
+#ifdef DICT_HASH_TEST
+/** !
+ *  Run one dict_hash kernel, regardless of the one dict_init selected
+ *
+ * @param sse42 true for the SSE4.2 kernel, false for the portable kernel
+ * @param k     pointer to the key
+ * @param l     length of the key
+ *
+ * @return the hash, or the portable kernel's hash if the SSE4.2 kernel is not built or the processor lacks it
+ */
+unsigned long long dict_hash_with_kernel ( bool sse42, const void *const k, size_t l )
+{
+
+    // Initialize the tables, if called before the constructor
+    if ( pfn_dict_hash == 0 ) dict_init();
+
+    // SSE4.2 kernel
+    #ifdef DICT_HASH_SSE42
+        if ( sse42 && __builtin_cpu_supports("sse4.2") ) return dict_hash_sse42(k, l);
+    #else
+        (void) sse42;
+    #endif
+
+    // Portable kernel
+    return dict_hash_portable(k, l);
+}
+#endif
+
+/** !
+ *  Get the dict_hash kernel selected by dict_init
+ *
+ * @param void
+ *
+ * @return pointer to the kernel
+ */
+static fn_hash64 *dict_hash_kernel ( void )
+{
+
+    // Initialize, if called before the constructor
+    if ( pfn_dict_hash == 0 ) dict_init();
+
+    // Done
+    return pfn_dict_hash;
+}
+
+/** !
+ *  Select a shard from the high bits of a hash. The low bits are left to pick
+ *  the bucket inside the shard.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param h              the hash of the key
+ *
+ * @return index of the shard
+ */
+static size_t sharded_dict_route ( const sharded_dict *const p_sharded_dict, unsigned long long h )
+{
+
+    // Done
+    return ( p_sharded_dict->bits ) ? (size_t) ( h >> ( 64 - p_sharded_dict->bits ) ) : 0;
+}
+
+/** !
+ *  Lock a dictionary, accumulating the time spent waiting if statistics are enabled
+ *
+ * @param p_dict dictionary
+ *
+ * @return void
+ */
+static void dict_lock ( dict *const p_dict )
+{
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Time the wait
+        if ( p_dict->stats.enabled )
+        {
+
+            // Initialized data
+            timestamp t0 = timer_high_precision();
+
+            // Lock
+            mutex_lock(&p_dict->_lock);
+
+            // Accumulate
+            p_dict->stats.p_data->lock_wait += timer_high_precision() - t0;
+            p_dict->stats.p_data->lock_acquisitions++;
+
+            // Done
+            return;
+        }
+    #endif
+
+    // Lock
+    mutex_lock(&p_dict->_lock);
 
     // Done
     return;
 }
 
-int dict_create ( dict **const pp_dict )
+/** !
+ *  Record the outcome of a lookup. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param hit    true if the key was found
+ * @param probes number of properties compared
+ *
+ * @return void
+ */
+static void dict_stats_get ( dict *const p_dict, bool hit, size_t probes )
 {
 
-    // Argument check
-    if ( pp_dict == (void *) 0 ) goto no_dictionary;
+    #ifdef BUILD_DICT_WITH_STATS
 
-    // Allocate memory for a dictionary
-    dict *p_dict = DICT_REALLOC(0, sizeof(dict));
+        // State check
+        if ( p_dict->stats.enabled == false ) return;
 
-    // Error checking
-    if ( p_dict == (void *) 0 ) goto no_mem;
+        // Count the lookup
+        p_dict->stats.p_data->gets++;
 
-    // Zero set
-    memset(p_dict, 0, sizeof(dict));
+        // Count the outcome
+        if ( hit ) p_dict->stats.p_data->hits++;
+        else       p_dict->stats.p_data->misses++;
 
-    // Return the allocated memory
-    *pp_dict = p_dict;
+        // Long probes share the last bucket
+        p_dict->stats.p_data->probe_histogram[( probes < DICT_STATS_HISTOGRAM_SIZE ) ? probes : DICT_STATS_HISTOGRAM_SIZE - 1]++;
+    #else
+
+        // Suppress warnings
+        (void) p_dict;
+        (void) hit;
+        (void) probes;
+    #endif
+
+    // Done
+    return;
+}
+
+/** !
+ *  Record an add, or an update of an existing property. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param update true if the property already existed
+ *
+ * @return void
+ */
+static void dict_stats_add ( dict *const p_dict, bool update )
+{
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // State check
+        if ( p_dict->stats.enabled == false ) return;
+
+        // Count the mutation
+        if ( update ) p_dict->stats.p_data->updates++;
+        else          p_dict->stats.p_data->adds++;
+    #else
+
+        // Suppress warnings
+        (void) p_dict;
+        (void) update;
+    #endif
+
+    // Done
+    return;
+}
+
+/** !
+ *  Record a pop. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return void
+ */
+static void dict_stats_pop ( dict *const p_dict )
+{
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Count the mutation
+        if ( p_dict->stats.enabled ) p_dict->stats.p_data->pops++;
+    #else
+
+        // Suppress warnings
+        (void) p_dict;
+    #endif
+
+    // Done
+    return;
+}
+
+/** !
+ *  Record a resize of the dictionary's arrays. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return void
+ */
+static void dict_stats_resize ( dict *const p_dict )
+{
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Count the resize
+        if ( p_dict->stats.enabled ) p_dict->stats.p_data->resizes++;
+    #else
+
+        // Suppress warnings
+        (void) p_dict;
+    #endif
+
+    // Done
+    return;
+}
+
+/** !
+ *  Record a lookup that the membership filter answered without searching. Caller
+ *  holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return void
+ */
+static void dict_stats_filtered ( dict *const p_dict )
+{
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Count the lookup
+        if ( p_dict->stats.enabled ) p_dict->stats.p_data->filtered++;
+    #else
+
+        // Suppress warnings
+        (void) p_dict;
+    #endif
+
+    // Done
+    return;
+}
+
+/** !
+ *  Pick one of a key's counters in the membership filter. The hash is mixed first,
+ *  so the filter does not reuse the low bits that pick the bucket.
+ *
+ * @param p_dict dictionary with a membership filter
+ * @param h      the hash of the key
+ * @param i      which of the key's DICT_FILTER_HASHES counters
+ *
+ * @return index of the counter
+ */
+static size_t dict_filter_slot ( const dict *const p_dict, unsigned long long h, size_t i )
+{
+
+    // Initialized data
+    unsigned long long g = h * 0x9E3779B97F4A7C15ULL;
+
+    // Double hashing
+    return (size_t) ( ( g >> 32 ) + i * ( ( g & 0xFFFFFFFF ) | 1 ) ) & p_dict->p_ext->filter.mask;
+}
+
+/** !
+ *  Count a property in the membership filter. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param h      the hash of the key
+ *
+ * @return void
+ */
+static void dict_filter_add ( dict *const p_dict, unsigned long long h )
+{
+
+    // No filter
+    if ( p_dict->p_ext->filter.counters == (void *) 0 ) return;
+
+    // Increment each counter, unless it is saturated
+    for (size_t i = 0; i < DICT_FILTER_HASHES; i++)
+    {
+
+        // Initialized data
+        unsigned char *p_counter = &p_dict->p_ext->filter.counters[dict_filter_slot(p_dict, h, i)];
+
+        // Increment
+        if ( *p_counter < DICT_FILTER_SATURATED ) ( *p_counter )++;
+    }
+}
+
+/** !
+ *  Uncount a property from the membership filter. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param h      the hash of the key
+ *
+ * @return void
+ */
+static void dict_filter_remove ( dict *const p_dict, unsigned long long h )
+{
+
+    // No filter
+    if ( p_dict->p_ext->filter.counters == (void *) 0 ) return;
+
+    // Decrement each counter. A saturated counter may still count other properties
+    for (size_t i = 0; i < DICT_FILTER_HASHES; i++)
+    {
+
+        // Initialized data
+        unsigned char *p_counter = &p_dict->p_ext->filter.counters[dict_filter_slot(p_dict, h, i)];
+
+        // Decrement
+        if ( *p_counter && *p_counter < DICT_FILTER_SATURATED ) ( *p_counter )--;
+    }
+}
+
+/** !
+ *  Ask the membership filter whether a key is definitely not in the dictionary.
+ *  Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param h      the hash of the key
+ *
+ * @return true if the key is absent, false if it may be present or there is no filter
+ */
+static bool dict_filter_absent ( const dict *const p_dict, unsigned long long h )
+{
+
+    // No filter
+    if ( p_dict->p_ext->filter.counters == (void *) 0 ) return false;
+
+    // Any empty counter rules the key out
+    for (size_t i = 0; i < DICT_FILTER_HASHES; i++)
+        if ( p_dict->p_ext->filter.counters[dict_filter_slot(p_dict, h, i)] == 0 ) return true;
+
+    // Maybe present
+    return false;
+}
+
+/** !
+ *  Encode a record into a journal's buffer. Add records carry the value_size 
+ *  inline bytes of the value.
+ *
+ * @param p_journal  journal
+ * @param value_size the dictionary's value size
+ * @param type       DICT_JOURNAL_ADD, DICT_JOURNAL_POP, or DICT_JOURNAL_CLEAR
+ * @param key        the name of the property -OR- null pointer for a clear
+ * @param p_value    the stored value, for an add
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_encode ( dict_journal *const p_journal, size_t value_size, unsigned char type, const char *const key, const void *const p_value )
+{
+
+    // Initialized data
+    uint32_t        key_length   = ( key ) ? (uint32_t) strlen(key) : 0,
+                    value_length = ( type == DICT_JOURNAL_ADD ) ? (uint32_t) value_size : 0;
+    size_t          length       = 9 + (size_t) key_length + value_length;
+    unsigned char  *p            = 0;
+    uint64_t        checksum     = 0;
+
+    // Grow the buffer?
+    if ( p_journal->buffer.count + length + 8 > p_journal->buffer.max )
+    {
+
+        // Initialized data
+        size_t         max  = ( p_journal->buffer.max ) ? p_journal->buffer.max : 256;
+        unsigned char *data = 0;
+
+        // Double until the record fits
+        while ( max < p_journal->buffer.count + length + 8 ) max *= 2;
+
+        // Grow
+        data = DICT_REALLOC(p_journal->buffer.data, max);
+
+        // Error checking
+        if ( data == (void *) 0 ) goto no_mem;
+
+        // Store the buffer, and the size
+        p_journal->buffer.data = data;
+        p_journal->buffer.max  = max;
+    }
+
+    // Encode the record
+    p    = p_journal->buffer.data + p_journal->buffer.count;
+    p[0] = type;
+    memcpy(p + 1, &key_length  , 4);
+    memcpy(p + 5, &value_length, 4);
+    if ( key_length   ) memcpy(p + 9             , key    , key_length);
+    if ( value_length ) memcpy(p + 9 + key_length, p_value, value_length);
+
+    // Checksum the record
+    checksum = hash_fnv64(p, length);
+    memcpy(p + length, &checksum, 8);
+
+    // Store the record
+    p_journal->buffer.count += length + 8;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+#ifdef DICT_POSIX
+/** !
+ *  Write bytes to a file, retrying short and interrupted writes
+ *
+ * @param fd     file descriptor
+ * @param p_data the bytes
+ * @param size   the number of bytes
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_write_all ( int fd, const void *const p_data, size_t size )
+{
+
+    // Initialized data
+    const unsigned char *p = p_data;
+
+    // Write until done
+    while ( size )
+    {
+
+        // Initialized data
+        ssize_t n = write(fd, p, size);
+
+        // Interrupted?
+        if ( n < 0 && errno == EINTR ) continue;
+
+        // Error check
+        if ( n <= 0 ) return 0;
+
+        // Advance
+        p += n, size -= (size_t) n;
+    }
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Write a journal's buffered records to the log file. Caller holds the lock.
+ *
+ * @param p_journal journal
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_write ( dict_journal *const p_journal )
+{
+
+    // Fast exit
+    if ( p_journal->buffer.count == 0 ) return 1;
+
+    // Write the records
+    if ( dict_journal_write_all(p_journal->fd, p_journal->buffer.data, p_journal->buffer.count) == 0 ) return p_journal->failed = true, 0;
+
+    // Store the size, and empty the buffer
+    p_journal->size         += p_journal->buffer.count;
+    p_journal->buffer.count  = 0;
+
+    // Sync the log file?
+    if ( p_journal->config.sync == DICT_JOURNAL_SYNC_WRITE && fsync(p_journal->fd) ) return p_journal->failed = true, 0;
+
+    // Success
+    return 1;
+}
+#else
+
+/** !
+ *  Write a journal's buffered records. Without POSIX file I/O, there are no journals
+ *
+ * @param p_journal journal
+ *
+ * @return 0
+ */
+static int dict_journal_write ( dict_journal *const p_journal )
+{
+
+    // Suppress warnings
+    (void) p_journal;
+
+    // Error
+    return 0;
+}
+#endif
+
+/** !
+ *  Log a change, if the dictionary has a journal. Records are written once more than
+ *  the batch size are buffered. Caller holds the lock.
+ *
+ * @param p_dict  dictionary
+ * @param type    DICT_JOURNAL_ADD, DICT_JOURNAL_POP, or DICT_JOURNAL_CLEAR
+ * @param key     the name of the property -OR- null pointer for a clear
+ * @param p_value the stored value, for an add
+ *
+ * @return void
+ */
+static void dict_journal_record ( dict *const p_dict, unsigned char type, const char *const key, const void *const p_value )
+{
+
+    // Initialized data
+    dict_journal *p_journal = p_dict->p_ext->p_journal;
+
+    // Fast exit
+    if ( p_journal == (void *) 0 ) return;
+
+    // Buffer the record
+    if ( dict_journal_encode(p_journal, p_dict->value_size, type, key, p_value) == 0 ) goto failed_to_record;
+
+    // Group commit
+    if ( p_journal->buffer.count > p_journal->config.batch && dict_journal_write(p_journal) == 0 ) goto failed_to_record;
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
+        // dict errors
+        {
+            failed_to_record:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to log a change to \"%s\" in call to function \"%s\"\n", p_journal->path, __FUNCTION__);
+                #endif
+
+                // Store the failure
+                p_journal->failed = true;
+
+                // Done
+                return;
+        }
+    }
+}
+
+/** !
+ *  Find the link that points to a property, or the empty link at the end of the
+ *  property's bucket if the key is not in the dictionary. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param key      the name of the property
+ * @param h        the hash of the key
+ * @param p_probes return number of properties compared -OR- null pointer
+ *
+ * @return pointer to the link
+ */
+static dict_item **dict_item_find ( dict *const p_dict, const char *const key, unsigned long long h, size_t *const p_probes )
+{
+
+    // Initialized data
+    dict_item **pp_link = &p_dict->entries.data[h % p_dict->entries.max];
+    size_t      probes  = 0;
+
+    // Walk the list
+    while ( *pp_link )
+    {
+
+        // Count the comparison
+        probes++;
+
+        // Is this the right entry?
+        if ( (*pp_link)->hash == h && strcmp(key, (*pp_link)->key) == 0 ) break;
+
+        // Iterate
+        pp_link = &(*pp_link)->next;
+    }
+
+    // Return the probe count
+    if ( p_probes ) *p_probes = probes;
+
+    // Done
+    return pp_link;
+}
+
+/** !
+ *  Get a dictionary's rare state, to write it. A promoted dictionary keeps it where
+ *  the small properties were. A small dictionary allocates it, until dict_promote
+ *  moves it; only constructors do that, before another thread can see the dictionary,
+ *  and everything else promotes the dictionary first.
+ *
+ * @param p_dict dictionary
+ *
+ * @return pointer to the rare state on success, null pointer on error
+ */
+static dict_ext *dict_ext_get ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_ext *p_ext = 0;
+
+    // Fast exit
+    if ( p_dict->p_ext != &dict_ext_none ) return p_dict->p_ext;
+
+    // Promoted? The small properties are free
+    if ( p_dict->entries.data ) return memset(&p_dict->ext, 0, sizeof(dict_ext)), p_dict->p_ext = &p_dict->ext;
+
+    // Allocate the rare state
+    p_ext = DICT_REALLOC(0, sizeof(dict_ext));
+
+    // Error checking
+    if ( p_ext == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_ext, 0, sizeof(dict_ext));
+
+    // Store the rare state
+    p_dict->p_ext = p_ext;
+
+    // Success
+    return p_ext;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Move a dictionary's rare state into the space of its small properties, once they
+ *  are in the hash table. Caller holds the lock.
+ *
+ * @param p_dict dictionary, with a hash table
+ *
+ * @return void
+ */
+static void dict_ext_reclaim ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_ext *p_ext = p_dict->p_ext;
+
+    // Nothing to move?
+    if ( p_ext == &dict_ext_none || p_ext == &p_dict->ext ) return;
+
+    // Move the rare state
+    p_dict->ext   = *p_ext;
+    p_dict->p_ext = &p_dict->ext;
+
+    // Free the allocation
+    p_ext = DICT_REALLOC(p_ext, 0);
+}
+
+/** !
+ *  Lay out a dictionary's dict_items. Only the blocks of the features the dictionary
+ *  uses follow each dict_item, then the inline value, if it has a value size
+ *
+ * @param p_dict dictionary
+ *
+ * @return the layout
+ */
+static dict_layout dict_layout_of ( const dict *const p_dict )
+{
+
+    // Initialized data
+    dict_layout layout = { 0 };
+    size_t      offset = sizeof(dict_item);
+
+    // Recency links
+    if ( p_dict->p_ext->lru.capacity ) layout.lru = offset, offset += sizeof(dict_lru_links);
+
+    // Expiry and timer wheel links
+    if ( p_dict->p_ext->p_wheel ) layout.ttl = offset, offset += sizeof(dict_ttl_links);
+
+    // Sorted index links
+    if ( p_dict->p_ext->tree.enabled ) layout.tree = offset, offset += sizeof(dict_tree_links);
+
+    // Inline values are aligned for any type
+    if ( p_dict->value_size )
+        layout.value = ( offset + _Alignof(max_align_t) - 1 ) & ~( _Alignof(max_align_t) - 1 ),
+        offset       = layout.value + p_dict->value_size;
+
+    // Store the size
+    layout.size = offset;
+
+    // Done
+    return layout;
+}
+
+/** !
+ *  Bytes to allocate for a dict_item, including its blocks and its inline value
+ *
+ * @param p_dict dictionary
+ *
+ * @return size of a dict_item in bytes
+ */
+static size_t dict_item_size ( const dict *const p_dict )
+{
+
+    // Done
+    return p_dict->layout.size;
+}
+
+/** !
+ *  Set a property's value. Inline values are copied from p_value, or zeroed if
+ *  p_value is null. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property the property
+ * @param p_value  the value
+ *
+ * @return void
+ */
+static void dict_item_set ( const dict *const p_dict, dict_item *const property, void *const p_value )
+{
+
+    // Pointer values
+    if ( p_dict->value_size == 0 )
+    {
+
+        // Store the pointer
+        property->value = p_value;
+
+        // Done
+        return;
+    }
+
+    // Inline values live after the dict_item and its blocks
+    property->value = DICT_ITEM_BLOCK(property, p_dict->layout.value);
+
+    // Copy the value
+    if ( p_value ) memcpy(property->value, p_value, p_dict->value_size);
+
+    // Zero the value
+    else memset(property->value, 0, p_dict->value_size);
+}
+
+/** !
+ *  Has a property expired? Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property the property
+ *
+ * @return true if the property has an expiry in the past, else false
+ */
+static bool dict_item_expired ( const dict *const p_dict, const dict_item *const property )
+{
+
+    // Initialized data
+    timestamp expiry = ( p_dict->layout.ttl ) ? DICT_ITEM_TTL(p_dict, property)->expiry : 0;
+
+    // Done
+    return expiry && expiry <= DICT_CLOCK();
+}
+
+/** !
+ *  Unlink a property from the recency list. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property the property
+ *
+ * @return void
+ */
+static void dict_lru_unlink ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_lru_links *p_links = DICT_ITEM_LRU(p_dict, property);
+
+    // Unlink from the more recently used side
+    if ( p_links->prev ) DICT_ITEM_LRU(p_dict, p_links->prev)->next = p_links->next;
+    else                 p_dict->p_ext->lru.head                    = p_links->next;
+
+    // Unlink from the less recently used side
+    if ( p_links->next ) DICT_ITEM_LRU(p_dict, p_links->next)->prev = p_links->prev;
+    else                 p_dict->p_ext->lru.tail                    = p_links->prev;
+
+    // Clear the links
+    p_links->prev = p_links->next = 0;
+}
+
+/** !
+ *  Make a property the most recently used. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property the property, which is not in the recency list. Must not be null
+ *
+ * @return void
+ */
+static void dict_lru_push ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_item      *head    = p_dict->p_ext->lru.head;
+    dict_lru_links *p_links = DICT_ITEM_LRU(p_dict, property);
+
+    // Link the property in front of the head
+    p_links->prev = 0;
+    p_links->next = head;
+
+    // Update the old head
+    if ( head ) DICT_ITEM_LRU(p_dict, head)->prev = property;
+    else        p_dict->p_ext->lru.tail           = property;
+
+    // Store the new head
+    p_dict->p_ext->lru.head = property;
+}
+
+/** !
+ *  Mark a property as used, if the dictionary is in LRU mode. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property the property
+ *
+ * @return void
+ */
+static void dict_lru_touch ( dict *const p_dict, dict_item *const property )
+{
+
+    // Fast exit
+    if ( p_dict->p_ext->lru.capacity == 0 || p_dict->p_ext->lru.head == property ) return;
+
+    // Move the property to the front
+    dict_lru_unlink(p_dict, property);
+    dict_lru_push(p_dict, property);
+}
+
+/** !
+ *  Get a property's heap priority in the sorted index. The hash is mixed with the
+ *  dictionary's seed, so the priorities are independent of the key order, even
+ *  if the hash function preserves it, and can not be chosen by picking keys.
+ *
+ * @param p_dict   dictionary
+ * @param property the property
+ *
+ * @return the priority
+ */
+static uint64_t dict_tree_priority ( const dict *const p_dict, const dict_item *const property )
+{
+
+    // Done
+    return dict_mix64(property->hash ^ p_dict->p_ext->tree.seed);
+}
+
+/** !
+ *  Find the link that points to a property in the sorted index. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property a property in the sorted index
+ *
+ * @return the parent's child pointer, or the root pointer
+ */
+static dict_item **dict_tree_link ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_item       *parent  = DICT_ITEM_TREE(p_dict, property)->parent;
+    dict_tree_links *p_links = ( parent ) ? DICT_ITEM_TREE(p_dict, parent) : 0;
+
+    // Done
+    return ( p_links == (void *) 0 ) ? &p_dict->p_ext->tree.root : ( p_links->left == property ) ? &p_links->left : &p_links->right;
+}
+
+/** !
+ *  Rotate a property above its parent in the sorted index. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property a property with a parent
+ *
+ * @return void
+ */
+static void dict_tree_rotate_up ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_tree_links  *p_links  = DICT_ITEM_TREE(p_dict, property);
+    dict_item        *parent   = p_links->parent;
+    dict_tree_links  *p_parent = DICT_ITEM_TREE(p_dict, parent);
+    dict_item       **pp_link  = dict_tree_link(p_dict, parent);
+
+    // Left child?
+    if ( p_parent->left == property )
+    {
+
+        // The property's right subtree moves to the parent's left
+        p_parent->left = p_links->right;
+        if ( p_links->right ) DICT_ITEM_TREE(p_dict, p_links->right)->parent = parent;
+        p_links->right = parent;
+    }
+
+    // Right child
+    else
+    {
+
+        // The property's left subtree moves to the parent's right
+        p_parent->right = p_links->left;
+        if ( p_links->left ) DICT_ITEM_TREE(p_dict, p_links->left)->parent = parent;
+        p_links->left = parent;
+    }
+
+    // The property takes the parent's place
+    p_links->parent  = p_parent->parent;
+    p_parent->parent = property;
+    *pp_link         = property;
+}
+
+/** !
+ *  Insert a property into the sorted index. The index is a treap ordered by key,
+ *  and heap ordered by a seeded mix of the hash, so it is balanced in expectation.
+ *  Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property a property that is not in the sorted index
+ *
+ * @return void
+ */
+static void dict_tree_insert ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_tree_links  *p_links = DICT_ITEM_TREE(p_dict, property);
+    dict_item        *parent  = 0,
+                    **pp_link = &p_dict->p_ext->tree.root;
+
+    // Find the leaf
+    while ( *pp_link )
+    {
+        parent  = *pp_link;
+        pp_link = ( strcmp(property->key, parent->key) < 0 ) ? &DICT_ITEM_TREE(p_dict, parent)->left : &DICT_ITEM_TREE(p_dict, parent)->right;
+    }
+
+    // Link the property
+    *p_links = (dict_tree_links) { .left = 0, .right = 0, .parent = parent };
+    *pp_link = property;
+
+    // Restore the heap order
+    while ( p_links->parent && dict_tree_priority(p_dict, p_links->parent) < dict_tree_priority(p_dict, property) ) dict_tree_rotate_up(p_dict, property);
+}
+
+/** !
+ *  Remove a property from the sorted index. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property a property in the sorted index
+ *
+ * @return void
+ */
+static void dict_tree_remove ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_tree_links *p_links = DICT_ITEM_TREE(p_dict, property);
+
+    // Rotate the property down to a leaf, keeping the heap order
+    while ( p_links->left || p_links->right )
+    {
+
+        // Initialized data
+        dict_item *child = ( p_links->right == (void *) 0 || ( p_links->left && dict_tree_priority(p_dict, p_links->left) > dict_tree_priority(p_dict, p_links->right) ) ) ? p_links->left : p_links->right;
+
+        // Rotate
+        dict_tree_rotate_up(p_dict, child);
+    }
+
+    // Unlink the leaf
+    *dict_tree_link(p_dict, property) = 0;
+    p_links->parent = 0;
+}
+
+/** !
+ *  Find the first property whose key is not less than a key. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param key    the key -OR- null pointer for the first property
+ *
+ * @return the property -OR- null pointer
+ */
+static dict_item *dict_tree_lower_bound ( dict *const p_dict, const char *const key )
+{
+
+    // Initialized data
+    dict_item *best = 0;
+
+    // Walk down the tree
+    for (dict_item *i_di = p_dict->p_ext->tree.root; i_di; )
+    {
+
+        // Go left, and remember the candidate
+        if ( key == (void *) 0 || strcmp(i_di->key, key) >= 0 ) best = i_di, i_di = DICT_ITEM_TREE(p_dict, i_di)->left;
+
+        // Go right
+        else i_di = DICT_ITEM_TREE(p_dict, i_di)->right;
+    }
+
+    // Done
+    return best;
+}
+
+/** !
+ *  Find the property after a property, in key order. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param property a property in the sorted index
+ *
+ * @return the next property -OR- null pointer
+ */
+static dict_item *dict_tree_next ( const dict *const p_dict, dict_item *property )
+{
+
+    // Initialized data
+    dict_item *parent = 0;
+
+    // Leftmost property of the right subtree
+    if ( DICT_ITEM_TREE(p_dict, property)->right )
+    {
+        for (property = DICT_ITEM_TREE(p_dict, property)->right; DICT_ITEM_TREE(p_dict, property)->left; property = DICT_ITEM_TREE(p_dict, property)->left);
+
+        // Done
+        return property;
+    }
+
+    // First ancestor reached from its left subtree
+    for (parent = DICT_ITEM_TREE(p_dict, property)->parent; parent && DICT_ITEM_TREE(p_dict, parent)->right == property; parent = DICT_ITEM_TREE(p_dict, parent)->parent)
+        property = parent;
+
+    // Done
+    return parent;
+}
+
+/** !
+ *  Rebuild the sorted index from the hash table. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return void
+ */
+static void dict_tree_build ( dict *const p_dict )
+{
+
+    // Empty the index
+    p_dict->p_ext->tree.root = 0;
+
+    // Insert each property
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next)
+            dict_tree_insert(p_dict, i_di);
+}
+
+/** !
+ *  Should an array of the hash table or the iterables be mapped with the dictionary's
+ *  placement, instead of allocated from the heap?
+ *
+ * @param p_dict dictionary
+ * @param size   bytes of the array
+ *
+ * @return true if the array is mapped, else false
+ */
+static bool dict_array_placed ( const dict *const p_dict, size_t size )
+{
+
+    // Done
+    return ( p_dict->p_ext->placement.pages || p_dict->p_ext->placement.numa ) && size >= DICT_PLACEMENT_MIN;
+}
+
+/** !
+ *  Get the NUMA nodes this process may allocate from
+ *
+ * @return node mask, or node 0 alone if the platform has no memory policy
+ */
+static unsigned long long dict_numa_allowed ( void )
+{
+
+    // Initialized data
+    unsigned long nodes = 0;
+
+    // Linux
+    #if defined(__linux__) && defined(SYS_get_mempolicy)
+        if ( syscall(SYS_get_mempolicy, 0, &nodes, sizeof(nodes) * 8 + 1, 0, DICT_MPOL_F_MEMS_ALLOWED) ) nodes = 0;
+    #endif
+
+    // Done
+    return ( nodes ) ? nodes : 1;
+}
+
+/** !
+ *  Get the NUMA node of the calling thread's CPU. The node is cached per thread, and
+ *  looked up again every DICT_NUMA_NODE_REFRESH calls, in case the thread migrated.
+ *
+ * @return node number, or 0 if the platform can not tell
+ */
+static size_t dict_numa_node ( void )
+{
+
+    // Initialized data
+    static _Thread_local unsigned node  = 0,
+                                  calls = 0;
+
+    // Cached
+    if ( calls++ % DICT_NUMA_NODE_REFRESH ) return node;
+
+    // Linux
+    #if defined(__linux__) && defined(SYS_getcpu)
+    {
+
+        // Initialized data
+        unsigned cpu = 0;
+
+        // Ask the kernel
+        if ( syscall(SYS_getcpu, &cpu, &node, 0) ) node = 0;
+    }
+    #endif
+
+    // Done
+    return node;
+}
+
+#ifdef DICT_POSIX
+/** !
+ *  Round a placed array up to a whole number of pages
+ *
+ * @param p_dict dictionary
+ * @param size   bytes of the array
+ *
+ * @return bytes mapped for the array
+ */
+static size_t dict_array_extent ( const dict *const p_dict, size_t size )
+{
+
+    // Initialized data
+    size_t page = ( p_dict->p_ext->placement.pages ) ? DICT_HUGE_PAGE_SIZE : (size_t) sysconf(_SC_PAGESIZE);
+
+    // Done
+    return ( size + page - 1 ) / page * page;
+}
+
+/** !
+ *  Apply the dictionary's NUMA policy to a placed array, before it is touched
+ *
+ * @param p_dict dictionary
+ * @param p      the array
+ * @param extent bytes mapped for the array
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_array_bind ( const dict *const p_dict, void *const p, size_t extent )
+{
+
+    // Linux
+    #if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+
+        // Initialized data
+        unsigned long nodes = (unsigned long) p_dict->p_ext->placement.nodes;
+        int           mode  = ( p_dict->p_ext->placement.numa == DICT_NUMA_BIND ) ? DICT_MPOL_BIND : DICT_MPOL_INTERLEAVE;
+
+        // No nodes means every node this process may allocate from
+        if ( nodes == 0 ) nodes = (unsigned long) dict_numa_allowed();
+
+        // Set the policy of the mapping
+        return syscall(SYS_mbind, p, extent, mode, &nodes, sizeof(nodes) * 8 + 1, 0) == 0;
+
+    // Other platforms have no memory policy
+    #else
+
+        // Suppress warnings
+        (void) p_dict;
+        (void) p;
+        (void) extent;
+
+        // Error
+        return 0;
+    #endif
+}
+
+/** !
+ *  Allocate an array of the hash table or the iterables. Large arrays of a dictionary
+ *  with a placement are mapped on huge pages, and bound or interleaved across NUMA
+ *  nodes, instead of allocated from the heap.
+ *
+ * @param p_dict dictionary
+ * @param size   bytes of the array
+ *
+ * @return pointer to the array on success, null pointer on error
+ */
+static void *dict_array_alloc ( const dict *const p_dict, size_t size )
+{
+
+    // Heap array
+    if ( dict_array_placed(p_dict, size) == false ) return DICT_REALLOC(0, size);
+
+    // Initialized data
+    size_t         extent = dict_array_extent(p_dict, size),
+                   slack  = ( p_dict->p_ext->placement.pages ) ? DICT_HUGE_PAGE_SIZE : 0;
+    unsigned char *p      = MAP_FAILED,
+                  *q      = MAP_FAILED;
+
+    // Explicit huge pages, from the pool reserved with vm.nr_hugepages
+    #ifdef MAP_HUGETLB
+        if ( p_dict->p_ext->placement.pages == DICT_PAGES_EXPLICIT ) p = mmap(0, extent, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    #endif
+
+    // Transparent huge pages, or small pages. An empty pool falls back to transparent huge pages
+    if ( p == MAP_FAILED )
+    {
+
+        // Map enough to align on a huge page
+        q = mmap(0, extent + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        // Error checking
+        if ( q == MAP_FAILED ) goto failed_to_map;
+
+        // Align, and trim the head and the tail
+        p = ( slack ) ? (unsigned char *) ( ( (uintptr_t) q + slack - 1 ) & ~( (uintptr_t) slack - 1 ) ) : q;
+        if ( p > q ) munmap(q, (size_t) ( p - q ));
+        if ( q + extent + slack > p + extent ) munmap(p + extent, (size_t) ( q + extent + slack - ( p + extent ) ));
+
+        // Ask for huge pages. Without them, the array is still usable
+        #ifdef MADV_HUGEPAGE
+            if ( slack ) madvise(p, extent, MADV_HUGEPAGE);
+        #endif
+    }
+
+    // Bind or interleave the pages across NUMA nodes
+    if ( p_dict->p_ext->placement.numa && dict_array_bind(p_dict, p, extent) == 0 ) goto failed_to_bind;
+
+    // Success
+    return p;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            failed_to_map:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to map %zu bytes in call to function \"%s\"\n", extent, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_bind:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to set the NUMA policy of %zu bytes in call to function \"%s\"\n", extent, __FUNCTION__);
+                #endif
+
+                // Clean up
+                munmap(p, extent);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Free an array allocated by dict_array_alloc
+ *
+ * @param p_dict dictionary
+ * @param p      the array
+ * @param size   bytes of the array, as passed to dict_array_alloc
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_array_free ( const dict *const p_dict, void *const p, size_t size )
+{
+
+    // Heap array
+    if ( dict_array_placed(p_dict, size) == false ) return DICT_REALLOC(p, 0) == (void *) 0;
+
+    // Unmap the array
+    return munmap(p, dict_array_extent(p_dict, size)) == 0;
+}
+#else
+
+/** !
+ *  Allocate an array of the hash table or the iterables. Without POSIX mappings,
+ *  every array comes from the heap.
+ *
+ * @param p_dict dictionary
+ * @param size   bytes of the array
+ *
+ * @return pointer to the array on success, null pointer on error
+ */
+static void *dict_array_alloc ( const dict *const p_dict, size_t size )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+
+    // Heap array
+    return DICT_REALLOC(0, size);
+}
+
+/** !
+ *  Free an array allocated by dict_array_alloc
+ *
+ * @param p_dict dictionary
+ * @param p      the array
+ * @param size   bytes of the array, as passed to dict_array_alloc
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_array_free ( const dict *const p_dict, void *const p, size_t size )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+    (void) size;
+
+    // Heap array
+    return DICT_REALLOC(p, 0) == (void *) 0;
+}
+#endif
+
+/** !
+ *  Resize the iterable arrays to max slots. On error the arrays keep their contents,
+ *  and the bound is left unchanged, so both arrays hold at least the old bound.
+ *  Caller holds the lock.
+ *
+ * @param p_dict dictionary with a hash table
+ * @param max    the new array bound, at least the slot count
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_iterable_resize ( dict *const p_dict, size_t max )
+{
+
+    // Initialized data
+    size_t   size   = p_dict->iterable.max * sizeof(void *);
+    char   **keys   = 0;
+    void   **values = 0;
+
+    // Heap arrays grow in place. A grown key array is still valid under the old bound,
+    // so a failed values realloc leaves the dictionary consistent. A shrink would not,
+    // so it builds both arrays before touching the old ones
+    if ( max >= p_dict->iterable.max && dict_array_placed(p_dict, size) == false && dict_array_placed(p_dict, max * sizeof(void *)) == false )
+    {
+
+        // Grow the keys
+        keys = DICT_REALLOC(p_dict->iterable.keys, max * sizeof(char *));
+
+        // Error checking
+        if ( keys == (void *) 0 ) return 0;
+
+        // Store the keys
+        p_dict->iterable.keys = keys;
+
+        // Grow the values
+        values = DICT_REALLOC(p_dict->iterable.values, max * sizeof(void *));
+
+        // Error checking
+        if ( values == (void *) 0 ) return 0;
+
+        // Store the values
+        p_dict->iterable.values = values;
+
+        // Done
+        goto done;
+    }
+
+    // Allocate both arrays before touching the old ones
+    keys   = dict_array_alloc(p_dict, max * sizeof(char *));
+    values = dict_array_alloc(p_dict, max * sizeof(void *));
+
+    // Error checking
+    if ( keys == (void *) 0 || values == (void *) 0 )
+    {
+
+        // Clean up
+        if ( keys   ) dict_array_free(p_dict, keys  , max * sizeof(char *));
+        if ( values ) dict_array_free(p_dict, values, max * sizeof(void *));
+
+        // Error
+        return 0;
+    }
+
+    // Copy the slots
+    memcpy(keys  , p_dict->iterable.keys  , p_dict->iterable.count * sizeof(char *));
+    memcpy(values, p_dict->iterable.values, p_dict->iterable.count * sizeof(void *));
+
+    // Free the old arrays
+    dict_array_free(p_dict, p_dict->iterable.keys  , size);
+    dict_array_free(p_dict, p_dict->iterable.values, size);
+
+    // Store the arrays
+    p_dict->iterable.keys   = keys;
+    p_dict->iterable.values = values;
+
+    done:
+
+    // Store the bound
+    p_dict->iterable.max = max;
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Squeeze the tombstones out of the iterables, keeping insertion order, and 
+ *  renumber each property's index. Caller holds the lock.
+ *
+ * @param p_dict dictionary with a hash table
+ *
+ * @return void
+ */
+static void dict_iterable_compact ( dict *const p_dict )
+{
+
+    // Initialized data
+    size_t j = 0;
+
+    // Fast exit
+    if ( p_dict->iterable.count == p_dict->entries.count ) return;
+
+    // Point each live slot at its property. The value is recovered from the property below
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next)
+            p_dict->iterable.values[i_di->index] = i_di;
+
+    // Slide each live slot down over the tombstones
+    for (size_t i = 0; i < p_dict->iterable.count; i++)
+    {
+
+        // Initialized data
+        dict_item *property = p_dict->iterable.values[i];
+
+        // Skip tombstones
+        if ( p_dict->iterable.keys[i] == (void *) 0 ) continue;
+
+        // Move the slot
+        p_dict->iterable.keys[j]   = p_dict->iterable.keys[i];
+        p_dict->iterable.values[j] = property->value;
+
+        // Renumber the property
+        property->index = j++;
+    }
+
+    // Clear the tail
+    memset(&p_dict->iterable.keys[j]  , 0, ( p_dict->iterable.count - j ) * sizeof(char *));
+    memset(&p_dict->iterable.values[j], 0, ( p_dict->iterable.count - j ) * sizeof(void *));
+
+    // Store the slot count
+    p_dict->iterable.count = j;
+}
+
+/** !
+ *  Make room in the iterable arrays for n more slots, reclaiming tombstones before
+ *  growing, and growing at most once. Caller holds the lock.
+ *
+ * @param p_dict dictionary with a hash table
+ * @param n      the number of slots
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_iterable_reserve ( dict *const p_dict, size_t n )
+{
+
+    // Initialized data
+    size_t max = p_dict->iterable.max;
+
+    // Fast exit
+    if ( p_dict->iterable.count + n <= max ) return 1;
+
+    // Reclaim tombstones before growing
+    dict_iterable_compact(p_dict);
+
+    // Fast exit
+    if ( p_dict->iterable.count + n <= max ) return 1;
+
+    // Double until the slots fit
+    while ( max < p_dict->iterable.count + n ) max *= 2;
+
+    // Grow the arrays
+    if ( dict_iterable_resize(p_dict, max) == 0 ) goto no_mem;
+
+    // Record the resize
+    dict_stats_resize(p_dict);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Store a new property at an empty link returned by dict_item_find. Caller holds the lock.
+ *
+ * @param p_dict  dictionary
+ * @param pp_link the empty link
+ * @param key     the name of the property
+ * @param p_value the value of the property
+ * @param h       the hash of the key
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_item_insert ( dict *const p_dict, dict_item **const pp_link, const char *const key, void *const p_value, unsigned long long h )
+{
+
+    // Initialized data
+    dict_item *property = 0;
+
+    // Make room in the iterables
+    if ( dict_iterable_reserve(p_dict, 1) == 0 ) goto no_mem;
+
+    // Take a property allocated ahead of a batch, or allocate a new dict_item
+    property = ( p_dict->p_ext->spare.count ) ? p_dict->p_ext->spare.nodes[--p_dict->p_ext->spare.count] : DICT_REALLOC(0, dict_item_size(p_dict));
+
+    // Error checking
+    if ( property == (void *) 0 ) goto no_mem;
+
+    // Set the property
+    *property = (dict_item)
+    {
+        .key   = (char *) key,
+        .value = 0,
+        .index = p_dict->iterable.count,
+        .hash  = h,
+        .next  = 0
+    };
+
+    // It does not expire
+    if ( p_dict->layout.ttl ) *DICT_ITEM_TTL(p_dict, property) = (dict_ttl_links) { 0 };
+
+    // Set the value
+    dict_item_set(p_dict, property, p_value);
+
+    // Insert the property
+    *pp_link = property;
+
+    // It is the most recently used
+    if ( p_dict->p_ext->lru.capacity ) dict_lru_push(p_dict, property);
+
+    // Index it
+    if ( p_dict->p_ext->tree.enabled ) dict_tree_insert(p_dict, property);
+
+    // Append to the iterables
+    p_dict->iterable.keys[p_dict->iterable.count]   = (char *) key;
+    p_dict->iterable.values[p_dict->iterable.count] = property->value;
+    p_dict->iterable.count++;
+
+    // Increment the entry counter
+    p_dict->entries.count++;
+
+    // Count it in the membership filter
+    dict_filter_add(p_dict, h);
+
+    // Record the add
+    dict_stats_add(p_dict, false);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Remove a property from the timer wheel. Caller holds the lock.
+ *
+ * @param p_dict   dictionary, with a timer wheel
+ * @param property the property, which is scheduled
+ *
+ * @return void
+ */
+static void dict_wheel_unschedule ( dict *const p_dict, dict_item *const property )
+{
+
+    // Initialized data
+    dict_ttl_links *p_links = DICT_ITEM_TTL(p_dict, property);
+
+    // Unlink the property
+    *p_links->pprev = p_links->next;
+    if ( p_links->next ) DICT_ITEM_TTL(p_dict, p_links->next)->pprev = p_links->pprev;
+
+    // Clear the links
+    p_links->next  = 0;
+    p_links->pprev = 0;
+
+    // Count it
+    p_dict->p_ext->p_wheel->count--;
+}
+
+/** !
+ *  Unlink and free the property at a link returned by dict_item_find. Its iterable
+ *  slot becomes a tombstone, so the other properties keep their insertion order. 
+ *  Tombstones are compacted once they outnumber the properties. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param pp_link  link to the property
+ * @param pp_value return -OR- null pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_item_remove ( dict *const p_dict, dict_item **const pp_link, const void **const pp_value )
+{
+
+    // Initialized data
+    dict_item *property = *pp_link;
+
+    // Unlink the property
+    *pp_link = property->next;
+
+    // Unlink it from the recency list
+    if ( p_dict->p_ext->lru.capacity ) dict_lru_unlink(p_dict, property);
+
+    // Unlink it from the timer wheel
+    if ( p_dict->layout.ttl && DICT_ITEM_TTL(p_dict, property)->pprev ) dict_wheel_unschedule(p_dict, property);
+
+    // Unlink it from the sorted index
+    if ( p_dict->p_ext->tree.enabled ) dict_tree_remove(p_dict, property);
+
+    // Uncount it from the membership filter
+    dict_filter_remove(p_dict, property->hash);
+
+    // Return the value
+    if ( pp_value ) *pp_value = property->value;
+
+    // Log the pop
+    dict_journal_record(p_dict, DICT_JOURNAL_POP, property->key, 0);
+
+    // Leave a tombstone
+    p_dict->iterable.keys[property->index]   = 0;
+    p_dict->iterable.values[property->index] = 0;
+
+    // Trailing tombstones are free to reclaim
+    while ( p_dict->iterable.count && p_dict->iterable.keys[p_dict->iterable.count - 1] == (void *) 0 ) p_dict->iterable.count--;
+
+    // Free the property
+    if ( DICT_REALLOC(property, 0) ) goto failed_to_free;
+
+    // Decrement entries
+    p_dict->entries.count--;
+
+    // Record the pop
+    dict_stats_pop(p_dict);
+
+    // Compact once the tombstones outnumber the properties
+    if ( p_dict->iterable.count - p_dict->entries.count > p_dict->entries.count ) dict_iterable_compact(p_dict);
+
+    // Shrink the iterables? Keep the room reserved for a batch
+    if ( p_dict->iterable.max > 1 && p_dict->iterable.count + p_dict->p_ext->spare.count <= p_dict->iterable.max / 4 )
+    {
+
+        // Halve the size. A failed shrink leaves the larger arrays in place, which are still big enough
+        if ( dict_iterable_resize(p_dict, p_dict->iterable.max / 2) ) dict_stats_resize(p_dict);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+#ifdef DICT_POSIX
+/** !
+ *  Allocate bytes from a shared memory dictionary's arena. Nothing is freed until
+ *  the dictionary is cleared, so pointers handed out by shm_dict_get stay valid
+ *  while other processes change the dictionary. Caller holds the write lock.
+ *
+ * @param p_header the start of the region
+ * @param size     bytes to allocate
+ *
+ * @return offset of the allocation on success, 0 if the region is full
+ */
+static uint64_t shm_dict_alloc ( shm_dict_header *const p_header, size_t size )
+{
+
+    // Initialized data
+    uint64_t offset = ( p_header->used + SHM_DICT_ALIGN - 1 ) & ~( SHM_DICT_ALIGN - 1 );
+
+    // Does it fit?
+    if ( offset > p_header->bytes || size > p_header->bytes - offset ) return 0;
+
+    // Bump
+    p_header->used = offset + size;
+
+    // Done
+    return offset;
+}
+
+/** !
+ *  Find a key in a shared memory dictionary. Caller holds the lock.
+ *
+ * @param p_header the start of the region
+ * @param key      the key of the property
+ * @param h        the hash of the key
+ *
+ * @return the link that holds the property's node offset, or the empty link at the end of the chain
+ */
+static uint64_t *shm_dict_find ( shm_dict_header *const p_header, const char *const key, unsigned long long h )
+{
+
+    // Initialized data
+    uint64_t *p_link = (uint64_t *) SHM_DICT_AT(p_header, p_header->buckets.offset) + ( h % p_header->buckets.max );
+
+    // Walk the chain
+    while ( *p_link )
+    {
+
+        // Initialized data
+        shm_dict_node *p_node = SHM_DICT_AT(p_header, *p_link);
+
+        // Match?
+        if ( p_node->hash == h && strcmp(SHM_DICT_AT(p_header, p_node->key), key) == 0 ) break;
+
+        // Iterate
+        p_link = &p_node->next;
+    }
+
+    // Done
+    return p_link;
+}
+
+/** !
+ *  Squeeze the tombstones out of a shared memory dictionary's iterable array, 
+ *  keeping insertion order. Caller holds the write lock.
+ *
+ * @param p_header the start of the region
+ *
+ * @return void
+ */
+static void shm_dict_squeeze ( shm_dict_header *const p_header )
+{
+
+    // Initialized data
+    uint64_t *iterable = SHM_DICT_AT(p_header, p_header->iterable.offset);
+    size_t    j        = 0;
+
+    // Slide each live node down over the tombstones
+    for (size_t i = 0; i < p_header->iterable.count; i++)
+    {
+
+        // Skip tombstones
+        if ( iterable[i] == 0 ) continue;
+
+        // Move the node, and tell it where it is
+        iterable[j] = iterable[i];
+        ( (shm_dict_node *) SHM_DICT_AT(p_header, iterable[j]) )->index = j;
+        j++;
+    }
+
+    // Store the count
+    p_header->iterable.count = j;
+
+    // Done
+    return;
+}
+#endif
+
+/** !
+ *  Evict a property. The eviction callback sees the key and value before the 
+ *  property is freed. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param victim the property
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_item_evict ( dict *const p_dict, dict_item *const victim )
+{
+
+    // Initialized data
+    dict_item **pp_link = &p_dict->entries.data[victim->hash % p_dict->entries.max];
+
+    // Find the link by address. The callback may free the key, so it is not compared after
+    while ( *pp_link != victim ) pp_link = &(*pp_link)->next;
+
+    // Notify the caller
+    if ( p_dict->pfn_evict ) p_dict->pfn_evict(victim->key, victim->value);
+
+    // Remove the property
+    return dict_item_remove(p_dict, pp_link, 0);
+}
+
+/** !
+ *  Schedule a property in the timer wheel. The property lands on the lowest level
+ *  whose span covers the ticks until it expires, so its slot comes due before it
+ *  does, and it is cascaded down, never late. Caller holds the lock.
+ *
+ * @param p_dict   dictionary, with a timer wheel
+ * @param property the property, with an expiry, which is not scheduled
+ * @param min_tick the earliest wheel tick to schedule the property on
+ *
+ * @return void
+ */
+static void dict_wheel_schedule ( dict *const p_dict, dict_item *const property, uint64_t min_tick )
+{
+
+    // Initialized data
+    dict_wheel      *p_wheel = p_dict->p_ext->p_wheel;
+    dict_ttl_links  *p_links = DICT_ITEM_TTL(p_dict, property);
+    uint64_t         r       = (uint64_t) p_wheel->resolution,
+                     expire  = ( (uint64_t) p_links->expiry + r - 1 ) / r,
+                     delta   = 0;
+    size_t           level   = 0;
+    dict_item      **pp_slot = 0;
+
+    // Past due properties are processed on the next tick
+    if ( expire < min_tick ) expire = min_tick;
+
+    // Beyond the top level, wait for the farthest tick the wheel spans, and be rescheduled from there
+    delta = expire - p_wheel->now;
+    if ( delta >> ( DICT_WHEEL_BITS * DICT_WHEEL_LEVELS ) )
+        delta  = ( (uint64_t) 1 << ( DICT_WHEEL_BITS * DICT_WHEEL_LEVELS ) ) - 1,
+        expire = p_wheel->now + delta;
+
+    // Find the level
+    while ( level < DICT_WHEEL_LEVELS - 1 && ( delta >> ( DICT_WHEEL_BITS * ( level + 1 ) ) ) ) level++;
+
+    // Find the slot
+    pp_slot = &p_wheel->slots[level][( expire >> ( DICT_WHEEL_BITS * level ) ) & ( DICT_WHEEL_SLOTS - 1 )];
+
+    // Link the property at the front of the slot
+    p_links->next  = *pp_slot;
+    p_links->pprev = pp_slot;
+    if ( *pp_slot ) DICT_ITEM_TTL(p_dict, *pp_slot)->pprev = &p_links->next;
+    *pp_slot = property;
+
+    // Count it
+    p_wheel->count++;
+}
+
+/** !
+ *  Detach every property in a timer wheel slot. Caller holds the lock.
+ *
+ * @param p_dict  dictionary, with a timer wheel
+ * @param pp_slot the slot
+ *
+ * @return the first property in the detached list, linked by their timer wheel links
+ */
+static dict_item *dict_wheel_detach ( dict *const p_dict, dict_item **const pp_slot )
+{
+
+    // Initialized data
+    dict_item *list = *pp_slot;
+
+    // Empty the slot
+    *pp_slot = 0;
+
+    // Mark each property as not scheduled
+    for (dict_item *i_di = list; i_di; i_di = DICT_ITEM_TTL(p_dict, i_di)->next)
+        DICT_ITEM_TTL(p_dict, i_di)->pprev = 0,
+        p_dict->p_ext->p_wheel->count--;
+
+    // Done
+    return list;
+}
+
+/** !
+ *  Move a dictionary's dict_items to its current layout, after a feature with a
+ *  block is turned on or off. Each property is reallocated, which would free the 
+ *  inline values dict_get has handed out, so a populated dictionary with inline 
+ *  values is refused. On error the dictionary keeps its old layout. Caller holds 
+ *  the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_relayout ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_layout   layout = dict_layout_of(p_dict),
+                  old    = p_dict->layout;
+    dict_item   **moved  = 0;
+    size_t        count  = p_dict->iterable.count;
+
+    // Fast exit
+    if ( memcmp(&layout, &old, sizeof(dict_layout)) == 0 ) return 1;
+
+    // Small dictionaries have no dict_items to move
+    if ( p_dict->entries.data == (void *) 0 || p_dict->entries.count == 0 )
+    {
+
+        // Store the layout
+        p_dict->layout = layout;
+
+        // Success
+        return 1;
+    }
+
+    // Inline values can not move
+    if ( p_dict->value_size ) goto inline_values;
+
+    // Allocate a dict_item for each property, indexed like the iterables
+    moved = DICT_REALLOC(0, count * sizeof(dict_item *));
+
+    // Error checking
+    if ( moved == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(moved, 0, count * sizeof(dict_item *));
+
+    // Allocate every dict_item first, so a failure leaves the dictionary as it was
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next)
+            if ( ( moved[i_di->index] = DICT_REALLOC(0, layout.size) ) == (void *) 0 ) goto no_mem;
+
+    // Carry the recency order over
+    if ( layout.lru && old.lru )
+    {
+
+        // Relink each property
+        for (dict_item *i_di = p_dict->p_ext->lru.head; i_di; i_di = ( (dict_lru_links *) DICT_ITEM_BLOCK(i_di, old.lru) )->next)
+        {
+
+            // Initialized data
+            dict_lru_links *p_old = DICT_ITEM_BLOCK(i_di, old.lru);
+
+            // Point at the moved neighbours
+            *(dict_lru_links *) DICT_ITEM_BLOCK(moved[i_di->index], layout.lru) = (dict_lru_links)
+            {
+                .prev = ( p_old->prev ) ? moved[p_old->prev->index] : 0,
+                .next = ( p_old->next ) ? moved[p_old->next->index] : 0
+            };
+        }
+
+        // Move the ends
+        if ( p_dict->p_ext->lru.head ) p_dict->p_ext->lru.head = moved[p_dict->p_ext->lru.head->index],
+                                       p_dict->p_ext->lru.tail = moved[p_dict->p_ext->lru.tail->index];
+    }
+
+    // Move each chain
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+    {
+
+        // Initialized data
+        dict_item **pp_tail = &p_dict->entries.data[i],
+                   *i_di    = *pp_tail;
+
+        // Walk the list
+        while ( i_di )
+        {
+
+            // Initialized data
+            dict_item *property = moved[i_di->index],
+                      *n        = i_di->next;
+
+            // Copy the property
+            *property = *i_di;
+
+            // Copy the expiry. The timer wheel is rebuilt below
+            if ( layout.ttl )
+                *(dict_ttl_links *) DICT_ITEM_BLOCK(property, layout.ttl) = (dict_ttl_links)
+                {
+                    .expiry = ( old.ttl ) ? ( (dict_ttl_links *) DICT_ITEM_BLOCK(i_di, old.ttl) )->expiry : 0
+                };
+
+            // Copy the inline value, and point the iterable at it
+            if ( p_dict->value_size )
+                property->value = DICT_ITEM_BLOCK(property, layout.value),
+                memcpy(property->value, i_di->value, p_dict->value_size),
+                p_dict->iterable.values[property->index] = property->value;
+
+            // Link the copy in place of the property
+            *pp_tail = property;
+            pp_tail  = &property->next;
+
+            // Free the property
+            i_di = DICT_REALLOC(i_di, 0);
+
+            // Iterate
+            i_di = n;
+        }
+    }
+
+    // Store the layout
+    p_dict->layout = layout;
+
+    // Reschedule every expiring property
+    if ( layout.ttl )
+    {
+
+        // Empty the timer wheel
+        memset(p_dict->p_ext->p_wheel->slots, 0, sizeof(p_dict->p_ext->p_wheel->slots));
+        p_dict->p_ext->p_wheel->count = 0;
+
+        // Schedule each property
+        for (size_t i = 0; i < count; i++)
+            if ( moved[i] && DICT_ITEM_TTL(p_dict, moved[i])->expiry )
+                dict_wheel_schedule(p_dict, moved[i], p_dict->p_ext->p_wheel->now);
+    }
+
+    // Rebuild the sorted index
+    if ( layout.tree ) dict_tree_build(p_dict);
+
+    // Free the map
+    moved = DICT_REALLOC(moved, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // dict errors
+        {
+            inline_values:
+                #ifndef NDEBUG
+                    log_error("[dict] Can not move the inline values of a populated dictionary in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( moved )
+                {
+                    for (size_t i = 0; i < count; i++) if ( moved[i] ) moved[i] = DICT_REALLOC(moved[i], 0);
+                    moved = DICT_REALLOC(moved, 0);
+                }
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Allocate a dictionary's timer wheel, if it does not have one. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_wheel_create ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_wheel *p_wheel = 0;
+
+    // Fast exit
+    if ( p_dict->p_ext->p_wheel ) return 1;
+
+    // Allocate a timer wheel
+    p_wheel = DICT_REALLOC(0, sizeof(dict_wheel));
+
+    // Error checking
+    if ( p_wheel == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_wheel, 0, sizeof(dict_wheel));
+
+    // One wheel tick per millisecond
+    p_wheel->resolution = timer_seconds_divisor() / 1000;
+    if ( p_wheel->resolution < 1 ) p_wheel->resolution = 1;
+
+    // Start at the current time
+    p_wheel->now = (uint64_t) DICT_CLOCK() / (uint64_t) p_wheel->resolution;
+
+    // Store the timer wheel
+    dict_ext_get(p_dict)->p_wheel = p_wheel;
+
+    // Give each property an expiry
+    if ( dict_relayout(p_dict) == 0 ) goto failed_to_relayout;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // dict errors
+        {
+            failed_to_relayout:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to make room for expiries in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                p_dict->p_ext->p_wheel = 0;
+                p_wheel                = DICT_REALLOC(p_wheel, 0);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Advance the timer wheel toward the current time, by at most max_ticks wheel 
+ *  ticks, and remove each property that expired. Caller holds the lock.
+ *
+ * @param p_dict    dictionary
+ * @param max_ticks most wheel ticks to process
+ *
+ * @return number of properties removed
+ */
+static size_t dict_expire_locked ( dict *const p_dict, size_t max_ticks )
+{
+
+    // Initialized data
+    dict_wheel *p_wheel = p_dict->p_ext->p_wheel;
+    timestamp   t       = 0;
+    uint64_t    target  = 0;
+    size_t      removed = 0;
+
+    // Fast exit
+    if ( p_wheel == (void *) 0 ) return 0;
+
+    // Store the current time
+    t      = DICT_CLOCK();
+    target = (uint64_t) t / (uint64_t) p_wheel->resolution;
+
+    // Zero means no limit
+    if ( max_ticks == 0 ) max_ticks = SIZE_MAX;
+
+    // Nothing is scheduled, so skip ahead
+    if ( p_wheel->count == 0 && p_wheel->now <= target ) p_wheel->now = target + 1;
+
+    // Process each tick up to the current time
+    for (size_t ticks = 0; ticks < max_ticks && p_wheel->now <= target; ticks++, p_wheel->now++)
+    {
+
+        // Cascade the higher levels whose slot just came due, from the top down
+        for (size_t level = DICT_WHEEL_LEVELS - 1; level > 0; level--)
+        {
+
+            // Initialized data
+            dict_item *list = 0;
+
+            // Is the tick on a boundary of this level?
+            if ( p_wheel->now & ( ( (uint64_t) 1 << ( DICT_WHEEL_BITS * level ) ) - 1 ) ) continue;
+
+            // Detach the slot
+            list = dict_wheel_detach(p_dict, &p_wheel->slots[level][( p_wheel->now >> ( DICT_WHEEL_BITS * level ) ) & ( DICT_WHEEL_SLOTS - 1 )]);
+
+            // Reschedule each property on a lower level
+            while ( list )
+            {
+
+                // Initialized data
+                dict_item *n = DICT_ITEM_TTL(p_dict, list)->next;
+
+                // Reschedule
+                dict_wheel_schedule(p_dict, list, p_wheel->now);
+
+                // Iterate
+                list = n;
+            }
+        }
+
+        // Detach this tick's slot
+        for (dict_item *list = dict_wheel_detach(p_dict, &p_wheel->slots[0][p_wheel->now & ( DICT_WHEEL_SLOTS - 1 )]); list; )
+        {
+
+            // Initialized data
+            dict_item *n = DICT_ITEM_TTL(p_dict, list)->next;
+
+            // Not expired yet
+            if ( DICT_ITEM_TTL(p_dict, list)->expiry > t ) dict_wheel_schedule(p_dict, list, p_wheel->now + 1);
+
+            // Remove the property
+            else if ( dict_item_evict(p_dict, list) ) removed++;
+
+            // Iterate
+            list = n;
+        }
+    }
+
+    // Done
+    return removed;
+}
+
+#ifdef DICT_POSIX
+/** !
+ *  Background expiry thread. Steps the timer wheel every interval until stopped.
+ *
+ * @param p_parameter the dictionary
+ *
+ * @return null pointer
+ */
+static void *dict_expire_thread ( void *p_parameter )
+{
+
+    // Initialized data
+    dict       *p_dict  = p_parameter;
+    dict_wheel *p_wheel = p_dict->p_ext->p_wheel;
+
+    // Lock the thread state
+    pthread_mutex_lock(&p_wheel->thread.mutex);
+
+    // Run until stopped
+    while ( p_wheel->thread.stop == false )
+    {
+
+        // Initialized data
+        struct timespec deadline  = { 0 };
+        long long       ns        = (long long) ( (double) p_wheel->thread.interval * 1000000000.0 / (double) timer_seconds_divisor() );
+
+        // Compute the deadline
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec  += (time_t) ( ns / 1000000000 );
+        deadline.tv_nsec += (long) ( ns % 1000000000 );
+        if ( deadline.tv_nsec >= 1000000000 ) deadline.tv_sec++, deadline.tv_nsec -= 1000000000;
+
+        // Wait for the interval, or a stop
+        pthread_cond_timedwait(&p_wheel->thread.cond, &p_wheel->thread.mutex, &deadline);
+
+        // Stopped?
+        if ( p_wheel->thread.stop ) break;
+
+        // Unlock the thread state
+        pthread_mutex_unlock(&p_wheel->thread.mutex);
+
+        // Step the wheel
+        dict_lock(p_dict);
+        dict_expire_locked(p_dict, p_wheel->thread.max_ticks);
+        mutex_unlock(&p_dict->_lock);
+
+        // Lock the thread state
+        pthread_mutex_lock(&p_wheel->thread.mutex);
+    }
+
+    // Unlock the thread state
+    pthread_mutex_unlock(&p_wheel->thread.mutex);
+
+    // Done
+    return 0;
+}
+
+/** !
+ *  Start a timer wheel's expiry thread. Caller holds the lock, which the thread
+ *  waits for before it steps the wheel.
+ *
+ * @param p_dict dictionary, with a timer wheel
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_expire_spawn ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_wheel *p_wheel = p_dict->p_ext->p_wheel;
+
+    // Initialize the thread state
+    pthread_mutex_init(&p_wheel->thread.mutex, 0);
+    pthread_cond_init(&p_wheel->thread.cond, 0);
+
+    // Start the thread
+    if ( pthread_create(&p_wheel->thread.thread, 0, dict_expire_thread, p_dict) ) goto failed_to_create_thread;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            failed_to_create_thread:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Call to \"pthread_create\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Release the thread state
+                pthread_cond_destroy(&p_wheel->thread.cond);
+                pthread_mutex_destroy(&p_wheel->thread.mutex);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Stop a timer wheel's expiry thread, and wait for it to exit. The thread counts
+ *  as running until it is joined, so a concurrent dict_expire_start fails instead
+ *  of reusing its state. Caller does not hold the lock.
+ *
+ * @param p_dict dictionary, with a timer wheel
+ *
+ * @return void
+ */
+static void dict_expire_join ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_wheel *p_wheel = p_dict->p_ext->p_wheel;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Fast exit. Not running, or another caller is already stopping it
+    if ( p_wheel->thread.running == false || p_wheel->thread.stop ) { mutex_unlock(&p_dict->_lock); return; }
+
+    // Signal the thread
+    pthread_mutex_lock(&p_wheel->thread.mutex);
+    p_wheel->thread.stop = true;
+    pthread_cond_signal(&p_wheel->thread.cond);
+    pthread_mutex_unlock(&p_wheel->thread.mutex);
+
+    // Unlock, so the thread can finish its step
+    mutex_unlock(&p_dict->_lock);
+
+    // Wait for it to exit
+    pthread_join(p_wheel->thread.thread, 0);
+
+    // Release the thread state
+    pthread_cond_destroy(&p_wheel->thread.cond);
+    pthread_mutex_destroy(&p_wheel->thread.mutex);
+
+    // Store the state
+    dict_lock(p_dict);
+    p_wheel->thread.running = false;
+    p_wheel->thread.stop    = false;
+    mutex_unlock(&p_dict->_lock);
+}
+#else
+
+/** !
+ *  Start a timer wheel's expiry thread. Without POSIX threads, there is none
+ *
+ * @param p_dict dictionary, with a timer wheel
+ *
+ * @return 0
+ */
+static int dict_expire_spawn ( dict *const p_dict )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+
+    #ifndef NDEBUG
+        log_error("[dict] The expiry thread needs POSIX threads, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+/** !
+ *  Stop a timer wheel's expiry thread. Without POSIX threads, none is running
+ *
+ * @param p_dict dictionary, with a timer wheel
+ *
+ * @return void
+ */
+static void dict_expire_join ( dict *const p_dict )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+}
+#endif
+
+/** !
+ *  Count the bytes a dictionary has allocated. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param p_memory return
+ *
+ * @return void
+ */
+static void dict_memory_locked ( const dict *const p_dict, dict_memory *const p_memory )
+{
+
+    // Count each component
+    *p_memory = (dict_memory)
+    {
+        .dict      = sizeof(dict),
+        .buckets   = ( p_dict->entries.data ) ? p_dict->entries.max * sizeof(dict_item *) : 0,
+        .nodes     = ( p_dict->entries.data ) ? p_dict->entries.count * dict_item_size(p_dict) : 0,
+        .iterables = ( p_dict->entries.data ) ? p_dict->iterable.max * ( sizeof(char *) + sizeof(void *) ) : 0,
+        .keys      = ( p_dict->p_ext->p_journal ) ? p_dict->p_ext->p_journal->keys.bytes : 0,
+        .wheel     = ( p_dict->p_ext->p_wheel ) ? sizeof(dict_wheel) : 0,
+        .filter    = ( p_dict->p_ext->filter.counters ) ? p_dict->p_ext->filter.mask + 1 : 0
+    };
+
+    // Sum them
+    p_memory->total = p_memory->dict + p_memory->buckets + p_memory->nodes + p_memory->iterables + p_memory->keys + p_memory->wheel + p_memory->filter;
+}
+
+/** !
+ *  Make room in the budget for one more property. Evicts least recently used
+ *  properties if the dictionary has an eviction callback. Caller holds the lock.
+ *
+ * @param p_dict dictionary with a budget
+ *
+ * @return 1 if the property fits, 0 if it does not
+ */
+static int dict_budget_reserve ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_memory memory = { 0 };
+
+    // Evict until the property fits
+    for (;;)
+    {
+
+        // Initialized data
+        size_t cost = dict_item_size(p_dict);
+
+        // Count the bytes in use
+        dict_memory_locked(p_dict, &memory);
+
+        // The iterables double when they are full
+        if ( p_dict->entries.count >= p_dict->iterable.max ) cost += p_dict->iterable.max * ( sizeof(char *) + sizeof(void *) );
+
+        // Does it fit?
+        if ( memory.total + cost <= p_dict->p_ext->budget ) return 1;
+
+        // Fail fast, unless the caller asked for eviction
+        if ( p_dict->pfn_evict == (void *) 0 || p_dict->p_ext->lru.tail == (void *) 0 ) return 0;
+
+        // Evict the least recently used property
+        if ( dict_item_evict(p_dict, p_dict->p_ext->lru.tail) == 0 ) return 0;
+    }
+}
+
+/** !
+ *  Find a property in a small dictionary. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ * @param key    the name of the property
+ * @param h      the hash of the key
+ *
+ * @return index of the property, or the entry count if the key is not in the dictionary
+ */
+static size_t dict_small_find ( dict *const p_dict, const char *const key, unsigned long long h )
+{
+
+    // Initialized data
+    size_t i = 0;
+
+    // Scan the cached hashes
+    for (; i < p_dict->entries.count; i++)
+
+        // Is this the right entry?
+        if ( p_dict->small.hashes[i] == h && strcmp(key, p_dict->small.keys[i]) == 0 ) break;
+
+    // Done
+    return i;
+}
+
+/** !
+ *  Move a small dictionary's inline properties into a hash table, with "size" buckets
+ *  as passed to dict_construct. On error the dictionary is left small. Caller holds
+ *  the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_promote ( dict *const p_dict )
+{
+
+    // Initialized data
+    size_t       count                 = p_dict->entries.count;
+    dict_item   *items[DICT_SMALL_MAX] = { 0 };
+    dict_item  **data                  = dict_array_alloc(p_dict, p_dict->entries.max * sizeof(dict_item *));
+    char       **keys                  = dict_array_alloc(p_dict, 2 * DICT_SMALL_MAX * sizeof(char *));
+    void       **values                = dict_array_alloc(p_dict, 2 * DICT_SMALL_MAX * sizeof(void *));
+
+    // Error checking
+    if ( data   == (void *) 0 ) goto no_mem;
+    if ( keys   == (void *) 0 ) goto no_mem;
+    if ( values == (void *) 0 ) goto no_mem;
+
+    // Allocate a dict_item for each property
+    for (size_t i = 0; i < count; i++)
+        if ( ( items[i] = DICT_REALLOC(0, dict_item_size(p_dict)) ) == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(data, 0, p_dict->entries.max * sizeof(dict_item *));
+
+    // Insert each property
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        size_t b = p_dict->small.hashes[i] % p_dict->entries.max;
+
+        // Set the property
+        *items[i] = (dict_item)
+        {
+            .key   = p_dict->small.keys[i],
+            .value = p_dict->small.values[i],
+            .index = i,
+            .hash  = p_dict->small.hashes[i],
+            .next  = data[b]
+        };
+
+        // It does not expire
+        if ( p_dict->layout.ttl ) *DICT_ITEM_TTL(p_dict, items[i]) = (dict_ttl_links) { 0 };
+
+        // Insert the property
+        data[b] = items[i];
+    }
+
+    // Copy the iterables
+    memcpy(keys  , p_dict->small.keys  , count * sizeof(char *));
+    memcpy(values, p_dict->small.values, count * sizeof(void *));
+
+    // Switch to the hash table
+    p_dict->entries.data    = data;
+    p_dict->iterable.keys   = keys;
+    p_dict->iterable.values = values;
+    p_dict->iterable.count  = count;
+    p_dict->iterable.max    = 2 * DICT_SMALL_MAX;
+
+    // The small properties are free
+    dict_ext_reclaim(p_dict);
+
+    // Record the resize
+    dict_stats_resize(p_dict);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                for (size_t i = 0; i < count; i++) if ( items[i] ) items[i] = DICT_REALLOC(items[i], 0);
+                if ( data   ) dict_array_free(p_dict, data  , p_dict->entries.max * sizeof(dict_item *));
+                if ( keys   ) dict_array_free(p_dict, keys  , 2 * DICT_SMALL_MAX * sizeof(char *));
+                if ( values ) dict_array_free(p_dict, values, 2 * DICT_SMALL_MAX * sizeof(void *));
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Get a property's value. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param key      the name of the property
+ * @param h        the hash of the key
+ * @param pp_value return the value, or null pointer if the key is not in the dictionary
+ *
+ * @return true if the key is in the dictionary, else false
+ */
+static bool dict_get_locked ( dict *const p_dict, const char *const key, unsigned long long h, void **const pp_value )
+{
+
+    // Initialized data
+    void   *p_value = 0;
+    size_t  probes  = 0;
+    bool    found   = false;
+
+    // Definitely absent? Skip the search
+    if ( dict_filter_absent(p_dict, h) ) dict_stats_filtered(p_dict);
+
+    // Small dictionary?
+    else if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i = dict_small_find(p_dict, key, h);
+
+        // Store the result
+        found  = i < p_dict->entries.count;
+        probes = ( found ) ? i + 1 : i;
+
+        // Extract the value
+        if ( found ) p_value = p_dict->small.values[i];
+    }
+
+    // Hash table
+    else
+    {
+
+        // Initialized data
+        dict_item *p_item = *dict_item_find(p_dict, key, h, &probes);
+
+        // Remove the property, if it expired
+        if ( p_item && dict_item_expired(p_dict, p_item) ) dict_item_evict(p_dict, p_item), p_item = 0;
+
+        // Store the result
+        found = p_item != (void *) 0;
+
+        // Extract the value, and mark the property as used
+        if ( found ) p_value = p_item->value, dict_lru_touch(p_dict, p_item);
+    }
+
+    // Record the lookup
+    dict_stats_get(p_dict, found, probes);
+
+    // Return the value
+    *pp_value = p_value;
+
+    // Done
+    return found;
+}
+
+/** !
+ *  Find a property, or add it if it is missing. A hit marks the property as used. 
+ *  An expired property counts as missing. Caller holds the lock.
+ *
+ * @param p_dict      dictionary
+ * @param key         the name of the property
+ * @param p_value     the value to add, if the property is missing
+ * @param h           the hash of the key
+ * @param p_inserted  return true if the property was added, else false
+ * @param pp_property return the property -OR- null pointer while the dictionary is small
+ *
+ * @return the slot that holds the property's value on success, null pointer on error
+ */
+static void **dict_find_or_add_locked ( dict *const p_dict, const char *const key, void *const p_value, unsigned long long h, bool *const p_inserted, dict_item **const pp_property )
+{
+
+    // Initialized data
+    dict_item **pp_link  = 0,
+               *property = 0;
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i = dict_small_find(p_dict, key, h);
+
+        // No property to return
+        *pp_property = 0;
+
+        // Found
+        if ( i < p_dict->entries.count ) return *p_inserted = false, &p_dict->small.values[i];
+
+        // Append a new property
+        if ( i < DICT_SMALL_MAX )
+        {
+
+            // Set the property
+            p_dict->small.hashes[i] = h;
+            p_dict->small.keys[i]   = (char *) key;
+            p_dict->small.values[i] = p_value;
+
+            // Increment the entry counters
+            p_dict->entries.count++;
+            p_dict->iterable.count++;
+
+            // Count it in the membership filter
+            dict_filter_add(p_dict, h);
+
+            // Record the add
+            dict_stats_add(p_dict, false);
+            dict_journal_record(p_dict, DICT_JOURNAL_ADD, key, p_value);
+
+            // Done
+            return *p_inserted = true, &p_dict->small.values[i];
+        }
+
+        // Outgrown
+        if ( dict_promote(p_dict) == 0 ) return 0;
+    }
+
+    // Find the key in the hash table
+    pp_link = dict_item_find(p_dict, key, h, 0);
+
+    // An expired property is gone
+    if ( *pp_link && dict_item_expired(p_dict, *pp_link) )
+    {
+
+        // Remove it
+        if ( dict_item_evict(p_dict, *pp_link) == 0 ) return 0;
+
+        // Find the key in the hash table
+        pp_link = dict_item_find(p_dict, key, h, 0);
+    }
+
+    // Found
+    if ( *pp_link )
+    {
+
+        // Mark the property as used
+        dict_lru_touch(p_dict, *pp_link);
+
+        // Return the property
+        *pp_property = *pp_link;
+
+        // Done
+        return *p_inserted = false, &(*pp_link)->value;
+    }
+
+    // Over budget? Eviction may unlink nodes, so find the link again
+    if ( p_dict->p_ext->budget )
+    {
+
+        // Make room
+        if ( dict_budget_reserve(p_dict) == 0 ) return 0;
+
+        // Find the key in the hash table
+        pp_link = dict_item_find(p_dict, key, h, 0);
+    }
+
+    // Insert the property
+    if ( dict_item_insert(p_dict, pp_link, key, p_value, h) == 0 ) return 0;
+
+    // Store the property, before eviction can move the link
+    property = *pp_link;
+
+    // Log the add
+    dict_journal_record(p_dict, DICT_JOURNAL_ADD, key, property->value);
+
+    // Over capacity? The new property is the most recently used, so it stays
+    if ( p_dict->p_ext->lru.capacity && p_dict->entries.count > p_dict->p_ext->lru.capacity && dict_item_evict(p_dict, p_dict->p_ext->lru.tail) == 0 ) return 0;
+
+    // Return the property
+    *pp_property = property;
+
+    // Done
+    return *p_inserted = true, &property->value;
+}
+
+/** !
+ *  Replace a found property's value. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param pp_slot  the slot returned by dict_find_or_add_locked
+ * @param property the property returned by dict_find_or_add_locked
+ * @param p_value  the new value. Inline values are copied from it
+ *
+ * @return void
+ */
+static void dict_slot_set ( dict *const p_dict, void **const pp_slot, dict_item *const property, void *const p_value )
+{
+
+    // Small dictionaries store the value in the slot
+    if ( property == (void *) 0 )
+    {
+
+        // Update the slot
+        *pp_slot = p_value;
+
+        // Log the update
+        dict_journal_record(p_dict, DICT_JOURNAL_ADD, p_dict->small.keys[pp_slot - p_dict->small.values], p_value);
+
+        // Done
+        return;
+    }
+
+    // Update the property, unless the caller wrote the inline value in place
+    if ( p_value != property->value || p_dict->value_size == 0 ) dict_item_set(p_dict, property, p_value);
+
+    // Update the iterable
+    p_dict->iterable.values[property->index] = property->value;
+
+    // Log the update
+    dict_journal_record(p_dict, DICT_JOURNAL_ADD, property->key, property->value);
+}
+
+/** !
+ *  Compare a property's value to expected, and replace it with desired if they
+ *  match. Inline values are compared and copied byte for byte. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param key      the name of the property
+ * @param h        the hash of the key
+ * @param expected the value to compare with
+ * @param desired  the new value
+ *
+ * @return true if the value was replaced, else false
+ */
+static bool dict_cas_locked ( dict *const p_dict, const char *const key, unsigned long long h, const void *const expected, void *const desired )
+{
+
+    // Initialized data
+    dict_item **pp_link = 0;
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i = dict_small_find(p_dict, key, h);
+
+        // Not found, or changed
+        if ( i == p_dict->entries.count || p_dict->small.values[i] != expected ) return false;
+
+        // Swap
+        dict_slot_set(p_dict, &p_dict->small.values[i], 0, desired);
+
+        // Done
+        return true;
+    }
+
+    // Find the key in the hash table
+    pp_link = dict_item_find(p_dict, key, h, 0);
+
+    // Not found
+    if ( *pp_link == (void *) 0 ) return false;
+
+    // An expired property is gone
+    if ( dict_item_expired(p_dict, *pp_link) ) return dict_item_evict(p_dict, *pp_link), false;
+
+    // Changed?
+    if ( p_dict->value_size ? memcmp((*pp_link)->value, expected, p_dict->value_size) != 0 : (*pp_link)->value != expected ) return false;
+
+    // Mark the property as used
+    dict_lru_touch(p_dict, *pp_link);
+
+    // Swap
+    dict_slot_set(p_dict, &(*pp_link)->value, *pp_link, desired);
+
+    // Done
+    return true;
+}
+
+/** !
+ *  Add delta to a counter, adding the counter at zero if it is missing. Pointer 
+ *  values hold the count themselves, and inline values hold a long long. 
+ *  Caller holds the lock.
+ *
+ * @param p_dict     dictionary
+ * @param key        the name of the property
+ * @param h          the hash of the key
+ * @param delta      the amount to add
+ * @param p_previous return the count before the add -OR- null pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_fetch_add_locked ( dict *const p_dict, const char *const key, unsigned long long h, long long delta, long long *const p_previous )
+{
+
+    // Initialized data
+    dict_item  *property = 0;
+    bool        inserted = false;
+    void      **pp_slot  = dict_find_or_add_locked(p_dict, key, 0, h, &inserted, &property);
+    long long   previous = 0;
+
+    // Error check
+    if ( pp_slot == (void *) 0 ) return 0;
+
+    // Inline counter, written in place
+    if ( p_dict->value_size )
+        previous = *(long long *) *pp_slot,
+        *(long long *) *pp_slot = (long long) ( (unsigned long long) previous + (unsigned long long) delta ),
+        dict_slot_set(p_dict, pp_slot, property, *pp_slot);
+
+    // Pointer sized counter
+    else
+        previous = (long long) (intptr_t) *pp_slot,
+        dict_slot_set(p_dict, pp_slot, property, (void *) (intptr_t) ( (unsigned long long) previous + (unsigned long long) delta ));
+
+    // Record the update
+    if ( inserted == false ) dict_stats_add(p_dict, true);
+
+    // Return the count before the add
+    if ( p_previous ) *p_previous = previous;
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Add or update a property. Caller holds the lock.
+ *
+ * @param p_dict  dictionary
+ * @param key     the name of the property
+ * @param p_value the value of the property
+ * @param h       the hash of the key
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_add_locked ( dict *const p_dict, const char *const key, void *const p_value, unsigned long long h )
+{
+
+    // Initialized data
+    dict_item  *property = 0;
+    bool        inserted = false;
+    void      **pp_slot  = dict_find_or_add_locked(p_dict, key, p_value, h, &inserted, &property);
+
+    // Error check
+    if ( pp_slot == (void *) 0 ) return 0;
+
+    // Added
+    if ( inserted ) return 1;
+
+    // A plain update does not expire
+    if ( property && p_dict->layout.ttl && DICT_ITEM_TTL(p_dict, property)->pprev ) dict_wheel_unschedule(p_dict, property);
+    if ( property && p_dict->layout.ttl ) DICT_ITEM_TTL(p_dict, property)->expiry = 0;
+
+    // Update the property
+    dict_slot_set(p_dict, pp_slot, property, p_value);
+
+    // Record the update
+    dict_stats_add(p_dict, true);
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Remove a property. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param key      the name of the property
+ * @param h        the hash of the key
+ * @param pp_value return -OR- null pointer
+ *
+ * @return 1 on success, 0 if the key is not in the dictionary or has expired
+ */
+static int dict_pop_locked ( dict *const p_dict, const char *const key, unsigned long long h, const void **const pp_value )
+{
+
+    // Initialized data
+    dict_item **pp_link = 0;
+
+    // Definitely absent?
+    if ( dict_filter_absent(p_dict, h) ) return 0;
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i    = dict_small_find(p_dict, key, h),
+               last = p_dict->entries.count - 1;
+
+        // Error check
+        if ( i == p_dict->entries.count ) return 0;
+
+        // Return the value
+        if ( pp_value ) *pp_value = p_dict->small.values[i];
+
+        // Shift the later properties down, keeping insertion order
+        memmove(&p_dict->small.hashes[i], &p_dict->small.hashes[i + 1], ( last - i ) * sizeof(unsigned long long));
+        memmove(&p_dict->small.keys[i]  , &p_dict->small.keys[i + 1]  , ( last - i ) * sizeof(char *));
+        memmove(&p_dict->small.values[i], &p_dict->small.values[i + 1], ( last - i ) * sizeof(void *));
+
+        // Clear the last property
+        p_dict->small.keys[last]   = 0;
+        p_dict->small.values[last] = 0;
+
+        // Decrement entries
+        p_dict->entries.count--;
+        p_dict->iterable.count--;
+
+        // Uncount it from the membership filter
+        dict_filter_remove(p_dict, h);
+
+        // Record the pop
+        dict_stats_pop(p_dict);
+        dict_journal_record(p_dict, DICT_JOURNAL_POP, key, 0);
+
+        // Success
+        return 1;
+    }
+
+    // Find the key in the hash table
+    pp_link = dict_item_find(p_dict, key, h, 0);
+
+    // Error check
+    if ( *pp_link == (void *) 0 ) return 0;
+
+    // An expired property is gone
+    if ( dict_item_expired(p_dict, *pp_link) ) return dict_item_evict(p_dict, *pp_link), 0;
+
+    // Remove the property
+    return dict_item_remove(p_dict, pp_link, pp_value);
+}
+
+/** !
+ *  Lock two dictionaries, in address order, so concurrent calls on the same 
+ *  pair can not deadlock
+ *
+ * @param p_a dictionary
+ * @param p_b dictionary, which may be p_a
+ *
+ * @return void
+ */
+static void dict_lock_pair ( dict *const p_a, dict *const p_b )
+{
+
+    // Same dictionary?
+    if ( p_a == p_b ) { dict_lock(p_a); return; }
+
+    // Lock the lower address first
+    dict_lock( ( p_a < p_b ) ? p_a : p_b );
+    dict_lock( ( p_a < p_b ) ? p_b : p_a );
+}
+
+/** !
+ *  Unlock two dictionaries locked by dict_lock_pair
+ *
+ * @param p_a dictionary
+ * @param p_b dictionary, which may be p_a
+ *
+ * @return void
+ */
+static void dict_unlock_pair ( dict *const p_a, dict *const p_b )
+{
+
+    // Unlock
+    mutex_unlock(&p_a->_lock);
+    if ( p_a != p_b ) mutex_unlock(&p_b->_lock);
+}
+
+/** !
+ *  Start visiting a dictionary's properties in insertion order, with their stored
+ *  hashes. Until dict_visit_end, each iterable value slot points at its property.
+ *  Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return number of properties
+ */
+static size_t dict_visit_begin ( dict *const p_dict )
+{
+
+    // Small dictionaries keep their hashes inline
+    if ( p_dict->entries.data == (void *) 0 ) return p_dict->entries.count;
+
+    // Squeeze out any tombstones
+    dict_iterable_compact(p_dict);
+
+    // Point each slot at its property
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next)
+            p_dict->iterable.values[i_di->index] = i_di;
+
+    // Done
+    return p_dict->entries.count;
+}
+
+/** !
+ *  Get the i'th property of a dictionary being visited. Caller holds the lock.
+ *
+ * @param p_dict  dictionary, between dict_visit_begin and dict_visit_end
+ * @param i       the index
+ * @param p_key   return
+ * @param p_value return
+ * @param p_hash  return
+ *
+ * @return void
+ */
+static void dict_visit_at ( dict *const p_dict, size_t i, char **const p_key, void **const p_value, unsigned long long *const p_hash )
+{
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+        *p_key   = p_dict->small.keys[i];
+        *p_value = p_dict->small.values[i];
+        *p_hash  = p_dict->small.hashes[i];
+
+        // Done
+        return;
+    }
+
+    // Initialized data
+    dict_item *property = p_dict->iterable.values[i];
+
+    // Return the property
+    *p_key   = property->key;
+    *p_value = property->value;
+    *p_hash  = property->hash;
+}
+
+/** !
+ *  Finish visiting a dictionary, and point the iterable value slots back at the 
+ *  values. Caller holds the lock.
+ *
+ * @param p_dict dictionary
+ *
+ * @return void
+ */
+static void dict_visit_end ( dict *const p_dict )
+{
+
+    // Small dictionaries were not touched
+    if ( p_dict->entries.data == (void *) 0 ) return;
+
+    // Restore each slot
+    for (size_t i = 0; i < p_dict->entries.count; i++)
+        p_dict->iterable.values[i] = ( (dict_item *) p_dict->iterable.values[i] )->value;
+}
+
+/** !
+ *  Look up a property without marking it as used, expiring it, or recording 
+ *  statistics. Caller holds the lock.
+ *
+ * @param p_dict   dictionary
+ * @param key      the name of the property
+ * @param h        the hash of the key, from the dictionary's hash function
+ * @param pp_value return
+ *
+ * @return true if the key is in the dictionary, else false
+ */
+static bool dict_peek_locked ( dict *const p_dict, const char *const key, unsigned long long h, void **const pp_value )
+{
+
+    // Definitely absent?
+    if ( dict_filter_absent(p_dict, h) ) return false;
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i = dict_small_find(p_dict, key, h);
+
+        // Not found
+        if ( i == p_dict->entries.count ) return false;
+
+        // Found
+        *pp_value = p_dict->small.values[i];
+
+        // Done
+        return true;
+    }
+
+    // Initialized data
+    dict_item *property = *dict_item_find(p_dict, key, h, 0);
+
+    // Not found
+    if ( property == (void *) 0 ) return false;
+
+    // Found
+    *pp_value = property->value;
+
+    // Done
+    return true;
+}
+
+/** !
+ *  Get the key a dictionary stores for a property, which may be a different
+ *  pointer to the same string as the key it was looked up with. Caller holds
+ *  the lock.
+ *
+ * @param p_dict dictionary
+ * @param key    the name of the property
+ * @param h      the hash of the key, from the dictionary's hash function
+ *
+ * @return the stored key -OR- null pointer if the key is not in the dictionary
+ */
+static const char *dict_key_locked ( dict *const p_dict, const char *const key, unsigned long long h )
+{
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i = dict_small_find(p_dict, key, h);
+
+        // Done
+        return ( i == p_dict->entries.count ) ? 0 : p_dict->small.keys[i];
+    }
+
+    // Initialized data
+    dict_item *property = *dict_item_find(p_dict, key, h, 0);
+
+    // Done
+    return ( property ) ? property->key : 0;
+}
+
+/** !
+ *  Hash a key for another dictionary, reusing a stored hash when both 
+ *  dictionaries share a hash function
+ *
+ * @param p_from the dictionary the hash came from
+ * @param p_to   the dictionary the hash is for
+ * @param key    the key
+ * @param h      the stored hash, from p_from
+ *
+ * @return the hash of the key for p_to
+ */
+static unsigned long long dict_rehash ( const dict *const p_from, const dict *const p_to, const char *const key, unsigned long long h )
+{
+
+    // Done
+    return ( p_from->pfn_hash_function == p_to->pfn_hash_function ) ? h : p_to->pfn_hash_function((void *)key, strlen(key));
+}
+
+/** !
+ *  Construct an empty dictionary with another dictionary's size, hash function,
+ *  value size and placement
+ *
+ * @param p_dict  dictionary
+ * @param pp_dict return
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_construct_like ( const dict *const p_dict, dict **const pp_dict )
+{
+
+    // Placed arrays
+    if ( p_dict->p_ext->placement.pages || p_dict->p_ext->placement.numa ) return dict_construct_placed(pp_dict, p_dict->entries.max, p_dict->value_size, &p_dict->p_ext->placement, p_dict->pfn_hash_function);
+
+    // Inline values
+    if ( p_dict->value_size ) return dict_construct_sized(pp_dict, p_dict->entries.max, p_dict->value_size, p_dict->pfn_hash_function);
+
+    // Pointer values
+    return dict_construct(pp_dict, p_dict->entries.max, p_dict->pfn_hash_function);
+}
+
+/** !
+ *  Apply the log to a replica, until it has every published operation. Caller holds
+ *  the replicated dictionary's lock. Properties are allocated by the calling thread,
+ *  so a replica brought up to date by its own readers is filled from their node.
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param p_replica         the replica
+ *
+ * @return 1 on success, 0 on error
+ */
+static int replicated_dict_catch_up ( replicated_dict *const p_replicated_dict, dict_replica *const p_replica )
+{
+
+    // Apply each operation the replica is missing
+    while ( p_replica->applied < p_replicated_dict->log.end )
+    {
+
+        // Initialized data
+        const dict_op *p_op   = &p_replicated_dict->log.ops[p_replica->applied - p_replicated_dict->log.base];
+        dict          *p_dict = p_replica->p_dict;
+        int            result = 1;
+
+        // Clear
+        if ( p_op->key == (void *) 0 ) result = dict_clear(p_dict);
+
+        // Add or remove the property
+        else
+        {
+
+            // Lock the replica
+            dict_lock(p_dict);
+
+            // A replica that is missing the property has nothing to remove
+            if ( p_op->pop ) dict_pop_locked(p_dict, p_op->key, p_op->h, 0);
+            else             result = dict_add_locked(p_dict, p_op->key, p_op->p_value, p_op->h);
+
+            // Unlock the replica
+            mutex_unlock(&p_dict->_lock);
+        }
+
+        // Error check
+        if ( result == 0 ) return 0;
+
+        // Publish the replica's progress to readers
+        __atomic_store_n(&p_replica->applied, p_replica->applied + 1, __ATOMIC_RELEASE);
+    }
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Append an operation to the log, and publish it to readers. Caller holds the
+ *  replicated dictionary's lock.
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param key               the name of the property -OR- null pointer to clear
+ * @param p_value           the value to add
+ * @param h                 the hash of the key
+ * @param pop               remove the property, instead of adding it?
+ *
+ * @return 1 on success, 0 on error
+ */
+static int replicated_dict_append ( replicated_dict *const p_replicated_dict, const char *const key, void *const p_value, unsigned long long h, bool pop )
+{
+
+    // Grow the log
+    if ( p_replicated_dict->log.count == p_replicated_dict->log.max )
+    {
+
+        // Initialized data
+        dict_op *ops = DICT_REALLOC(p_replicated_dict->log.ops, 2 * p_replicated_dict->log.max * sizeof(dict_op));
+
+        // Error check
+        if ( ops == (void *) 0 ) return 0;
+
+        // Store the larger log
+        p_replicated_dict->log.ops  = ops;
+        p_replicated_dict->log.max *= 2;
+    }
+
+    // Record the operation
+    p_replicated_dict->log.ops[p_replicated_dict->log.count++] = (dict_op)
+    {
+        .key     = key,
+        .p_value = p_value,
+        .h       = h,
+        .pop     = pop
+    };
+
+    // Publish the new end of the log
+    __atomic_store_n(&p_replicated_dict->log.end, p_replicated_dict->log.base + p_replicated_dict->log.count, __ATOMIC_RELEASE);
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Bring every replica up to date if asked, or if the log is long, then drop the
+ *  operations every replica has applied. Caller holds the replicated dictionary's lock.
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param all               apply the log to every replica, however short it is?
+ *
+ * @return 1 on success, 0 on error
+ */
+static int replicated_dict_settle ( replicated_dict *const p_replicated_dict, bool all )
+{
+
+    // Initialized data
+    size_t oldest = p_replicated_dict->log.end,
+           done   = 0;
+
+    // A long log costs every lagging reader, so the writer pays for it instead
+    if ( all || p_replicated_dict->log.count >= REPLICATED_DICT_LOG_MAX )
+        for (size_t i = 0; i < p_replicated_dict->count; i++)
+            if ( replicated_dict_catch_up(p_replicated_dict, &p_replicated_dict->replicas[i]) == 0 ) return 0;
+
+    // Find the operation the slowest replica applies next
+    for (size_t i = 0; i < p_replicated_dict->count; i++)
+        if ( p_replicated_dict->replicas[i].applied < oldest ) oldest = p_replicated_dict->replicas[i].applied;
+
+    // Drop every operation before it
+    done = oldest - p_replicated_dict->log.base;
+    if ( done == 0 ) return 1;
+    memmove(p_replicated_dict->log.ops, &p_replicated_dict->log.ops[done], ( p_replicated_dict->log.count - done ) * sizeof(dict_op));
+    p_replicated_dict->log.count -= done;
+    p_replicated_dict->log.base   = oldest;
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Find the replica on the calling thread's NUMA node, and bring it up to date
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param node              NUMA node
+ *
+ * @return the replica
+ */
+static dict_replica *replicated_dict_local ( replicated_dict *const p_replicated_dict, size_t node )
+{
+
+    // Initialized data
+    dict_replica *p_replica = &p_replicated_dict->replicas[p_replicated_dict->node_replica[node % DICT_NUMA_NODES_MAX]];
+
+    // Fast path. The replica has every published operation
+    if ( __atomic_load_n(&p_replica->applied, __ATOMIC_ACQUIRE) == __atomic_load_n(&p_replicated_dict->log.end, __ATOMIC_ACQUIRE) ) return p_replica;
+
+    // Apply the operations it is missing. A replica that can not catch up serves what it has
+    mutex_lock(&p_replicated_dict->_lock);
+    (void) replicated_dict_catch_up(p_replicated_dict, p_replica);
+    mutex_unlock(&p_replicated_dict->_lock);
+
+    // Done
+    return p_replica;
+}
+
+void dict_init ( void )
+{
+
+    // State check
+    if ( initialized == true ) return;
+
+    // Initialize the log library
+    log_init();
+
+    // Initialize the sync library
+    sync_init();
+
+    // Initialize the hash cache library
+    hash_cache_init();
+
+    // Build the CRC-32C tables, reflected polynomial 0x82F63B78
+    for (unsigned int i = 0; i < 256; i++)
+    {
+
+        // Initialized data
+        unsigned int crc = i;
+
+        // Divide
+        for (int j = 0; j < 8; j++) crc = ( crc >> 1 ) ^ ( 0x82F63B78U & ( 0U - ( crc & 1U ) ) );
+
+        // Store
+        crc32c_table[0][i] = crc;
+    }
+
+    // Extend the tables, one per byte of a word
+    for (int t = 1; t < 8; t++)
+        for (unsigned int i = 0; i < 256; i++)
+            crc32c_table[t][i] = ( crc32c_table[t - 1][i] >> 8 ) ^ crc32c_table[0][crc32c_table[t - 1][i] & 0xFF];
+
+    // Portable kernel
+    pfn_dict_hash = dict_hash_portable;
+
+    // Use the crc32 instruction, if the processor has it
+    #ifdef DICT_HASH_SSE42
+        if ( __builtin_cpu_supports("sse4.2") ) pfn_dict_hash = dict_hash_sse42;
+    #endif
+
+    // Set the initialized flag
+    initialized = true;
+
+    // Done
+    return;
+}
+
+unsigned long long dict_hash ( const void *const k, size_t l )
+{
+
+    // Dispatch
+    return dict_hash_kernel()(k, l);
+}
+
+int dict_create ( dict **const pp_dict )
+{
+
+    // Argument check
+    if ( pp_dict == (void *) 0 ) goto no_dictionary;
+
+    // Allocate memory for a dictionary
+    dict *p_dict = DICT_REALLOC(0, sizeof(dict));
+
+    // Error checking
+    if ( p_dict == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_dict, 0, sizeof(dict));
+
+    // No rare state yet
+    p_dict->p_ext = (dict_ext *) &dict_ext_none;
+
+    // Return the allocated memory
+    *pp_dict = p_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_construct ( dict **const pp_dict, size_t size, fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_dict == (void *) 0 ) goto no_dictionary;
+    if ( size    ==          0 ) goto zero_size;
+
+    // Initialized data
+    dict *p_dict = 0;
+
+    // Allocate a dictionary
+    if ( dict_create(pp_dict) == 0 ) goto failed_to_create_dict;
+
+    // Get a pointer to the allocated dictionary
+    p_dict = *pp_dict;
+
+    // Store the bucket count. The hash table is allocated when the 
+    // dictionary outgrows its DICT_SMALL_MAX inline properties
+    p_dict->entries.max = size;
+
+    // Iterate the inline properties
+    p_dict->iterable.keys   = p_dict->small.keys;
+    p_dict->iterable.values = p_dict->small.values;
+    p_dict->iterable.max    = DICT_SMALL_MAX;
+
+    // Plain dict_items
+    p_dict->layout = dict_layout_of(p_dict);
+
+    // Create a mutex
+    if ( mutex_create(&p_dict->_lock) == 0 ) goto failed_to_create_mutex;
+
+    // Set the hash function
+    if ( pfn_hash_function ) 
+        p_dict->pfn_hash_function = pfn_hash_function;
+
+    // Default
+    else
+        p_dict->pfn_hash_function = dict_hash_kernel();
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+        }
+
+        // Dictionary errors
+        {
+            failed_to_create_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to create dictionary in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+int dict_construct_sized ( dict **const pp_dict, size_t size, size_t value_size, fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_dict    == (void *) 0 ) goto no_dictionary;
+    if ( value_size ==          0 ) goto zero_value_size;
+
+    // Initialized data
+    dict *p_dict = 0;
+
+    // Construct a dictionary
+    if ( dict_construct(&p_dict, size, pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+    // Store the value size
+    p_dict->value_size = value_size;
+    p_dict->layout     = dict_layout_of(p_dict);
+
+    // Inline values live in the dict_items, so skip the small layout
+    if ( dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Return a pointer to the caller
+    *pp_dict = p_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_value_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"value_size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&p_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_construct_lru ( dict **const pp_dict, size_t size, size_t capacity, void (*pfn_evict)(const char *const key, void *const value), fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_dict  == (void *) 0 ) goto no_dictionary;
+    if ( capacity ==          0 ) goto zero_capacity;
+
+    // Initialized data
+    dict *p_dict = 0;
+
+    // Construct a dictionary
+    if ( dict_construct(&p_dict, size, pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+    // Recency is kept in the dict_items, so skip the small layout
+    if ( dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Store the capacity and the eviction callback
+    dict_ext_get(p_dict)->lru.capacity = capacity;
+    p_dict->pfn_evict                  = pfn_evict;
+    p_dict->layout                     = dict_layout_of(p_dict);
+
+    // Return a pointer to the caller
+    *pp_dict = p_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_capacity:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"capacity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&p_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_construct_budget ( dict **const pp_dict, size_t size, size_t budget, void (*pfn_evict)(const char *const key, void *const value), fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_dict == (void *) 0 ) goto no_dictionary;
+    if ( budget  ==          0 ) goto zero_budget;
+
+    // Initialized data
+    dict        *p_dict = 0;
+    dict_memory  memory = { 0 };
+
+    // Construct a dictionary
+    if ( dict_construct(&p_dict, size, pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+    // Nodes are what the budget evicts, so skip the small layout
+    if ( dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Store the budget and the eviction callback
+    dict_ext_get(p_dict)->budget = budget;
+    p_dict->pfn_evict            = pfn_evict;
+
+    // Evicting needs recency, but not a count bound
+    if ( pfn_evict ) p_dict->p_ext->lru.capacity = SIZE_MAX;
+
+    // Lay out the dict_items
+    p_dict->layout = dict_layout_of(p_dict);
+
+    // Does the empty dictionary fit?
+    dict_memory_locked(p_dict, &memory);
+    if ( memory.total > budget ) goto budget_too_small;
+
+    // Return a pointer to the caller
+    *pp_dict = p_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_budget:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"budget\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&p_dict);
+
+                // Error
+                return 0;
+
+            budget_too_small:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameter \"budget\" is smaller than an empty dictionary (%zu bytes) in call to function \"%s\"\n", memory.total, __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&p_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_construct_placed ( dict **const pp_dict, size_t size, size_t value_size, const dict_placement_config *const p_placement, fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_dict            == (void *) 0           ) goto no_dictionary;
+    if ( p_placement        == (void *) 0           ) goto no_placement;
+    if ( p_placement->pages >  DICT_PAGES_EXPLICIT  ) goto bad_placement;
+    if ( p_placement->numa  >  DICT_NUMA_INTERLEAVE ) goto bad_placement;
+
+    // Placement maps arrays, which needs POSIX
+    #ifndef DICT_POSIX
+        if ( p_placement->pages || p_placement->numa ) goto unsupported_platform;
+    #endif
+
+    // Initialized data
+    dict *p_dict = 0;
+
+    // Construct a dictionary
+    if ( dict_construct(&p_dict, size, pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+    // The hash table is allocated with the placement, so store it while the dictionary is small
+    if ( p_placement->pages || p_placement->numa )
+    {
+
+        // Allocate the rare state
+        if ( dict_ext_get(p_dict) == (void *) 0 ) goto failed_to_promote;
+
+        // Store the placement
+        p_dict->p_ext->placement = *p_placement;
+    }
+
+    // Store the value size
+    p_dict->value_size = value_size;
+    p_dict->layout     = dict_layout_of(p_dict);
+
+    // Allocate the hash table now, so a placement that cannot be honored fails here
+    if ( dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Return a pointer to the caller
+    *pp_dict = p_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_placement:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_placement\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            bad_placement:
+                #ifndef NDEBUG
+                    log_error("[dict] Unknown page size or NUMA policy provided for parameter \"p_placement\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            #ifndef DICT_POSIX
+                unsupported_platform:
+                    #ifndef NDEBUG
+                        log_error("[dict] Placement needs POSIX memory mappings, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+                    #endif
+
+                    // Error
+                    return 0;
+            #endif
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate a placed hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&p_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_from_keys ( dict **const pp_dict, const char **const keys, size_t size )
+{
+
+    // Argument check
+    if ( pp_dict == (void *) 0 ) goto no_dictionary;
+    if ( keys    == (void *) 0 ) goto no_keys;
+
+    // TODO: replace with a goto
+    if ( size == 0 ) return 0;
+
+    // Initialized data
+    dict *p_dict = 0;
+
+    // Allocate a dictionary
+    if ( dict_construct(&p_dict, size, 0) == 0 ) goto failed_to_construct_dict;
+
+    // Iterate over each key
+    for (size_t i = 0; keys[i]; i++)
+
+        // Add the key to the dictionary
+        dict_add(p_dict, keys[i], (void *)0);
+
+    // Return
+    *pp_dict = p_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_keys:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"keys\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const void *dict_get ( dict *const p_dict, const char *const key )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( key    == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h   = p_dict->pfn_hash_function(key, strlen(key));
+    void               *val = 0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Find the property
+    dict_get_locked(p_dict, key, h, &val);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Return the value if it exists, otherwise null pointer
+    return val;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t dict_values ( dict *const p_dict, void **const values )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictioanry;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Initialized data
+    size_t entry_count = p_dict->entries.count;
+
+    // Error check
+    if (values == 0)
+    {
+
+        // Unlock
+        mutex_unlock(&p_dict->_lock);
+
+        // Success
+        return entry_count;
+    }
+
+    // Squeeze out any tombstones
+    dict_iterable_compact(p_dict);
+
+    // Copy memory
+    memcpy(values, p_dict->iterable.values, entry_count * sizeof(void *));
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictioanry:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t dict_keys ( dict *const p_dict, const char **const keys )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictioanry;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Initialized data
+    size_t entry_count = p_dict->entries.count;
+
+    // Counting branch?
+    if ( keys == 0 )
+    {
+
+        // Unlock
+        mutex_unlock(&p_dict->_lock);
+
+        // Return
+        return entry_count;
+    }
+
+    // Squeeze out any tombstones
+    dict_iterable_compact(p_dict);
+
+    // Copy memory
+    memcpy(keys, p_dict->iterable.keys, entry_count * sizeof(char *));
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictioanry:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+int dict_add ( dict *const p_dict, const char *const key,   void * const p_value )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( key    == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long h = p_dict->pfn_hash_function((void *)key, strlen(key));
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Add or update the property
+    if ( dict_add_locked(p_dict, key, p_value, h) == 0 ) goto failed_to_insert;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_get_or_insert ( dict *const p_dict, const char *const key, void *const p_value, const void **const pp_value, bool *const p_inserted )
+{
+
+    // Argument check
+    if ( p_dict   == (void *) 0 ) goto no_dictionary;
+    if ( key      == (void *) 0 ) goto no_name;
+    if ( pp_value == (void *) 0 ) goto no_value;
+
+    // Initialized data
+    unsigned long long   h        = p_dict->pfn_hash_function((void *)key, strlen(key));
+    dict_item           *property = 0;
+    bool                 inserted = false;
+    void               **pp_slot  = 0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Find or add the property, with one hash and one walk of the chain
+    pp_slot = dict_find_or_add_locked(p_dict, key, p_value, h, &inserted, &property);
+
+    // Error check
+    if ( pp_slot == (void *) 0 ) goto failed_to_insert;
+
+    // Return the stored value
+    *pp_value = *pp_slot;
+    if ( p_inserted ) *p_inserted = inserted;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_value:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_value\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_update ( dict *const p_dict, const char *const key, void (*pfn_update)(const char *const key, void **const pp_value, bool inserted, void *const p_context), void *const p_context )
+{
+
+    // Argument check
+    if ( p_dict     == (void *) 0 ) goto no_dictionary;
+    if ( key        == (void *) 0 ) goto no_name;
+    if ( pfn_update == (void *) 0 ) goto no_function;
+
+    // Initialized data
+    unsigned long long   h        = p_dict->pfn_hash_function((void *)key, strlen(key));
+    dict_item           *property = 0;
+    bool                 inserted = false;
+    void               **pp_slot  = 0,
+                        *p_value  = 0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Find the property, or add it with a null value
+    pp_slot = dict_find_or_add_locked(p_dict, key, 0, h, &inserted, &property);
+
+    // Error check
+    if ( pp_slot == (void *) 0 ) goto failed_to_insert;
+
+    // Compute the new value in place. Inline values are edited through the pointer
+    p_value = *pp_slot;
+    pfn_update(key, &p_value, inserted, p_context);
+
+    // Store the new value
+    dict_slot_set(p_dict, pp_slot, property, p_value);
+
+    // Record the update
+    if ( inserted == false ) dict_stats_add(p_dict, true);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pfn_update\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_cas ( dict *const p_dict, const char *const key, const void *const expected, void *const desired )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( key    == (void *) 0 ) goto no_name;
+
+    // Inline values are compared and copied through pointers
+    if ( p_dict->value_size && ( expected == (void *) 0 || desired == (void *) 0 ) ) goto no_value;
+
+    // Initialized data
+    unsigned long long h       = p_dict->pfn_hash_function((void *)key, strlen(key));
+    bool               swapped = false;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Compare and swap
+    swapped = dict_cas_locked(p_dict, key, h, expected, desired);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return swapped;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_value:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameters \"expected\" and \"desired\" must point to values for a dictionary with inline values in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_fetch_add ( dict *const p_dict, const char *const key, long long delta, long long *const p_previous )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( key    == (void *) 0 ) goto no_name;
+
+    // Inline counters are long longs
+    if ( p_dict->value_size && p_dict->value_size != sizeof(long long) ) goto wrong_value_size;
+
+    // Initialized data
+    unsigned long long h = p_dict->pfn_hash_function((void *)key, strlen(key));
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Add to the counter
+    if ( dict_fetch_add_locked(p_dict, key, h, delta, p_previous) == 0 ) goto failed_to_insert;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            wrong_value_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Inline values must be %zu bytes to hold a counter in call to function \"%s\"\n", sizeof(long long), __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_add_ttl ( dict *const p_dict, const char *const key, void *const p_value, timestamp ttl )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( key    == (void *) 0 ) goto no_name;
+    if ( ttl    <           1 ) goto no_ttl;
+
+    // Initialized data
+    unsigned long long  h        = p_dict->pfn_hash_function((void *)key, strlen(key));
+    dict_item          *property = 0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Expiring properties live in the hash table
+    if ( p_dict->entries.data == (void *) 0 && dict_promote(p_dict) == 0 ) goto failed_to_insert;
+
+    // Allocate the timer wheel
+    if ( dict_wheel_create(p_dict) == 0 ) goto failed_to_insert;
+
+    // Add or update the property
+    if ( dict_add_locked(p_dict, key, p_value, h) == 0 ) goto failed_to_insert;
+
+    // Find the property
+    property = *dict_item_find(p_dict, key, h, 0);
+
+    // Error check
+    if ( property == (void *) 0 ) goto failed_to_find;
+
+    // Set the expiry, and schedule it
+    DICT_ITEM_TTL(p_dict, property)->expiry = DICT_CLOCK() + ttl;
+    dict_wheel_schedule(p_dict, property, p_dict->p_ext->p_wheel->now);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_ttl:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameter \"ttl\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_find:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to find property \"%s\" after adding it in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t dict_expire ( dict *const p_dict, size_t max_ticks )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    size_t removed = 0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Step the timer wheel
+    removed = dict_expire_locked(p_dict, max_ticks);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return removed;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_expire_start ( dict *const p_dict, timestamp interval, size_t max_ticks )
+{
+
+    // Argument check
+    if ( p_dict   == (void *) 0 ) goto no_dictionary;
+    if ( interval <           1 ) goto no_interval;
+
+    // Initialized data
+    dict_wheel *p_wheel = 0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Expiring properties live in the hash table
+    if ( p_dict->entries.data == (void *) 0 && dict_promote(p_dict) == 0 ) goto failed_to_start;
+
+    // Allocate the timer wheel
+    if ( dict_wheel_create(p_dict) == 0 ) goto failed_to_start;
+
+    // Store the timer wheel
+    p_wheel = p_dict->p_ext->p_wheel;
+
+    // Already running? Checked and set under the lock, so one of two starters wins
+    if ( p_wheel->thread.running ) goto already_running;
+
+    // Store the schedule
+    p_wheel->thread.interval  = interval;
+    p_wheel->thread.max_ticks = max_ticks;
+    p_wheel->thread.stop      = false;
+
+    // Start the thread
+    if ( dict_expire_spawn(p_dict) == 0 ) goto failed_to_start_thread;
+
+    // Store the state
+    p_wheel->thread.running = true;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_interval:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameter \"interval\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_start:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate a timer wheel in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+
+            already_running:
+                #ifndef NDEBUG
+                    log_error("[dict] Expiry thread is already running in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_start_thread:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to start the expiry thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_expire_stop ( dict *const p_dict )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    // Stop the expiry thread
+    if ( p_dict->p_ext->p_wheel ) dict_expire_join(p_dict);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_on_evict ( dict *const p_dict, void (*pfn_evict)(const char *const key, void *const value) )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Store the eviction callback
+    p_dict->pfn_evict = pfn_evict;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_pop ( dict *const p_dict, const char *const key, const void **const pp_value )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( key    == (void *) 0 ) goto no_name;
+
+    // An inline value is freed with its property, so it can not be returned
+    if ( pp_value && p_dict->value_size ) goto inline_value;
+
+    // Initialized data
+    unsigned long long h = p_dict->pfn_hash_function(key, strlen(key));
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Remove the property
+    if ( dict_pop_locked(p_dict, key, h, pp_value) == 0 ) goto no_item;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument error
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            inline_value:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameter \"pp_value\" must be null for a dictionary with inline values in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Failed to find item
+        {
+            no_item:
+                #ifndef NDEBUG
+                    log_warning("[dict] Failed to find property from key \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_foreach ( dict *const p_dict, void (*function)(const void * const, size_t) )
+{
+
+    // Argument check
+    if ( p_dict                == (void *) 0 ) goto no_dictionary;
+    if ( function              == (void *) 0 ) goto no_function;
+    if ( p_dict->entries.count ==          0 ) return 1;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Squeeze out any tombstones
+    dict_iterable_compact(p_dict);
+
+    // Iterate over each hash table item
+    for (size_t i = 0; i < p_dict->entries.count; i++)
+
+        // Call the function on the item
+        function(p_dict->iterable.values[i], i);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_index_enable ( dict *const p_dict, bool enable )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Disable
+    if ( enable == false )
+    {
+
+        // Already disabled?
+        if ( p_dict->p_ext->tree.enabled == false ) goto done;
+
+        // Drop the index. Stale links are reset by the next build
+        p_dict->p_ext->tree.enabled = false;
+        p_dict->p_ext->tree.root    = 0;
+
+        // Inline values can not move, so their properties keep the links, unused until the index is enabled again
+        if ( p_dict->value_size && p_dict->entries.count ) goto done;
+
+        // Drop the links too
+        if ( dict_relayout(p_dict) == 0 ) goto failed_to_drop;
+
+        // Done
+        goto done;
+    }
+
+    // Already enabled?
+    if ( p_dict->p_ext->tree.enabled ) goto done;
+
+    // The index is threaded through the dict_items, so skip the small layout
+    if ( p_dict->entries.data == (void *) 0 && dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Seed the priorities, from the address and the time
+    if ( dict_ext_get(p_dict)->tree.seed == 0 ) p_dict->p_ext->tree.seed = dict_mix64((uint64_t) (uintptr_t) p_dict ^ (uint64_t) timer_high_precision());
+
+    // Set the flag
+    p_dict->p_ext->tree.enabled = true;
+
+    // Index the existing properties, in place if they kept their links
+    if ( p_dict->layout.tree ) dict_tree_build(p_dict);
+
+    // Move them to dict_items with links, which indexes them
+    else if ( dict_relayout(p_dict) == 0 ) goto failed_to_relayout;
+
+    done:
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_relayout:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to make room for the index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clear the flag
+                p_dict->p_ext->tree.enabled = false;
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_drop:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to drop the index links in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // The properties kept their links, so keep the index
+                p_dict->p_ext->tree.enabled = true;
+                dict_tree_build(p_dict);
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_filter_enable ( dict *const p_dict, size_t counters )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    unsigned char *p_counters = 0;
+    size_t         count      = 1;
+
+    // Round the counter count up to a power of two
+    while ( count < counters ) count *= 2;
+
+    // Allocate the counters
+    if ( counters ) p_counters = DICT_REALLOC(0, count);
+
+    // Error checking
+    if ( counters && p_counters == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    if ( p_counters ) memset(p_counters, 0, count);
+
+    // Lock
+    dict_lock(p_dict);
+
+    // No filter to drop or store?
+    if ( p_counters == (void *) 0 && p_dict->p_ext->filter.counters == (void *) 0 ) goto done;
+
+    // The filter is kept with the rare state, so skip the small layout
+    if ( p_dict->entries.data == (void *) 0 && dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Drop the old filter
+    if ( p_dict->p_ext->filter.counters && DICT_REALLOC(p_dict->p_ext->filter.counters, 0) ) goto failed_to_free;
+
+    // Store the new filter
+    dict_ext_get(p_dict)->filter.counters = p_counters;
+    p_dict->p_ext->filter.mask            = count - 1;
+
+    // Count the existing properties
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next)
+            dict_filter_add(p_dict, i_di->hash);
+
+    done:
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                if ( p_counters && DICT_REALLOC(p_counters, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                if ( p_counters && DICT_REALLOC(p_counters, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_range ( dict *const p_dict, const char *const lo, const char *const hi, dict_cursor *const p_cursor )
+{
+
+    // Argument check
+    if ( p_dict   == (void *) 0 ) goto no_dictionary;
+    if ( p_cursor == (void *) 0 ) goto no_cursor;
+
+    // Lock, until the cursor is exhausted or closed
+    dict_lock(p_dict);
+
+    // Error check
+    if ( p_dict->p_ext->tree.enabled == false ) goto no_index;
+
+    // Open the cursor
+    *p_cursor = (dict_cursor)
+    {
+        .p_dict        = p_dict,
+        .p_next        = dict_tree_lower_bound(p_dict, lo),
+        .hi            = hi,
+        .prefix        = 0,
+        .prefix_length = 0
+    };
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_cursor:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            no_index:
+                #ifndef NDEBUG
+                    log_error("[dict] Sorted index is not enabled in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_prefix ( dict *const p_dict, const char *const prefix, dict_cursor *const p_cursor )
+{
+
+    // Argument check
+    if ( prefix == (void *) 0 ) goto no_prefix;
+
+    // Every key with the prefix sorts at or after the prefix
+    if ( dict_range(p_dict, prefix, 0, p_cursor) == 0 ) return 0;
+
+    // Stop at the first key without the prefix
+    p_cursor->prefix        = prefix;
+    p_cursor->prefix_length = strlen(prefix);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_prefix:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"prefix\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool dict_cursor_next ( dict_cursor *const p_cursor, const char **const p_key, const void **const pp_value )
+{
+
+    // Argument check
+    if ( p_cursor         == (void *) 0 ) goto no_cursor;
+    if ( p_cursor->p_dict == (void *) 0 ) return false;
+
+    // Initialized data
+    dict_item *property = p_cursor->p_next;
+
+    // Past the end of the range?
+    if ( property && p_cursor->hi     && strcmp(property->key, p_cursor->hi) >= 0 ) property = 0;
+    if ( property && p_cursor->prefix && strncmp(property->key, p_cursor->prefix, p_cursor->prefix_length) ) property = 0;
+
+    // Exhausted
+    if ( property == (void *) 0 )
+    {
+
+        // Close the cursor
+        dict_cursor_close(p_cursor);
+
+        // Done
+        return false;
+    }
+
+    // Return the property
+    if ( p_key    ) *p_key    = property->key;
+    if ( pp_value ) *pp_value = property->value;
+
+    // Advance
+    p_cursor->p_next = dict_tree_next(p_cursor->p_dict, property);
+
+    // Success
+    return true;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_cursor:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+int dict_cursor_close ( dict_cursor *const p_cursor )
+{
+
+    // Argument check
+    if ( p_cursor == (void *) 0 ) goto no_cursor;
+
+    // Already closed?
+    if ( p_cursor->p_dict == (void *) 0 ) return 1;
+
+    // Unlock
+    mutex_unlock(&p_cursor->p_dict->_lock);
+
+    // Close the cursor
+    p_cursor->p_dict = 0;
+    p_cursor->p_next = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_cursor:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_copy ( dict *const p_dict, dict **const pp_dict )
+{
+
+    // Argument check
+    if ( p_dict  == (void *) 0 ) goto no_dictionary;
+    if ( pp_dict == (void *) 0 ) goto no_target;
+
+    // Initialized data
+    dict *i_dict = 0;
+
+    // Construct a new dictionary of the same size, with the same hash function
+    if ( dict_construct(&i_dict, p_dict->entries.max, p_dict->pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+    // Store values, and evict, the same way
+    i_dict->value_size = p_dict->value_size;
+    i_dict->pfn_evict  = p_dict->pfn_evict;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Rare state? The copy is small, so it allocates its own until its hash table is allocated
+    if ( p_dict->p_ext != &dict_ext_none )
+    {
+
+        // Allocate the rare state
+        if ( dict_ext_get(i_dict) == (void *) 0 ) goto no_mem;
+
+        // Copy the capacity, the budget, the index and the placement
+        i_dict->p_ext->lru.capacity = p_dict->p_ext->lru.capacity;
+        i_dict->p_ext->budget       = p_dict->p_ext->budget;
+        i_dict->p_ext->tree.enabled = p_dict->p_ext->tree.enabled;
+        i_dict->p_ext->tree.seed    = p_dict->p_ext->tree.seed;
+        i_dict->p_ext->placement    = p_dict->p_ext->placement;
+    }
+
+    // Lay out the dict_items the same way
+    i_dict->layout = dict_layout_of(i_dict);
+
+    // Copy the membership filter
+    if ( p_dict->p_ext->filter.counters )
+    {
+
+        // Allocate the counters
+        i_dict->p_ext->filter.counters = DICT_REALLOC(0, p_dict->p_ext->filter.mask + 1);
+
+        // Error checking
+        if ( i_dict->p_ext->filter.counters == (void *) 0 ) goto no_mem;
+
+        // Copy the counters
+        memcpy(i_dict->p_ext->filter.counters, p_dict->p_ext->filter.counters, p_dict->p_ext->filter.mask + 1);
+        i_dict->p_ext->filter.mask = p_dict->p_ext->filter.mask;
+    }
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Copy the inline properties
+        i_dict->small          = p_dict->small;
+        i_dict->entries.count  = p_dict->entries.count;
+        i_dict->iterable.count = p_dict->iterable.count;
+
+        // Done
+        goto done;
+    }
+
+    // Squeeze out any tombstones, so the iterables copy densely
+    dict_iterable_compact(p_dict);
+
+    // Allocate the hash table
+    i_dict->entries.data = dict_array_alloc(i_dict, p_dict->entries.max * sizeof(dict_item *));
+
+    // Error checking
+    if ( i_dict->entries.data == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(i_dict->entries.data, 0, p_dict->entries.max * sizeof(dict_item *));
+
+    // The small properties are free
+    dict_ext_reclaim(i_dict);
+
+    // Allocate the iterables
+    i_dict->iterable.keys   = dict_array_alloc(i_dict, p_dict->iterable.max * sizeof(char *));
+    i_dict->iterable.values = dict_array_alloc(i_dict, p_dict->iterable.max * sizeof(void *));
+    i_dict->iterable.max    = p_dict->iterable.max;
+
+    // Error checking
+    if ( i_dict->iterable.keys   == (void *) 0 ) goto no_mem;
+    if ( i_dict->iterable.values == (void *) 0 ) goto no_mem;
+
+    // Expire the same way
+    if ( p_dict->p_ext->p_wheel )
+    {
+
+        // Allocate the timer wheel
+        if ( dict_wheel_create(i_dict) == 0 ) goto no_mem;
+
+        // Start from the same tick
+        i_dict->p_ext->p_wheel->now = p_dict->p_ext->p_wheel->now;
+    }
+
+    // Clone each chain. The bucket count and hash function match, so each 
+    // property keeps its bucket, its place in the chain, and its iterable index
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+    {
+
+        // Initialized data
+        dict_item **pp_tail = &i_dict->entries.data[i];
+
+        // Walk the list
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next)
+        {
+
+            // Allocate a dict_item
+            dict_item *property = DICT_REALLOC(0, dict_item_size(p_dict));
+
+            // Error checking
+            if ( property == (void *) 0 ) goto no_mem;
+
+            // Copy the property, and its inline value
+            *property      = *i_di;
+            property->next = 0;
+            dict_item_set(p_dict, property, i_di->value);
+
+            // Copy the expiry, and schedule it
+            if ( p_dict->layout.ttl )
+            {
+                *DICT_ITEM_TTL(i_dict, property) = (dict_ttl_links) { .expiry = DICT_ITEM_TTL(p_dict, i_di)->expiry };
+                if ( DICT_ITEM_TTL(i_dict, property)->expiry ) dict_wheel_schedule(i_dict, property, i_dict->p_ext->p_wheel->now);
+            }
+
+            // Point the iterable at the copy of the value
+            i_dict->iterable.values[property->index] = property->value;
+
+            // Append it to the chain
+            *pp_tail = property;
+            pp_tail  = &property->next;
+
+            // Count it, so a failed copy is cleaned up by dict_destroy
+            i_dict->entries.count++;
+        }
+    }
+
+    // Copy the keys
+    memcpy(i_dict->iterable.keys, p_dict->iterable.keys, p_dict->entries.count * sizeof(char *));
+    i_dict->iterable.count = p_dict->entries.count;
+
+    // Rebuild the recency list, from least to most recently used
+    for (dict_item *i_di = p_dict->p_ext->lru.tail; i_di; i_di = DICT_ITEM_LRU(p_dict, i_di)->prev)
+    {
+
+        // Initialized data
+        dict_item *property = *dict_item_find(i_dict, i_di->key, i_di->hash, 0);
+
+        // Every property was copied, but check before linking
+        if ( property ) dict_lru_push(i_dict, property);
+    }
+
+    // Rebuild the sorted index
+    if ( i_dict->p_ext->tree.enabled ) dict_tree_build(i_dict);
+
+    done:
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Return a pointer to the caller
+    *pp_dict = i_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+            no_target:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_warning("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_warning("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                dict_destroy(&i_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_merge ( dict *const p_dict, dict *const p_other, void *(*pfn_conflict)(const char *const key, void *const value, void *const other_value) )
+{
+
+    // Argument check
+    if ( p_dict  == (void *) 0 ) goto no_dictionary;
+    if ( p_other == (void *) 0 ) goto no_other;
+
+    // State check
+    if ( p_dict->value_size != p_other->value_size ) goto mismatched_value_size;
+
+    // Initialized data
+    size_t count  = 0;
+    int    result = 1;
+
+    // Merging a dictionary into itself changes nothing
+    if ( p_dict == p_other ) return 1;
+
+    // Lock both dictionaries, once
+    dict_lock_pair(p_dict, p_other);
+
+    // Visit each of the other dictionary's properties
+    count = dict_visit_begin(p_other);
+
+    // Add each property
+    for (size_t i = 0; i < count && result; i++)
+    {
+
+        // Initialized data
+        char               *key      = 0;
+        void               *value    = 0,
+                           *existing = 0;
+        unsigned long long  h        = 0;
+
+        // Get the property
+        dict_visit_at(p_other, i, &key, &value, &h);
+
+        // Reuse the hash, if the hash functions match
+        h = dict_rehash(p_other, p_dict, key, h);
+
+        // Resolve conflicts
+        if ( pfn_conflict && dict_peek_locked(p_dict, key, h, &existing) ) value = pfn_conflict(key, existing, value);
+
+        // Add or update the property
+        result = dict_add_locked(p_dict, key, value, h);
+    }
+
+    // Done visiting
+    dict_visit_end(p_other);
+
+    // Unlock
+    dict_unlock_pair(p_dict, p_other);
+
+    // Error check
+    if ( result == 0 ) goto failed_to_insert;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_other:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_other\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            mismatched_value_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameters \"p_dict\" and \"p_other\" store values of different sizes in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert a property in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_intersect ( dict *const p_dict, dict *const p_other, dict **const pp_dict, void *(*pfn_conflict)(const char *const key, void *const value, void *const other_value) )
+{
+
+    // Argument check
+    if ( p_dict  == (void *) 0 ) goto no_dictionary;
+    if ( p_other == (void *) 0 ) goto no_other;
+    if ( pp_dict == (void *) 0 ) goto no_target;
+
+    // State check
+    if ( p_dict->value_size != p_other->value_size ) goto mismatched_value_size;
+
+    // Initialized data
+    dict   *i_dict    = 0,
+           *p_visit   = 0,
+           *p_probe   = 0;
+    size_t  count     = 0;
+    int     result    = 1;
+
+    // Construct a dictionary like the first
+    if ( dict_construct_like(p_dict, &i_dict) == 0 ) goto failed_to_construct_dict;
+
+    // Lock both dictionaries, once
+    dict_lock_pair(p_dict, p_other);
+
+    // Visit the smaller side, and probe the larger
+    p_visit = ( p_other->entries.count < p_dict->entries.count ) ? p_other : p_dict;
+    p_probe = ( p_visit == p_dict ) ? p_other : p_dict;
+    count   = dict_visit_begin(p_visit);
+
+    // Keep each property on both sides
+    for (size_t i = 0; i < count && result; i++)
+    {
+
+        // Initialized data
+        char               *key   = 0;
+        void               *value = 0,
+                           *other = 0;
+        unsigned long long  h     = 0;
+
+        // Get the property
+        dict_visit_at(p_visit, i, &key, &value, &h);
+
+        // Is it on the other side?
+        if ( dict_peek_locked(p_probe, key, dict_rehash(p_visit, p_probe, key, h), &other) == false ) continue;
+
+        // Keep the first dictionary's value, unless the caller resolves it
+        if ( p_visit != p_dict )
+        {
+
+            // Initialized data
+            void *swap = value;
+
+            // Swap the sides
+            value = other;
+            other = swap;
+        }
+
+        // Resolve the conflict
+        if ( pfn_conflict ) value = pfn_conflict(key, value, other);
+
+        // Add the property
+        result = dict_add_locked(i_dict, key, value, dict_rehash(p_visit, i_dict, key, h));
+    }
+
+    // Done visiting
+    dict_visit_end(p_visit);
+
+    // Unlock
+    dict_unlock_pair(p_dict, p_other);
+
+    // Error check
+    if ( result == 0 ) goto failed_to_insert;
+
+    // Return a pointer to the caller
+    *pp_dict = i_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_other:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_other\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_target:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            mismatched_value_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameters \"p_dict\" and \"p_other\" store values of different sizes in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert a property in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&i_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_difference ( dict *const p_dict, dict *const p_other, dict **const pp_dict )
+{
+
+    // Argument check
+    if ( p_dict  == (void *) 0 ) goto no_dictionary;
+    if ( p_other == (void *) 0 ) goto no_other;
+    if ( pp_dict == (void *) 0 ) goto no_target;
+
+    // State check
+    if ( p_dict->value_size != p_other->value_size ) goto mismatched_value_size;
+
+    // Initialized data
+    dict   *i_dict = 0;
+    size_t  count  = 0;
+    int     result = 1;
+
+    // Construct a dictionary like the first
+    if ( dict_construct_like(p_dict, &i_dict) == 0 ) goto failed_to_construct_dict;
+
+    // A dictionary minus itself is empty
+    if ( p_dict == p_other ) goto done;
+
+    // Lock both dictionaries, once
+    dict_lock_pair(p_dict, p_other);
+
+    // Every result comes from the first dictionary, so visit it, and probe the other
+    count = dict_visit_begin(p_dict);
+
+    // Keep each property missing from the other side
+    for (size_t i = 0; i < count && result; i++)
+    {
+
+        // Initialized data
+        char               *key   = 0;
+        void               *value = 0,
+                           *other = 0;
+        unsigned long long  h     = 0;
+
+        // Get the property
+        dict_visit_at(p_dict, i, &key, &value, &h);
+
+        // Is it on the other side?
+        if ( dict_peek_locked(p_other, key, dict_rehash(p_dict, p_other, key, h), &other) ) continue;
+
+        // Add the property
+        result = dict_add_locked(i_dict, key, value, h);
+    }
+
+    // Done visiting
+    dict_visit_end(p_dict);
+
+    // Unlock
+    dict_unlock_pair(p_dict, p_other);
+
+    // Error check
+    if ( result == 0 ) goto failed_to_insert;
+
+    done:
+
+    // Return a pointer to the caller
+    *pp_dict = i_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_other:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_other\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_target:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            mismatched_value_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Parameters \"p_dict\" and \"p_other\" store values of different sizes in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert a property in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                dict_destroy(&i_dict);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_batch_construct ( dict_batch **const pp_batch, size_t size )
+{
+
+    // Argument check
+    if ( pp_batch == (void *) 0 ) goto no_batch;
+    if ( size     ==          0 ) goto zero_size;
+
+    // Initialized data
+    dict_batch *p_batch = DICT_REALLOC(0, sizeof(dict_batch));
+
+    // Error checking
+    if ( p_batch == (void *) 0 ) goto no_mem;
+
+    // Allocate "size" operations
+    *p_batch = (dict_batch)
+    {
+        .ops   = DICT_REALLOC(0, size * sizeof(dict_op)),
+        .count = 0,
+        .max   = size
+    };
+
+    // Error checking
+    if ( p_batch->ops == (void *) 0 ) goto no_ops;
+
+    // Return a pointer to the caller
+    *pp_batch = p_batch;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_batch:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_batch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_ops:
+
+                // Free the batch
+                if ( DICT_REALLOC(p_batch, 0) ) return 0;
+
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Order two batch operations by key, so repeated keys are next to each other
+ *
+ * @param p_a pointer to the first operation's pointer
+ * @param p_b pointer to the second operation's pointer
+ *
+ * @return negative, zero or positive, as for qsort
+ */
+static int dict_op_compare ( const void *const p_a, const void *const p_b )
+{
+
+    // Initialized data
+    const dict_op *a = *(const dict_op *const *) p_a,
+                  *b = *(const dict_op *const *) p_b;
+
+    // Order by hash, then by name
+    if ( a->h != b->h ) return ( a->h < b->h ) ? -1 : 1;
+
+    // Done
+    return strcmp(a->key, b->key);
+}
+
+/** !
+ *  Check that a whole batch fits in a dictionary with a capacity or a budget, evicting
+ *  only properties the batch does not name. On success, the properties the batch names
+ *  are moved to the front of the recency list, so eviction passes over them. Caller
+ *  holds the lock.
+ *
+ * @param p_dict dictionary, with a hash table
+ * @param order  the batch's operations, sorted by dict_op_compare
+ * @param count  number of operations
+ *
+ * @return 1 if the batch fits, 0 if it does not
+ */
+static int dict_batch_fits ( dict *const p_dict, const dict_op **const order, size_t count )
+{
+
+    // Initialized data
+    size_t      named     = 0,
+                fresh     = 0,
+                evictable = 0,
+                size      = dict_item_size(p_dict);
+    dict_memory memory    = { 0 };
+
+    // Count each key once, as a property of the dictionary, or as a new one if any operation adds it
+    for (size_t i = 0, j = 0; i < count; i = j)
+    {
+
+        // Initialized data
+        bool add = false;
+
+        // Visit every operation on the key
+        for (j = i; j < count && dict_op_compare(&order[i], &order[j]) == 0; j++)
+            add |= !order[j]->pop;
+
+        // Count the key
+        if ( *dict_item_find(p_dict, order[i]->key, order[i]->h, 0) ) named++;
+        else if ( add ) fresh++;
+    }
+
+    // Eviction passes over the named properties, so the batch's own properties have to fit in the capacity
+    if ( p_dict->p_ext->lru.capacity && named + fresh > p_dict->p_ext->lru.capacity ) return 0;
+
+    // Budget?
+    if ( p_dict->p_ext->budget )
+    {
+
+        // Count the bytes in use
+        dict_memory_locked(p_dict, &memory);
+
+        // Only properties the batch does not name can be evicted
+        if ( p_dict->pfn_evict ) evictable = p_dict->entries.count - named;
+
+        // Does it fit?
+        if ( memory.total + fresh * size > p_dict->p_ext->budget + evictable * size ) return 0;
+    }
+
+    // Move the named properties to the front
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        dict_item *property = *dict_item_find(p_dict, order[i]->key, order[i]->h, 0);
+
+        // Touch it
+        if ( property ) dict_lru_touch(p_dict, property);
+    }
+
+    // Success
+    return 1;
+}
+
+/** !
+ *  Append an operation to a batch
+ *
+ * @param p_batch batch
+ * @param key     the name of the property
+ * @param p_value the value to add, or null pointer
+ * @param pop     remove the property, instead of adding it
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_batch_record ( dict_batch *const p_batch, const char *const key, void *const p_value, bool pop )
+{
+
+    // Grow the operation array?
+    if ( p_batch->count == p_batch->max )
+    {
+
+        // Initialized data
+        dict_op *ops = DICT_REALLOC(p_batch->ops, 2 * p_batch->max * sizeof(dict_op));
+
+        // Error checking
+        if ( ops == (void *) 0 ) goto no_mem;
+
+        // Store the operations, and double the size
+        p_batch->ops  = ops;
+        p_batch->max *= 2;
+    }
+
+    // Append the operation
+    p_batch->ops[p_batch->count++] = (dict_op)
+    {
+        .key     = key,
+        .p_value = p_value,
+        .h       = 0,
+        .pop     = pop
+    };
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_batch_add ( dict_batch *const p_batch, const char *const key, void *const p_value )
+{
+
+    // Argument check
+    if ( p_batch == (void *) 0 ) goto no_batch;
+    if ( key     == (void *) 0 ) goto no_name;
+
+    // Record the add
+    return dict_batch_record(p_batch, key, p_value, false);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_batch:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_batch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_batch_pop ( dict_batch *const p_batch, const char *const key )
+{
+
+    // Argument check
+    if ( p_batch == (void *) 0 ) goto no_batch;
+    if ( key     == (void *) 0 ) goto no_name;
+
+    // Record the pop
+    return dict_batch_record(p_batch, key, 0, true);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_batch:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_batch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_apply_batch ( dict *const p_dict, dict_batch *const p_batch )
+{
+
+    // Argument check
+    if ( p_dict  == (void *) 0 ) goto no_dictionary;
+    if ( p_batch == (void *) 0 ) goto no_batch;
+
+    // Initialized data
+    dict_item      **nodes           = 0;
+    const dict_op  **order           = 0;
+    size_t           adds            = 0,
+                     nodes_allocated = 0,
+                     node_size       = dict_item_size(p_dict);
+    int              result          = 1;
+
+    // Hash every key before taking the lock
+    for (size_t i = 0; i < p_batch->count; i++)
+        p_batch->ops[i].h = p_dict->pfn_hash_function((void *)p_batch->ops[i].key, strlen(p_batch->ops[i].key)),
+        adds += !p_batch->ops[i].pop;
+
+    // Allocate a property for every add before taking the lock, so applying can not fail
+    if ( adds )
+    {
+
+        // Allocate the pool
+        nodes = DICT_REALLOC(0, adds * sizeof(dict_item *));
+
+        // Error checking
+        if ( nodes == (void *) 0 ) goto no_mem;
+
+        // Allocate each property
+        for (; nodes_allocated < adds; nodes_allocated++)
+            if ( ( nodes[nodes_allocated] = DICT_REALLOC(0, node_size) ) == (void *) 0 ) goto no_mem;
+    }
+
+    // A capacity or a budget is set at construction. Sort the keys, to count each one once
+    if ( p_batch->count && ( p_dict->p_ext->lru.capacity || p_dict->p_ext->budget ) )
+    {
+
+        // Allocate the order
+        order = DICT_REALLOC(0, p_batch->count * sizeof(dict_op *));
+
+        // Error checking
+        if ( order == (void *) 0 ) goto no_mem;
+
+        // Sort the operations by key
+        for (size_t i = 0; i < p_batch->count; i++) order[i] = &p_batch->ops[i];
+        qsort(order, p_batch->count, sizeof(dict_op *), dict_op_compare);
+    }
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Outgrow the small dictionary up front
+    if ( p_dict->entries.data == (void *) 0 && p_dict->entries.count + adds > DICT_SMALL_MAX && dict_promote(p_dict) == 0 ) goto failed_to_reserve;
+
+    // Hash table?
+    if ( p_dict->entries.data )
+    {
+
+        // Resize the iterables once, for every add
+        if ( dict_iterable_reserve(p_dict, adds) == 0 ) goto failed_to_reserve;
+
+        // The layout changed since the properties were allocated? Resize them
+        for (size_t i = 0; node_size != dict_item_size(p_dict) && i < adds; i++)
+        {
+
+            // Initialized data
+            dict_item *property = DICT_REALLOC(nodes[i], dict_item_size(p_dict));
+
+            // Error checking
+            if ( property == (void *) 0 ) goto failed_to_reserve;
+
+            // Store the property
+            nodes[i] = property;
+        }
+
+        // The whole batch has to fit, before any of it is applied
+        if ( order && dict_batch_fits(p_dict, order, p_batch->count) == 0 ) goto does_not_fit;
+
+        // Hand the properties to dict_item_insert
+        dict_ext_get(p_dict)->spare.nodes = nodes;
+        p_dict->p_ext->spare.count        = adds;
+    }
+
+    // Apply each operation, in order. Pops of missing properties do nothing
+    for (size_t i = 0; i < p_batch->count && result; i++)
+    {
+
+        // Initialized data
+        const dict_op *p_op = &p_batch->ops[i];
+
+        // Pop
+        if ( p_op->pop ) (void) dict_pop_locked(p_dict, p_op->key, p_op->h, 0);
+
+        // Add or update. The batch fits, and its properties are allocated, so this does not fail
+        else result = dict_add_locked(p_dict, p_op->key, p_op->p_value, p_op->h);
+    }
+
+    // Take back the unused properties
+    if ( p_dict->p_ext->spare.nodes )
+        nodes_allocated            = p_dict->p_ext->spare.count,
+        p_dict->p_ext->spare.nodes = 0,
+        p_dict->p_ext->spare.count = 0;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Free the unused properties. dict_item_insert takes them from the end
+    for (size_t i = 0; i < nodes_allocated; i++)
+        if ( DICT_REALLOC(nodes[i], 0) ) goto failed_to_free;
+
+    // Free the pool
+    if ( nodes && DICT_REALLOC(nodes, 0) ) goto failed_to_free;
+
+    // Free the order
+    if ( order && DICT_REALLOC(order, 0) ) goto failed_to_free;
+
+    // Error check
+    if ( result == 0 ) goto failed_to_apply;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_batch:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_batch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            does_not_fit:
+                #ifndef NDEBUG
+                    log_error("[dict] Batch does not fit in the capacity or the memory budget in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+            failed_to_reserve:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to make room for the batch, which was not applied, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Fall through
+                goto free_nodes;
+
+            failed_to_apply:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to add a property, after applying the operations before it, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+            free_nodes:
+
+                // Free the properties
+                for (size_t i = 0; i < nodes_allocated; i++)
+                    if ( DICT_REALLOC(nodes[i], 0) ) return 0;
+
+                // Free the pool
+                if ( nodes && DICT_REALLOC(nodes, 0) ) return 0;
+
+                // Free the order
+                if ( order && DICT_REALLOC(order, 0) ) return 0;
+
+                // Error
+                return 0;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_batch_clear ( dict_batch *const p_batch )
+{
+
+    // Argument check
+    if ( p_batch == (void *) 0 ) goto no_batch;
+
+    // Forget the operations
+    p_batch->count = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_batch:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_batch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_batch_destroy ( dict_batch **const pp_batch )
+{
+
+    // Argument check
+    if ( pp_batch  == (void *) 0 ) goto no_batch;
+    if ( *pp_batch == (void *) 0 ) goto pp_batch_null;
+
+    // Initialized data
+    dict_batch *p_batch = *pp_batch;
+
+    // No more pointer for end user
+    *pp_batch = (dict_batch *) 0;
+
+    // Free the operations
+    if ( DICT_REALLOC(p_batch->ops, 0) ) goto failed_to_free;
+
+    // Free the batch
+    if ( DICT_REALLOC(p_batch, 0) ) goto failed_to_free;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_batch:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"pp_batch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pp_batch_null:
+                #ifndef NDEBUG
+                    log_warning("[dict] Parameter \"pp_batch\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Free a closed journal, and the keys it recovered
+ *
+ * @param p_journal journal
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_free ( dict_journal *const p_journal )
+{
+
+    // Free the recovered keys
+    for (size_t i = 0; i < p_journal->keys.count; i++)
+        if ( DICT_REALLOC(p_journal->keys.data[i], 0) ) return 0;
+
+    // Free the arrays
+    if ( p_journal->keys.data   && DICT_REALLOC(p_journal->keys.data, 0) ) return 0;
+    if ( p_journal->buffer.data && DICT_REALLOC(p_journal->buffer.data, 0) ) return 0;
+    if ( p_journal->path        && DICT_REALLOC(p_journal->path, 0) ) return 0;
+
+    // Free the journal
+    if ( DICT_REALLOC(p_journal, 0) ) return 0;
+
+    // Success
+    return 1;
+}
+
+#ifdef DICT_POSIX
+/** !
+ *  Apply a log file's records to a dictionary, stopping at the first torn or corrupt
+ *  record. Caller holds the lock, and the dictionary has no journal yet.
+ *
+ * @param p_dict    dictionary
+ * @param p_journal journal, which keeps the keys of added properties
+ * @param data      the log file's contents
+ * @param size      the number of bytes in the log file
+ * @param p_end     return the offset after the last good record
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_replay ( dict *const p_dict, dict_journal *const p_journal, const unsigned char *const data, size_t size, size_t *const p_end )
+{
+
+    // Initialized data
+    size_t  offset       = DICT_JOURNAL_HEADER,
+            value_length = p_dict->value_size;
+    char   *key          = 0;
+
+    // Apply each whole record
+    while ( offset + DICT_JOURNAL_OVERHEAD <= size )
+    {
+
+        // Initialized data
+        const unsigned char *p          = data + offset;
+        uint32_t             key_length = 0,
+                             length     = 0;
+        uint64_t             checksum   = 0;
+        void                *p_value    = 0,
+                           **pp_slot    = 0;
+        dict_item           *property   = 0;
+        bool                 inserted   = false;
+
+        // Decode the lengths
+        memcpy(&key_length, p + 1, 4);
+        memcpy(&length    , p + 5, 4);
+
+        // Torn?
+        if ( (size_t) key_length + length + DICT_JOURNAL_OVERHEAD > size - offset ) break;
+
+        // Corrupt?
+        memcpy(&checksum, p + 9 + key_length + length, 8);
+        if ( checksum != hash_fnv64(p, 9 + (size_t) key_length + length) ) break;
+        if ( p[0] == DICT_JOURNAL_ADD && length != value_length ) break;
+        if ( p[0] != DICT_JOURNAL_ADD && length != 0 ) break;
+
+        // Clear
+        if ( p[0] == DICT_JOURNAL_CLEAR )
+        {
+
+            // Clear the dictionary
+            mutex_unlock(&p_dict->_lock);
+            dict_clear(p_dict);
+            dict_lock(p_dict);
+        }
+
+        // Add or pop
+        else if ( p[0] == DICT_JOURNAL_ADD || p[0] == DICT_JOURNAL_POP )
+        {
+
+            // Copy the key
+            key = DICT_REALLOC(0, (size_t) key_length + 1);
+
+            // Error checking
+            if ( key == (void *) 0 ) goto no_mem;
+
+            // Terminate the key
+            memcpy(key, p + 9, key_length);
+            key[key_length] = '\0';
+
+            // Pop
+            if ( p[0] == DICT_JOURNAL_POP )
+                (void) dict_pop_locked(p_dict, key, p_dict->pfn_hash_function(key, key_length), 0);
+
+            // Add
+            else
+            {
+
+                // Decode the value
+                p_value = (void *) ( p + 9 + key_length );
+
+                // Find or add the property
+                pp_slot = dict_find_or_add_locked(p_dict, key, p_value, p_dict->pfn_hash_function(key, key_length), &inserted, &property);
+
+                // Error check
+                if ( pp_slot == (void *) 0 ) goto failed_to_insert;
+
+                // Update
+                if ( inserted == false ) dict_slot_set(p_dict, pp_slot, property, p_value);
+            }
+
+            // The dictionary borrows a new property's key
+            if ( inserted )
+            {
+
+                // Grow the key array?
+                if ( p_journal->keys.count == p_journal->keys.max )
+                {
+
+                    // Initialized data
+                    size_t   max  = ( p_journal->keys.max ) ? p_journal->keys.max * 2 : 16;
+                    char   **keys = DICT_REALLOC(p_journal->keys.data, max * sizeof(char *));
+
+                    // Error checking
+                    if ( keys == (void *) 0 ) goto no_mem;
+
+                    // Store the keys, and the size
+                    p_journal->keys.data = keys;
+                    p_journal->keys.max  = max;
+                }
+
+                // Keep the key
+                p_journal->keys.data[p_journal->keys.count++]  = key;
+                p_journal->keys.bytes                         += (size_t) key_length + 1;
+            }
+
+            // Free the key
+            else if ( DICT_REALLOC(key, 0) ) goto failed_to_free;
+
+            // Done with the key
+            key = 0;
+        }
+
+        // Unknown
+        else break;
+
+        // Next record
+        offset += (size_t) key_length + length + DICT_JOURNAL_OVERHEAD;
+    }
+
+    // Return the end of the good records
+    *p_end = offset;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( DICT_REALLOC(key, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Rewrite a journal's log file from a snapshot, then copy over the records written
+ *  since the snapshot was taken, and rename the new file over the old one. Caller
+ *  does not hold the lock.
+ *
+ * @param p_dict dictionary with a journal
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_compact_run ( dict *const p_dict )
+{
+
+    // Initialized data
+    dict_journal   *p_journal                   = p_dict->p_ext->p_journal;
+    dict_journal    snapshot                    = { 0 };
+    unsigned char   header[DICT_JOURNAL_HEADER] = { 0 },
+                    chunk[4096]                 = { 0 };
+    uint64_t        value_size                  = p_dict->value_size;
+    size_t          offset                      = 0,
+                    path_length                 = strlen(p_journal->path);
+    char           *path                        = DICT_REALLOC(0, path_length + sizeof(".compact"));
+    int             fd                          = -1;
+
+    // Error checking
+    if ( path == (void *) 0 ) goto no_mem;
+
+    // The new file sits beside the old one, so the rename is atomic
+    memcpy(path, p_journal->path, path_length);
+    memcpy(path + path_length, ".compact", sizeof(".compact"));
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Already compacting?
+    if ( p_journal->compacting ) goto already_compacting;
+
+    // Write the buffered records, so the old file ends where the snapshot starts
+    if ( dict_journal_write(p_journal) == 0 ) goto failed_to_snapshot;
+
+    // Take a snapshot, one add per property
+    for (size_t i = 0; i < p_dict->iterable.count; i++)
+        if ( p_dict->iterable.keys[i] && dict_journal_encode(&snapshot, p_dict->value_size, DICT_JOURNAL_ADD, p_dict->iterable.keys[i], p_dict->iterable.values[i]) == 0 ) goto failed_to_snapshot;
+
+    // Store the end of the snapshot, and the state
+    offset                = p_journal->size;
+    p_journal->compacting = true;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Write the snapshot, without the lock
+    memcpy(header, DICT_JOURNAL_MAGIC, 8);
+    memcpy(header + 8, &value_size, 8);
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if ( fd < 0 ) goto failed_to_write;
+    if ( dict_journal_write_all(fd, header, sizeof(header)) == 0 ) goto failed_to_write;
+    if ( dict_journal_write_all(fd, snapshot.buffer.data, snapshot.buffer.count) == 0 ) goto failed_to_write;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Write the records buffered since the snapshot
+    if ( dict_journal_write(p_journal) == 0 ) goto failed_to_copy;
+
+    // Copy the records written since the snapshot
+    for (size_t i = offset; i < p_journal->size;)
+    {
+
+        // Initialized data
+        size_t  want = ( p_journal->size - i < sizeof(chunk) ) ? p_journal->size - i : sizeof(chunk);
+        ssize_t n    = pread(p_journal->fd, chunk, want, (off_t) i);
+
+        // Error check
+        if ( n <= 0 ) goto failed_to_copy;
+        if ( dict_journal_write_all(fd, chunk, (size_t) n) == 0 ) goto failed_to_copy;
+
+        // Advance
+        i += (size_t) n;
+    }
+
+    // Sync the new file, and replace the old one
+    if ( p_journal->config.sync != DICT_JOURNAL_SYNC_NONE && fsync(fd) ) goto failed_to_copy;
+    if ( rename(path, p_journal->path) ) goto failed_to_copy;
+
+    // Switch to the new file
+    close(p_journal->fd);
+    p_journal->fd         = fd;
+    p_journal->snapshot   = sizeof(header) + snapshot.buffer.count;
+    p_journal->size       = p_journal->snapshot + ( p_journal->size - offset );
+    p_journal->compacting = false;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Clean up
+    if ( snapshot.buffer.data && DICT_REALLOC(snapshot.buffer.data, 0) ) goto failed_to_free;
+    if ( DICT_REALLOC(path, 0) ) goto failed_to_free;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // dict errors
+        {
+            already_compacting:
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                if ( DICT_REALLOC(path, 0) ) return 0;
+
+                // Success
+                return 1;
+
+            failed_to_snapshot:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to snapshot \"%s\" in call to function \"%s\"\n", p_journal->path, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                if ( snapshot.buffer.data && DICT_REALLOC(snapshot.buffer.data, 0) ) return 0;
+                if ( DICT_REALLOC(path, 0) ) return 0;
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+            failed_to_write:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to write \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // The old file is still whole
+                if ( fd >= 0 ) close(fd), unlink(path);
+                dict_lock(p_dict);
+                p_journal->compacting = false;
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                if ( snapshot.buffer.data && DICT_REALLOC(snapshot.buffer.data, 0) ) return 0;
+                if ( DICT_REALLOC(path, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ *  Background journal thread. Writes the buffered records every interval, syncs them
+ *  under DICT_JOURNAL_SYNC_INTERVAL, and compacts the log once it is too large.
+ *
+ * @param p_parameter the dictionary
+ *
+ * @return null pointer
+ */
+static void *dict_journal_thread ( void *p_parameter )
+{
+
+    // Initialized data
+    dict         *p_dict    = p_parameter;
+    dict_journal *p_journal = p_dict->p_ext->p_journal;
+
+    // Lock the thread state
+    pthread_mutex_lock(&p_journal->thread.mutex);
+
+    // Run until stopped
+    while ( p_journal->thread.stop == false )
+    {
+
+        // Initialized data
+        struct timespec deadline = { 0 };
+        long long       ns       = (long long) ( (double) p_journal->config.interval * 1000000000.0 / (double) timer_seconds_divisor() );
+        int             fd       = -1;
+        bool            compact  = false;
+
+        // Compute the deadline
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec  += (time_t) ( ns / 1000000000 );
+        deadline.tv_nsec += (long) ( ns % 1000000000 );
+        if ( deadline.tv_nsec >= 1000000000 ) deadline.tv_sec++, deadline.tv_nsec -= 1000000000;
+
+        // Wait for the interval, or a stop
+        pthread_cond_timedwait(&p_journal->thread.cond, &p_journal->thread.mutex, &deadline);
+
+        // Stopped?
+        if ( p_journal->thread.stop ) break;
+
+        // Unlock the thread state
+        pthread_mutex_unlock(&p_journal->thread.mutex);
+
+        // Write the buffered records. A duplicate descriptor lets the sync run without the lock
+        dict_lock(p_dict);
+        dict_journal_write(p_journal);
+        if ( p_journal->config.sync == DICT_JOURNAL_SYNC_INTERVAL ) fd = dup(p_journal->fd);
+        compact = p_journal->config.compact && p_journal->size > p_journal->config.compact && p_journal->size > 2 * p_journal->snapshot;
+        mutex_unlock(&p_dict->_lock);
+
+        // Sync the log file
+        if ( fd >= 0 ) fsync(fd), close(fd);
+
+        // Compact the log file
+        if ( compact ) dict_journal_compact_run(p_dict);
+
+        // Lock the thread state
+        pthread_mutex_lock(&p_journal->thread.mutex);
+    }
+
+    // Unlock the thread state
+    pthread_mutex_unlock(&p_journal->thread.mutex);
+
+    // Done
+    return 0;
+}
+
+/** !
+ *  Stop a journal's thread, write its buffered records, sync, and close the log file.
+ *  Caller does not hold the lock, and no other thread uses the dictionary.
+ *
+ * @param p_journal journal
+ *
+ * @return 1 on success, 0 on error
+ */
+static int dict_journal_close ( dict_journal *const p_journal )
+{
+
+    // Stop the thread
+    if ( p_journal->thread.running )
+    {
+
+        // Signal the thread
+        pthread_mutex_lock(&p_journal->thread.mutex);
+        p_journal->thread.stop = true;
+        pthread_cond_signal(&p_journal->thread.cond);
+        pthread_mutex_unlock(&p_journal->thread.mutex);
+
+        // Wait for it to exit
+        pthread_join(p_journal->thread.thread, 0);
+
+        // Release the thread state
+        pthread_cond_destroy(&p_journal->thread.cond);
+        pthread_mutex_destroy(&p_journal->thread.mutex);
+
+        // Store the state
+        p_journal->thread.running = false;
+    }
+
+    // Write the buffered records, and sync them
+    dict_journal_write(p_journal);
+    if ( p_journal->config.sync != DICT_JOURNAL_SYNC_NONE && fsync(p_journal->fd) ) p_journal->failed = true;
+
+    // Close the log file
+    close(p_journal->fd);
+
+    // Done
+    return p_journal->failed == false;
+}
+
+int dict_journal_open ( dict *const p_dict, const char *const path, const dict_journal_config *const p_config )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+    if ( path   == (void *) 0 ) goto no_path;
+    if ( p_config && p_config->sync > DICT_JOURNAL_SYNC_INTERVAL ) goto bad_sync;
+
+    // A pointer value would be recovered as a dangling pointer
+    if ( p_dict->value_size == 0 ) goto pointer_values;
+
+    // Initialized data
+    dict_journal  *p_journal   = DICT_REALLOC(0, sizeof(dict_journal));
+    unsigned char *data        = 0;
+    uint64_t       value_size  = p_dict->value_size;
+    size_t         path_length = strlen(path),
+                   end         = DICT_JOURNAL_HEADER;
+    struct stat    st          = { 0 };
+
+    // Error checking
+    if ( p_journal == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_journal, 0, sizeof(dict_journal));
+
+    // Store the policy. By default, each change is written and synced
+    p_journal->fd     = -1;
+    p_journal->config = ( p_config ) ? *p_config : (dict_journal_config) { .sync = DICT_JOURNAL_SYNC_WRITE };
+
+    // Copy the path
+    p_journal->path = DICT_REALLOC(0, path_length + 1);
+    if ( p_journal->path == (void *) 0 ) goto no_mem;
+    memcpy(p_journal->path, path, path_length + 1);
+
+    // Open the log file
+    p_journal->fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if ( p_journal->fd < 0 ) goto failed_to_open;
+    if ( fstat(p_journal->fd, &st) ) goto failed_to_open;
+
+    // A new log file starts with the header
+    if ( st.st_size == 0 )
+    {
+
+        // Initialized data
+        unsigned char header[DICT_JOURNAL_HEADER] = { 0 };
+
+        // Write the header
+        memcpy(header, DICT_JOURNAL_MAGIC, 8);
+        memcpy(header + 8, &value_size, 8);
+        if ( dict_journal_write_all(p_journal->fd, header, sizeof(header)) == 0 ) goto failed_to_open;
+    }
+
+    // Read an existing log file
+    else
+    {
+
+        // Allocate the contents
+        data = DICT_REALLOC(0, (size_t) st.st_size);
+        if ( data == (void *) 0 ) goto no_mem;
+
+        // Read the contents
+        for (size_t i = 0; i < (size_t) st.st_size;)
+        {
+
+            // Initialized data
+            ssize_t n = pread(p_journal->fd, data + i, (size_t) st.st_size - i, (off_t) i);
+
+            // Error check
+            if ( n <= 0 ) goto failed_to_open;
+
+            // Advance
+            i += (size_t) n;
+        }
+
+        // Check the header
+        if ( st.st_size < DICT_JOURNAL_HEADER || memcmp(data, DICT_JOURNAL_MAGIC, 8) || memcmp(data + 8, &value_size, 8) ) goto bad_log;
+    }
+
+    // Lock
+    dict_lock(p_dict);
+
+    // One journal per dictionary
+    if ( p_dict->p_ext->p_journal ) goto already_open;
+
+    // The journal is kept with the rare state, so skip the small layout
+    if ( p_dict->entries.data == (void *) 0 && dict_promote(p_dict) == 0 ) goto failed_to_promote;
+
+    // Replay the log
+    if ( data && dict_journal_replay(p_dict, p_journal, data, (size_t) st.st_size, &end) == 0 ) goto failed_to_replay;
+
+    // Cut off a torn record
+    if ( data && end < (size_t) st.st_size && ftruncate(p_journal->fd, (off_t) end) ) goto failed_to_replay;
+
+    // Store the size
+    p_journal->size     = end;
+    p_journal->snapshot = end;
+
+    // Log every later change
+    dict_ext_get(p_dict)->p_journal = p_journal;
+
+    // Start the thread? It waits for the lock before it touches the dictionary
+    if ( p_journal->config.interval > 0 )
+    {
+
+        // Initialize the thread state
+        pthread_mutex_init(&p_journal->thread.mutex, 0);
+        pthread_cond_init(&p_journal->thread.cond, 0);
+
+        // Start the thread
+        if ( pthread_create(&p_journal->thread.thread, 0, dict_journal_thread, p_dict) ) goto failed_to_create_thread;
+
+        // Store the state
+        p_journal->thread.running = true;
+    }
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Free the contents
+    if ( data && DICT_REALLOC(data, 0) ) goto failed_to_free;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            bad_sync:
+                #ifndef NDEBUG
+                    log_error("[dict] Unknown sync policy provided for parameter \"p_config\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            pointer_values:
+                #ifndef NDEBUG
+                    log_error("[dict] Journals need a dictionary with inline values in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            already_open:
+                #ifndef NDEBUG
+                    log_error("[dict] Dictionary already has a journal in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                goto clean_up;
+
+            failed_to_promote:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to allocate hash table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                goto clean_up;
+
+            failed_to_replay:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to replay \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                goto clean_up;
+
+            bad_log:
+                #ifndef NDEBUG
+                    log_error("[dict] \"%s\" is not a log file for this dictionary in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto clean_up;
+        }
+
+        // Sync errors
+        {
+            failed_to_create_thread:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to start the journal thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Release the thread state
+                pthread_cond_destroy(&p_journal->thread.cond);
+                pthread_mutex_destroy(&p_journal->thread.mutex);
+
+                // Detach the journal
+                p_dict->p_ext->p_journal = 0;
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Clean up
+                goto clean_up;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to open \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto clean_up;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+            clean_up:
+
+                // Release the journal. Keys already replayed stay with the dictionary
+                if ( p_journal && p_journal->fd >= 0 ) close(p_journal->fd);
+                if ( data && DICT_REALLOC(data, 0) ) return 0;
+                if ( p_journal && p_journal->keys.count == 0 ) (void) dict_journal_free(p_journal);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_journal_flush ( dict *const p_dict )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    dict_journal *p_journal = 0;
+    bool          ok        = true;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Store the journal
+    p_journal = p_dict->p_ext->p_journal;
+
+    // Error check
+    if ( p_journal == (void *) 0 ) goto no_journal;
+
+    // Write the buffered records, and sync them
+    ok &= dict_journal_write(p_journal) == 1;
+    if ( ok && p_journal->config.sync != DICT_JOURNAL_SYNC_NONE && fsync(p_journal->fd) ) ok = false, p_journal->failed = true;
+
+    // A failed write leaves a gap in the log
+    ok &= p_journal->failed == false;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Done
+    return ok;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            no_journal:
+                #ifndef NDEBUG
+                    log_error("[dict] Dictionary has no journal in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_journal_compact ( dict *const p_dict )
+{
+
+    // Argument check
+    if ( p_dict            == (void *) 0 ) goto no_dictionary;
+    if ( p_dict->p_ext->p_journal == (void *) 0 ) goto no_journal;
+
+    // Compact the log file
+    return dict_journal_compact_run(p_dict);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_journal:
+                #ifndef NDEBUG
+                    log_error("[dict] Dictionary has no journal in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+#else
+
+/** !
+ *  Close a journal. Without POSIX file I/O, there are no journals
+ *
+ * @param p_journal journal
+ *
+ * @return 0
+ */
+static int dict_journal_close ( dict_journal *const p_journal )
+{
+
+    // Suppress warnings
+    (void) p_journal;
+
+    // Error
+    return 0;
+}
+
+int dict_journal_open ( dict *const p_dict, const char *const path, const dict_journal_config *const p_config )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+    (void) path;
+    (void) p_config;
+
+    #ifndef NDEBUG
+        log_error("[dict] Journals need POSIX file I/O, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int dict_journal_flush ( dict *const p_dict )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+
+    #ifndef NDEBUG
+        log_error("[dict] Journals need POSIX file I/O, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int dict_journal_compact ( dict *const p_dict )
+{
+
+    // Suppress warnings
+    (void) p_dict;
+
+    #ifndef NDEBUG
+        log_error("[dict] Journals need POSIX file I/O, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+#endif
+
+int dict_clear ( dict *const p_dict )
+{
+
+    // Argument check
+    if ( p_dict                == (void *) 0 ) goto no_dictionary;
+    if ( p_dict->entries.count ==          0 ) return 1;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Small dictionaries have no hash table
+    if ( p_dict->entries.data == (void *) 0 ) goto clear_iterables;
+
+    // Iterate over each hash table item
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+    {
+
+        // Is there a valid entry at the index?
+        if (p_dict->entries.data[i])
+        {
+
+            // Initialized data
+            dict_item *i_di = p_dict->entries.data[i];
+
+            // Iterate through linked list
+            while ( i_di )
+            {
+
+                // Initialized data
+                dict_item *n = i_di->next;
+
+                // Free the item
+                if ( DICT_REALLOC(i_di, 0) ) goto failed_to_free;
+
+                // Iterate
+                i_di = n;
+            }
+
+            // Prevent double free
+            p_dict->entries.data[i] = 0;
+        }
+    }
+
+    clear_iterables:
+
+    // Clear iterables
+
+    // If there are no iterables, there is nothing to do
+    if ( p_dict->iterable.keys == 0 && p_dict->iterable.values == 0 ) goto done;
+
+    // Check for a valid pointer
+    if ( p_dict->iterable.keys )
+
+        // Iterate over each key
+        for (size_t i = 0; i < p_dict->iterable.count; i++)
+
+            // Zero set the key
+            p_dict->iterable.keys[i] = 0;
+
+    // Check for a valid pointer
+    if ( p_dict->iterable.values )
+
+        // Iterate over each value
+        for (size_t i = 0; i < p_dict->iterable.count; i++)
+
+            // Zero the value
+            p_dict->iterable.values[i] = 0;
+
+    // Zero the counts
+    p_dict->entries.count  = 0;
+    p_dict->iterable.count = 0;
+
+    // Empty the membership filter
+    if ( p_dict->p_ext->filter.counters ) memset(p_dict->p_ext->filter.counters, 0, p_dict->p_ext->filter.mask + 1);
+
+    // Empty the recency list and the sorted index
+    if ( p_dict->p_ext->lru.capacity ) p_dict->p_ext->lru.head  = p_dict->p_ext->lru.tail = 0;
+    if ( p_dict->p_ext->tree.root    ) p_dict->p_ext->tree.root = 0;
+
+    // Empty the timer wheel
+    if ( p_dict->p_ext->p_wheel ) memset(p_dict->p_ext->p_wheel->slots, 0, sizeof(p_dict->p_ext->p_wheel->slots)), p_dict->p_ext->p_wheel->count = 0;
+
+    // Log the clear
+    dict_journal_record(p_dict, DICT_JOURNAL_CLEAR, 0, 0);
+
+    done:
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_free_clear ( dict *const p_dict, void (*const free_func)(const void *const) )
+{
+
+    // Argument check
+    if ( p_dict                == (void *) 0 ) goto no_dictionary;
+    if ( free_func             == (void *) 0 ) goto no_free_func;
+    if ( p_dict->entries.count ==          0 ) return 1;
+    
+    // Lock
+    dict_lock(p_dict);
+
+    // Small dictionary?
+    if ( p_dict->entries.data == (void *) 0 )
+    {
+
+        // Call the specified deallocator on each value
+        for (size_t i = 0; i < p_dict->entries.count; i++)
+            free_func(p_dict->small.values[i]);
+
+        // Done
+        goto clear_iterables;
+    }
+
+    // Iterate over each hash table item
+    for (size_t i = 0; i < p_dict->entries.max; i++)
+    {
+
+        // Is there a valid entry at the index?
+        if (p_dict->entries.data[i])
+        {
+
+            // Initialzied data
+            dict_item *i_di = p_dict->entries.data[i];
+
+            // Iterate through linked list
+            while ( i_di )
+            {
+                dict_item *n = i_di->next;
+
+                // Call the specified deallocator
+                free_func(i_di->value);
+
+                // Free the item
+                if ( DICT_REALLOC(i_di, 0) ) goto failed_to_free;
+
+                // Iterate
+                i_di = n;
+            }
+
+            // Prevent double free
+            p_dict->entries.data[i] = 0;
+        }
+    }
+
+    clear_iterables:
+
+    // Clear the iterables
+    memset(p_dict->iterable.keys  , 0, p_dict->iterable.count * sizeof(char *));
+    memset(p_dict->iterable.values, 0, p_dict->iterable.count * sizeof(void *));
+
+    // Zero the counts
+    p_dict->entries.count  = 0;
+    p_dict->iterable.count = 0;
+
+    // Empty the membership filter
+    if ( p_dict->p_ext->filter.counters ) memset(p_dict->p_ext->filter.counters, 0, p_dict->p_ext->filter.mask + 1);
+
+    // Empty the recency list and the sorted index
+    if ( p_dict->p_ext->lru.capacity ) p_dict->p_ext->lru.head  = p_dict->p_ext->lru.tail = 0;
+    if ( p_dict->p_ext->tree.root    ) p_dict->p_ext->tree.root = 0;
+
+    // Empty the timer wheel
+    if ( p_dict->p_ext->p_wheel ) memset(p_dict->p_ext->p_wheel->slots, 0, sizeof(p_dict->p_ext->p_wheel->slots)), p_dict->p_ext->p_wheel->count = 0;
+
+    // Log the clear
+    dict_journal_record(p_dict, DICT_JOURNAL_CLEAR, 0, 0);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_free_func:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"free_func\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_destroy ( dict **const pp_dict )
+{
+
+    // Argument check
+    if ( pp_dict  == (void *) 0 ) goto no_dictionary;
+    if ( *pp_dict == (void *) 0 ) goto pp_dict_null;
+
+    // Initialized data
+    dict         *p_dict    = *pp_dict;
+    dict_journal *p_journal = p_dict->p_ext->p_journal;
+    bool          closed    = true;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // No more pointer for end user
+    *pp_dict = (dict *) 0;
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Stop the expiry thread
+    if ( p_dict->p_ext->p_wheel ) dict_expire_join(p_dict);
+
+    // Close the log file, before the clear can be logged
+    if ( p_journal ) closed = dict_journal_close(p_journal), p_dict->p_ext->p_journal = 0;
+
+    // Remove all the dictionary properties
+    if ( dict_clear(p_dict) == 0 ) goto failed_to_clear;
+
+    // Small dictionaries keep their properties inline
+    if ( p_dict->entries.data == (void *) 0 ) goto free_dict;
+
+    // Free the hash table
+    if ( dict_array_free(p_dict, p_dict->entries.data, p_dict->entries.max * sizeof(dict_item *)) == 0 ) goto failed_to_free;
+
+    // Free the iterables
+    // Free the keys
+    if ( p_dict->iterable.keys && dict_array_free(p_dict, p_dict->iterable.keys, p_dict->iterable.max * sizeof(char *)) == 0 ) goto failed_to_free;
+
+    // Free the values
+    if ( p_dict->iterable.values && dict_array_free(p_dict, p_dict->iterable.values, p_dict->iterable.max * sizeof(void *)) == 0 ) goto failed_to_free;
+
+    free_dict:
+
+    // Free the timer wheel
+    if ( p_dict->p_ext->p_wheel && DICT_REALLOC(p_dict->p_ext->p_wheel, 0) ) goto failed_to_free;
+
+    // Free the membership filter
+    if ( p_dict->p_ext->filter.counters && DICT_REALLOC(p_dict->p_ext->filter.counters, 0) ) goto failed_to_free;
+
+    // Free the statistics counters
+    #ifdef BUILD_DICT_WITH_STATS
+        if ( p_dict->stats.p_data && DICT_REALLOC(p_dict->stats.p_data, 0) ) goto failed_to_free;
+    #endif
+
+    // Free the rare state, if the dictionary never outgrew its small properties
+    if ( p_dict->p_ext != &dict_ext_none && p_dict->p_ext != &p_dict->ext && DICT_REALLOC(p_dict->p_ext, 0) ) goto failed_to_free;
+
+    // Destroy the mutex
+    mutex_destroy(&p_dict->_lock);
+
+    // Free the dictionary
+    if ( DICT_REALLOC(p_dict, 0) ) goto failed_to_free;
+
+    // Free the journal, and the keys it recovered
+    if ( p_journal && dict_journal_free(p_journal) == 0 ) goto failed_to_free;
+
+    // Error check
+    if ( closed == false ) goto failed_to_close_journal;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pp_dict_null:
+                #ifndef NDEBUG
+                    log_warning("[dict] Parameter \"pp_dict\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_clear:
+                #ifndef NDEBUG
+                    log_warning("[dict] Call to \"dict_clear\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_close_journal:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to write the journal before closing it in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_stats_enable ( dict *const p_dict, bool enable )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Initialized data
+        dict_statistics *p_data = 0;
+
+        // Allocate the counters before taking the lock, in case this is the first enable
+        if ( enable ) p_data = DICT_REALLOC(0, sizeof(dict_statistics));
+
+        // Error checking
+        if ( enable && p_data == (void *) 0 ) goto no_mem;
+
+        // Zero set
+        if ( p_data ) memset(p_data, 0, sizeof(dict_statistics));
+
+        // Lock
+        dict_lock(p_dict);
+
+        // Keep the counters of an earlier enable
+        if ( p_data && p_dict->stats.p_data == (void *) 0 ) p_dict->stats.p_data = p_data, p_data = 0;
+
+        // Set the flag
+        p_dict->stats.enabled = enable;
+
+        // Unlock
+        mutex_unlock(&p_dict->_lock);
+
+        // Free the unused counters
+        if ( p_data && DICT_REALLOC(p_data, 0) ) goto failed_to_free;
+
+        // Success
+        return 1;
+    #else
+
+        // Suppress warnings
+        (void) enable;
+
+        // Error
+        goto no_stats;
+    #endif
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        #ifndef BUILD_DICT_WITH_STATS
+        {
+            no_stats:
+                #ifndef NDEBUG
+                    log_error("[dict] dict was built without BUILD_DICT_WITH_STATS in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+        #endif
+
+        // Standard library errors
+        #ifdef BUILD_DICT_WITH_STATS
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+        #endif
+    }
+}
+
+int dict_stats ( dict *const p_dict, dict_statistics *const p_statistics )
+{
+
+    // Argument check
+    if ( p_dict       == (void *) 0 ) goto no_dictionary;
+    if ( p_statistics == (void *) 0 ) goto no_statistics;
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Lock
+        dict_lock(p_dict);
+
+        // Copy the counters, or zeros if statistics were never enabled
+        *p_statistics = ( p_dict->stats.p_data ) ? *p_dict->stats.p_data : (dict_statistics) { 0 };
+
+        // Snapshot the shape of the table
+        p_statistics->entries = p_dict->entries.count;
+        p_statistics->buckets = ( p_dict->entries.data ) ? p_dict->entries.max : 0;
+        memset(p_statistics->chain_histogram, 0, sizeof(p_statistics->chain_histogram));
+
+        // Iterate over each bucket
+        for (size_t i = 0; i < p_statistics->buckets; i++)
+        {
+
+            // Initialized data
+            size_t length = 0;
+
+            // Measure the chain
+            for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next) length++;
+
+            // Long chains share the last bucket
+            p_statistics->chain_histogram[( length < DICT_STATS_HISTOGRAM_SIZE ) ? length : DICT_STATS_HISTOGRAM_SIZE - 1]++;
+        }
+
+        // Unlock
+        mutex_unlock(&p_dict->_lock);
+
+        // Success
+        return 1;
+    #else
+
+        // Error
+        goto no_stats;
+    #endif
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_statistics:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_statistics\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        #ifndef BUILD_DICT_WITH_STATS
+        {
+            no_stats:
+                #ifndef NDEBUG
+                    log_error("[dict] dict was built without BUILD_DICT_WITH_STATS in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+        #endif
+    }
+}
+
+int dict_stats_reset ( dict *const p_dict )
+{
+
+    // Argument check
+    if ( p_dict == (void *) 0 ) goto no_dictionary;
+
+    #ifdef BUILD_DICT_WITH_STATS
+
+        // Lock
+        dict_lock(p_dict);
+
+        // Zero the counters
+        if ( p_dict->stats.p_data ) memset(p_dict->stats.p_data, 0, sizeof(dict_statistics));
+
+        // Unlock
+        mutex_unlock(&p_dict->_lock);
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_analyze ( dict *const p_dict, dict_analysis *const p_analysis )
+{
+
+    // Argument check
+    if ( p_dict     == (void *) 0 ) goto no_dictionary;
+    if ( p_analysis == (void *) 0 ) goto no_analysis;
+
+    // Initialized data
+    dict_analysis analysis        = { 0 };
+    double        sum_of_squares  = 0.0,
+                  expected        = 0.0;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Store the shape of the table
+    analysis.entries = p_dict->entries.count;
+    analysis.buckets = ( p_dict->entries.data ) ? p_dict->entries.max : 0;
+
+    // Iterate over each bucket
+    for (size_t i = 0; i < analysis.buckets; i++)
+    {
+
+        // Initialized data
+        size_t length = 0;
+
+        // Measure the chain
+        for (dict_item *i_di = p_dict->entries.data[i]; i_di; i_di = i_di->next) length++;
+
+        // Count empty buckets
+        if ( length == 0 ) analysis.empty_buckets++;
+
+        // Track the longest chain
+        if ( length > analysis.max_chain ) analysis.max_chain = length;
+
+        // Accumulate
+        sum_of_squares += (double) length * (double) length;
+    }
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Small dictionaries have no buckets to analyze
+    if ( analysis.buckets == 0 ) goto done;
+
+    // Compute the ratios
+    analysis.load_factor    = (double) analysis.entries / (double) analysis.buckets;
+    analysis.empty_fraction = (double) analysis.empty_buckets / (double) analysis.buckets;
+
+    // Mean length of the chains a successful lookup can land in
+    if ( analysis.empty_buckets < analysis.buckets )
+        analysis.mean_chain = (double) analysis.entries / (double) ( analysis.buckets - analysis.empty_buckets );
+
+    // Pearson's chi-squared against a uniform spread of entries over buckets
+    if ( analysis.entries )
+    {
+
+        // Each bucket should hold load_factor entries
+        expected = analysis.load_factor;
+
+        // sum((n_i - e)^2 / e) == sum(n_i^2) / e - n
+        analysis.chi_squared = sum_of_squares / expected - (double) analysis.entries;
+
+        // An ideal hash scores about 1, a degenerate one scores about min(entries, buckets)
+        if ( analysis.buckets > 1 )
+            analysis.uniformity = analysis.chi_squared / (double) ( analysis.buckets - 1 );
+    }
+
+    done:
+
+    // Return the analysis to the caller
+    *p_analysis = analysis;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_analysis:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_analysis\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int dict_memory_usage ( dict *const p_dict, dict_memory *const p_memory )
+{
+
+    // Argument check
+    if ( p_dict   == (void *) 0 ) goto no_dictionary;
+    if ( p_memory == (void *) 0 ) goto no_memory;
+
+    // Lock
+    dict_lock(p_dict);
+
+    // Count the bytes
+    dict_memory_locked(p_dict, p_memory);
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_memory:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_memory\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_construct ( sharded_dict **const pp_sharded_dict, size_t shards, size_t size, fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( shards          ==          0 ) goto zero_shards;
+    if ( size            ==          0 ) goto zero_size;
+
+    // Initialized data
+    sharded_dict *p_sharded_dict = 0;
+    size_t        bits           = 0;
+
+    // Round the shard count up to a power of two
+    while ( ( (size_t) 1 << bits ) < shards ) bits++;
+
+    // Allocate a sharded dictionary
+    p_sharded_dict = DICT_REALLOC(0, sizeof(sharded_dict));
+
+    // Error checking
+    if ( p_sharded_dict == (void *) 0 ) goto no_mem;
+
+    // Populate the sharded dictionary
+    *p_sharded_dict = (sharded_dict)
+    {
+        .shards            = 0,
+        .count             = (size_t) 1 << bits,
+        .bits              = bits,
+        .pfn_hash_function = ( pfn_hash_function ) ? pfn_hash_function : dict_hash_kernel()
+    };
+
+    // Allocate the shard list
+    p_sharded_dict->shards = DICT_REALLOC(0, p_sharded_dict->count * sizeof(dict *));
+
+    // Error checking
+    if ( p_sharded_dict->shards == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_sharded_dict->shards, 0, p_sharded_dict->count * sizeof(dict *));
+
+    // Construct each shard with an even share of the hash table entries
+    for (size_t i = 0; i < p_sharded_dict->count; i++)
+        if ( dict_construct(&p_sharded_dict->shards[i], ( size + p_sharded_dict->count - 1 ) / p_sharded_dict->count, p_sharded_dict->pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+    // Return a pointer to the caller
+    *pp_sharded_dict = p_sharded_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_shards:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"shards\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                sharded_dict_destroy(&p_sharded_dict);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_sharded_dict && DICT_REALLOC(p_sharded_dict, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const void *sharded_dict_get ( sharded_dict *const p_sharded_dict, const char *const key )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( key            == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h      = p_sharded_dict->pfn_hash_function(key, strlen(key));
+    dict               *p_dict = p_sharded_dict->shards[sharded_dict_route(p_sharded_dict, h)];
+    void               *val    = 0;
+
+    // Lock the shard
+    dict_lock(p_dict);
+
+    // Find the property
+    dict_get_locked(p_dict, key, h, &val);
+
+    // Unlock the shard
+    mutex_unlock(&p_dict->_lock);
+
+    // Return the value if it exists, otherwise null pointer
+    return val;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t sharded_dict_values ( sharded_dict *const p_sharded_dict, void **const values )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    size_t entry_count = 0;
+
+    // Iterate over each shard
+    for (size_t i = 0; i < p_sharded_dict->count; i++)
+    {
+
+        // Initialized data
+        dict *p_dict = p_sharded_dict->shards[i];
+
+        // Lock the shard
+        dict_lock(p_dict);
+
+        // Squeeze out any tombstones
+        dict_iterable_compact(p_dict);
+
+        // Copy the values after the previous shard's values
+        if ( values ) memcpy(&values[entry_count], p_dict->iterable.values, p_dict->entries.count * sizeof(void *));
+
+        // Accumulate
+        entry_count += p_dict->entries.count;
+
+        // Unlock the shard
+        mutex_unlock(&p_dict->_lock);
+    }
+
+    // Success
+    return ( values ) ? 1 : entry_count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t sharded_dict_keys ( sharded_dict *const p_sharded_dict, const char **const keys )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    size_t entry_count = 0;
+
+    // Iterate over each shard
+    for (size_t i = 0; i < p_sharded_dict->count; i++)
+    {
+
+        // Initialized data
+        dict *p_dict = p_sharded_dict->shards[i];
+
+        // Lock the shard
+        dict_lock(p_dict);
+
+        // Squeeze out any tombstones
+        dict_iterable_compact(p_dict);
+
+        // Copy the keys after the previous shard's keys
+        if ( keys ) memcpy(&keys[entry_count], p_dict->iterable.keys, p_dict->entries.count * sizeof(char *));
+
+        // Accumulate
+        entry_count += p_dict->entries.count;
+
+        // Unlock the shard
+        mutex_unlock(&p_dict->_lock);
+    }
+
+    // Success
+    return ( keys ) ? 1 : entry_count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_add ( sharded_dict *const p_sharded_dict, const char *const key, void *const p_value )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( key            == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h      = p_sharded_dict->pfn_hash_function(key, strlen(key));
+    dict               *p_dict = p_sharded_dict->shards[sharded_dict_route(p_sharded_dict, h)];
+
+    // Lock the shard
+    dict_lock(p_dict);
+
+    // Add or update the property
+    if ( dict_add_locked(p_dict, key, p_value, h) == 0 ) goto failed_to_insert;
+
+    // Unlock the shard
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock the shard
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_cas ( sharded_dict *const p_sharded_dict, const char *const key, const void *const expected, void *const desired )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( key            == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h       = p_sharded_dict->pfn_hash_function(key, strlen(key));
+    dict               *p_dict  = p_sharded_dict->shards[sharded_dict_route(p_sharded_dict, h)];
+    bool                swapped = false;
+
+    // Lock the shard
+    dict_lock(p_dict);
+
+    // Compare and swap
+    swapped = dict_cas_locked(p_dict, key, h, expected, desired);
+
+    // Unlock the shard
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return swapped;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_fetch_add ( sharded_dict *const p_sharded_dict, const char *const key, long long delta, long long *const p_previous )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( key            == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h      = p_sharded_dict->pfn_hash_function(key, strlen(key));
+    dict               *p_dict = p_sharded_dict->shards[sharded_dict_route(p_sharded_dict, h)];
+
+    // Lock the shard
+    dict_lock(p_dict);
+
+    // Add to the counter
+    if ( dict_fetch_add_locked(p_dict, key, h, delta, p_previous) == 0 ) goto failed_to_insert;
+
+    // Unlock the shard
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock the shard
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_pop ( sharded_dict *const p_sharded_dict, const char *const key, const void **const pp_value )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( key            == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h      = p_sharded_dict->pfn_hash_function(key, strlen(key));
+    dict               *p_dict = p_sharded_dict->shards[sharded_dict_route(p_sharded_dict, h)];
+
+    // Lock the shard
+    dict_lock(p_dict);
+
+    // Remove the property
+    if ( dict_pop_locked(p_dict, key, h, pp_value) == 0 ) goto no_item;
+
+    // Unlock the shard
+    mutex_unlock(&p_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Failed to find item
+        {
+            no_item:
+                #ifndef NDEBUG
+                    log_warning("[dict] Failed to find property from key \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock the shard
+                mutex_unlock(&p_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_foreach ( sharded_dict *const p_sharded_dict, void (*function)(const void *const, size_t) )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+    if ( function       == (void *) 0 ) goto no_function;
+
+    // Initialized data
+    size_t offset = 0;
+
+    // Iterate over each shard
+    for (size_t i = 0; i < p_sharded_dict->count; i++)
+    {
+
+        // Initialized data
+        dict *p_dict = p_sharded_dict->shards[i];
+
+        // Lock the shard
+        dict_lock(p_dict);
+
+        // Squeeze out any tombstones
+        dict_iterable_compact(p_dict);
+
+        // Call the function on each value, numbering them across all shards
+        for (size_t j = 0; j < p_dict->entries.count; j++)
+            function(p_dict->iterable.values[j], offset + j);
+
+        // Accumulate
+        offset += p_dict->entries.count;
+
+        // Unlock the shard
+        mutex_unlock(&p_dict->_lock);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_clear ( sharded_dict *const p_sharded_dict )
+{
+
+    // Argument check
+    if ( p_sharded_dict == (void *) 0 ) goto no_dictionary;
+
+    // Clear each shard
+    for (size_t i = 0; i < p_sharded_dict->count; i++)
+        if ( dict_clear(p_sharded_dict->shards[i]) == 0 ) goto failed_to_clear;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_clear:
+                #ifndef NDEBUG
+                    log_warning("[dict] Call to \"dict_clear\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_dict_destroy ( sharded_dict **const pp_sharded_dict )
+{
+
+    // Argument check
+    if ( pp_sharded_dict  == (void *) 0 ) goto no_dictionary;
+    if ( *pp_sharded_dict == (void *) 0 ) goto pp_sharded_dict_null;
+
+    // Initialized data
+    sharded_dict *p_sharded_dict = *pp_sharded_dict;
+
+    // No more pointer for end user
+    *pp_sharded_dict = (sharded_dict *) 0;
+
+    // Destroy each shard
+    for (size_t i = 0; i < p_sharded_dict->count; i++)
+        if ( p_sharded_dict->shards[i] ) dict_destroy(&p_sharded_dict->shards[i]);
+
+    // Free the shard list
+    if ( DICT_REALLOC(p_sharded_dict->shards, 0) ) goto failed_to_free;
+
+    // Free the sharded dictionary
+    if ( DICT_REALLOC(p_sharded_dict, 0) ) goto failed_to_free;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"pp_sharded_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pp_sharded_dict_null:
+                #ifndef NDEBUG
+                    log_warning("[dict] Parameter \"pp_sharded_dict\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int replicated_dict_construct ( replicated_dict **const pp_replicated_dict, size_t size, unsigned long long nodes, fn_hash64 pfn_hash_function )
+{
+
+    // Argument check
+    if ( pp_replicated_dict == (void *) 0 ) goto no_dictionary;
+    if ( size               ==          0 ) goto zero_size;
+
+    // Initialized data
+    replicated_dict *p_replicated_dict = 0;
+    size_t           count             = 0;
+
+    // No nodes means every node this process may allocate from
+    if ( nodes == 0 ) nodes = dict_numa_allowed();
+
+    // Count the nodes
+    for (size_t i = 0; i < DICT_NUMA_NODES_MAX; i++)
+        if ( nodes & ( 1ULL << i ) ) count++;
+
+    // Allocate a replicated dictionary
+    p_replicated_dict = DICT_REALLOC(0, sizeof(replicated_dict));
+
+    // Error checking
+    if ( p_replicated_dict == (void *) 0 ) goto no_mem;
+
+    // Populate the replicated dictionary
+    *p_replicated_dict = (replicated_dict)
+    {
+        .replicas          = DICT_REALLOC(0, count * sizeof(dict_replica)),
+        .count             = count,
+        .log               =
+        {
+            .ops   = DICT_REALLOC(0, DICT_SMALL_MAX * sizeof(dict_op)),
+            .count = 0,
+            .max   = DICT_SMALL_MAX,
+            .base  = 0,
+            .end   = 0
+        },
+        .pfn_hash_function = ( pfn_hash_function ) ? pfn_hash_function : dict_hash_kernel()
+    };
+
+    // Error checking
+    if ( p_replicated_dict->replicas == (void *) 0 ) goto no_mem;
+    if ( p_replicated_dict->log.ops  == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_replicated_dict->replicas, 0, count * sizeof(dict_replica));
+
+    // Create a mutex
+    if ( mutex_create(&p_replicated_dict->_lock) == 0 ) goto failed_to_create_mutex;
+
+    // Nodes without a replica share the others round robin
+    for (size_t i = 0; i < DICT_NUMA_NODES_MAX; i++)
+        p_replicated_dict->node_replica[i] = i % count;
+
+    // Construct a replica bound to each node
+    for (size_t i = 0, j = 0; i < DICT_NUMA_NODES_MAX; i++)
+    {
+
+        // Initialized data
+        dict_placement_config placement = { .pages = DICT_PAGES_DEFAULT, .numa = DICT_NUMA_BIND, .nodes = 1ULL << i };
+
+        // Skip nodes that were not asked for
+        if ( ( nodes & ( 1ULL << i ) ) == 0 ) continue;
+
+        // Construct the replica
+        if ( dict_construct_placed(&p_replicated_dict->replicas[j].p_dict, size, 0, &placement, p_replicated_dict->pfn_hash_function) == 0 ) goto failed_to_construct_dict;
+
+        // The node reads its own replica
+        p_replicated_dict->node_replica[i] = j++;
+    }
+
+    // Return a pointer to the caller
+    *pp_replicated_dict = p_replicated_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct_placed\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                replicated_dict_destroy(&p_replicated_dict);
+
+                // Error
+                return 0;
+        }
+
+        // Sync errors
+        {
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( DICT_REALLOC(p_replicated_dict->log.ops, 0) ) return 0;
+                if ( DICT_REALLOC(p_replicated_dict->replicas, 0) ) return 0;
+                if ( DICT_REALLOC(p_replicated_dict, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_replicated_dict && p_replicated_dict->log.ops && DICT_REALLOC(p_replicated_dict->log.ops, 0) ) return 0;
+                if ( p_replicated_dict && p_replicated_dict->replicas && DICT_REALLOC(p_replicated_dict->replicas, 0) ) return 0;
+                if ( p_replicated_dict && DICT_REALLOC(p_replicated_dict, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const void *replicated_dict_get ( replicated_dict *const p_replicated_dict, const char *const key )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+    if ( key               == (void *) 0 ) goto no_name;
+
+    // Read the calling thread's replica
+    return replicated_dict_get_node(p_replicated_dict, dict_numa_node(), key);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const void *replicated_dict_get_node ( replicated_dict *const p_replicated_dict, size_t node, const char *const key )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+    if ( key               == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h      = p_replicated_dict->pfn_hash_function(key, strlen(key));
+    dict               *p_dict = replicated_dict_local(p_replicated_dict, node)->p_dict;
+    void               *val    = 0;
+
+    // Lock the replica
+    dict_lock(p_dict);
+
+    // Find the property
+    dict_get_locked(p_dict, key, h, &val);
+
+    // Unlock the replica
+    mutex_unlock(&p_dict->_lock);
+
+    // Return the value if it exists, otherwise null pointer
+    return val;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t replicated_dict_values ( replicated_dict *const p_replicated_dict, void **const values )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+
+    // Read the calling thread's replica
+    return dict_values(replicated_dict_local(p_replicated_dict, dict_numa_node())->p_dict, values);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t replicated_dict_keys ( replicated_dict *const p_replicated_dict, const char **const keys )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+
+    // Read the calling thread's replica
+    return dict_keys(replicated_dict_local(p_replicated_dict, dict_numa_node())->p_dict, keys);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int replicated_dict_add ( replicated_dict *const p_replicated_dict, const char *const key, void *const p_value )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+    if ( key               == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h         = p_replicated_dict->pfn_hash_function(key, strlen(key));
+    dict_replica       *p_replica = &p_replicated_dict->replicas[p_replicated_dict->node_replica[dict_numa_node() % DICT_NUMA_NODES_MAX]];
+
+    // Lock
+    mutex_lock(&p_replicated_dict->_lock);
+
+    // Log the property
+    if ( replicated_dict_append(p_replicated_dict, key, p_value, h, false) == 0 ) goto no_mem;
+
+    // Add it to the writer's replica now, and to the others when they next read
+    if ( replicated_dict_catch_up(p_replicated_dict, p_replica) == 0 ) goto failed_to_insert;
+
+    // Trim the log
+    if ( replicated_dict_settle(p_replicated_dict, false) == 0 ) goto failed_to_insert;
+
+    // Unlock
+    mutex_unlock(&p_replicated_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int replicated_dict_pop ( replicated_dict *const p_replicated_dict, const char *const key, const void **const pp_value )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+    if ( key               == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned long long  h         = p_replicated_dict->pfn_hash_function(key, strlen(key));
+    dict_replica       *p_replica = &p_replicated_dict->replicas[p_replicated_dict->node_replica[dict_numa_node() % DICT_NUMA_NODES_MAX]];
+    void               *val       = 0;
+    const char         *stored    = 0;
+    bool                found     = false;
+
+    // Lock
+    mutex_lock(&p_replicated_dict->_lock);
+
+    // Bring the writer's replica up to date
+    if ( replicated_dict_catch_up(p_replicated_dict, p_replica) == 0 ) goto failed_to_remove;
+
+    // Find the property, and the key the replicas store for it
+    dict_lock(p_replica->p_dict);
+    found  = dict_get_locked(p_replica->p_dict, key, h, &val);
+    stored = ( found ) ? dict_key_locked(p_replica->p_dict, key, h) : 0;
+    mutex_unlock(&p_replica->p_dict->_lock);
+
+    // Error check
+    if ( stored == (void *) 0 ) goto no_item;
+
+    // Log the removal with the stored key. The other replicas apply it later,
+    // after the caller's key may be gone, and the stored key lives until then
+    if ( replicated_dict_append(p_replicated_dict, stored, 0, h, true) == 0 ) goto no_mem;
+
+    // Remove it from the writer's replica now, and from the others when they next read
+    if ( replicated_dict_catch_up(p_replicated_dict, p_replica) == 0 ) goto failed_to_remove;
+
+    // Trim the log
+    if ( replicated_dict_settle(p_replicated_dict, false) == 0 ) goto failed_to_remove;
+
+    // Unlock
+    mutex_unlock(&p_replicated_dict->_lock);
+
+    // Return the value
+    if ( pp_value ) *pp_value = val;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_remove:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to apply the log in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+
+        // Failed to find item
+        {
+            no_item:
+                #ifndef NDEBUG
+                    log_warning("[dict] Failed to find property from key \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int replicated_dict_clear ( replicated_dict *const p_replicated_dict )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    dict_replica *p_replica = &p_replicated_dict->replicas[p_replicated_dict->node_replica[dict_numa_node() % DICT_NUMA_NODES_MAX]];
+
+    // Lock
+    mutex_lock(&p_replicated_dict->_lock);
+
+    // Log the clear
+    if ( replicated_dict_append(p_replicated_dict, 0, 0, 0, false) == 0 ) goto no_mem;
+
+    // Clear the writer's replica now, and the others when they next read
+    if ( replicated_dict_catch_up(p_replicated_dict, p_replica) == 0 ) goto failed_to_clear;
+
+    // Trim the log
+    if ( replicated_dict_settle(p_replicated_dict, false) == 0 ) goto failed_to_clear;
+
+    // Unlock
+    mutex_unlock(&p_replicated_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_clear:
+                #ifndef NDEBUG
+                    log_warning("[dict] Call to \"dict_clear\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int replicated_dict_sync ( replicated_dict *const p_replicated_dict )
+{
+
+    // Argument check
+    if ( p_replicated_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    mutex_lock(&p_replicated_dict->_lock);
+
+    // Apply the log to every replica, and empty it
+    if ( replicated_dict_settle(p_replicated_dict, true) == 0 ) goto failed_to_apply;
+
+    // Unlock
+    mutex_unlock(&p_replicated_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_apply:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to apply the log in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_replicated_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int replicated_dict_destroy ( replicated_dict **const pp_replicated_dict )
+{
+
+    // Argument check
+    if ( pp_replicated_dict  == (void *) 0 ) goto no_dictionary;
+    if ( *pp_replicated_dict == (void *) 0 ) goto pp_replicated_dict_null;
+
+    // Initialized data
+    replicated_dict *p_replicated_dict = *pp_replicated_dict;
+
+    // No more pointer for end user
+    *pp_replicated_dict = (replicated_dict *) 0;
+
+    // Destroy each replica
+    for (size_t i = 0; i < p_replicated_dict->count; i++)
+        if ( p_replicated_dict->replicas[i].p_dict ) dict_destroy(&p_replicated_dict->replicas[i].p_dict);
+
+    // Destroy the mutex
+    mutex_destroy(&p_replicated_dict->_lock);
+
+    // Free the log
+    if ( DICT_REALLOC(p_replicated_dict->log.ops, 0) ) goto failed_to_free;
+
+    // Free the replica list
+    if ( DICT_REALLOC(p_replicated_dict->replicas, 0) ) goto failed_to_free;
+
+    // Free the replicated dictionary
+    if ( DICT_REALLOC(p_replicated_dict, 0) ) goto failed_to_free;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"pp_replicated_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pp_replicated_dict_null:
+                #ifndef NDEBUG
+                    log_warning("[dict] Parameter \"pp_replicated_dict\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int int_dict_construct ( int_dict **const pp_int_dict, size_t size )
+{
+
+    // Argument check
+    if ( pp_int_dict == (void *) 0 ) goto no_dictionary;
+    if ( size        ==          0 ) goto zero_size;
+
+    // Initialized data
+    int_dict *p_int_dict = DICT_REALLOC(0, sizeof(int_dict));
+
+    // Error checking
+    if ( p_int_dict == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_int_dict, 0, sizeof(int_dict));
+
+    // Allocate "size" buckets
+    p_int_dict->buckets.data = DICT_REALLOC(0, size * sizeof(size_t));
+    p_int_dict->buckets.max  = size;
+
+    // Error checking
+    if ( p_int_dict->buckets.data == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_int_dict->buckets.data, 0, size * sizeof(size_t));
+
+    // Create a mutex
+    if ( mutex_create(&p_int_dict->_lock) == 0 ) goto failed_to_create_mutex;
+
+    // Return a pointer to the caller
+    *pp_int_dict = p_int_dict;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Sync errors
+        {
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( DICT_REALLOC(p_int_dict->buckets.data, 0) ) return 0;
+                if ( DICT_REALLOC(p_int_dict, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_int_dict && DICT_REALLOC(p_int_dict, 0) ) return 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const void *int_dict_get ( int_dict *const p_int_dict, uint64_t key )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    void   *val  = 0;
+    size_t  link = 0;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Find the property
+    link = *int_dict_table_find(p_int_dict, key);
+
+    // Extract the value
+    val = ( link ) ? p_int_dict->entries.values[link - 1] : (void *) 0;
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Return the value if it exists, otherwise null pointer
+    return val;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t int_dict_values ( int_dict *const p_int_dict, void **const values )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Initialized data
+    size_t entry_count = p_int_dict->entries.count;
+
+    // Counting branch?
+    if ( values == 0 )
+    {
+
+        // Unlock
+        mutex_unlock(&p_int_dict->_lock);
+
+        // Return
+        return entry_count;
+    }
+
+    // Copy memory
+    if ( entry_count ) memcpy(values, p_int_dict->entries.values, entry_count * sizeof(void *));
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t int_dict_keys ( int_dict *const p_int_dict, uint64_t *const keys )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Initialized data
+    size_t entry_count = p_int_dict->entries.count;
+
+    // Counting branch?
+    if ( keys == 0 )
+    {
+
+        // Unlock
+        mutex_unlock(&p_int_dict->_lock);
+
+        // Return
+        return entry_count;
+    }
+
+    // Copy memory
+    if ( entry_count ) memcpy(keys, p_int_dict->entries.keys, entry_count * sizeof(uint64_t));
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int int_dict_add ( int_dict *const p_int_dict, uint64_t key, void *const p_value )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Add or update the property
+    if ( int_dict_table_insert(p_int_dict, key, p_value) == 0 ) goto failed_to_insert;
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_insert:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to insert property %llu in call to function \"%s\"\n", (unsigned long long) key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_int_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int int_dict_pop ( int_dict *const p_int_dict, uint64_t key, const void **const pp_value )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+
+    // Initialized data
+    void *val = 0;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Remove the property
+    if ( int_dict_table_remove(p_int_dict, key, &val) == 0 ) goto no_item;
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Return the value
+    if ( pp_value ) *pp_value = val;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument error
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Failed to find item
+        {
+            no_item:
+                #ifndef NDEBUG
+                    log_warning("[dict] Failed to find property from key %llu in call to function \"%s\"\n", (unsigned long long) key, __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_int_dict->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int int_dict_foreach ( int_dict *const p_int_dict, void (*function)(const void *const, size_t) )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+    if ( function   == (void *) 0 ) goto no_function;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Iterate over each property
+    for (size_t i = 0; i < p_int_dict->entries.count; i++)
+
+        // Call the function on the item
+        function(p_int_dict->entries.values[i], i);
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int int_dict_clear ( int_dict *const p_int_dict )
+{
+
+    // Argument check
+    if ( p_int_dict == (void *) 0 ) goto no_dictionary;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // Empty every bucket. The entry arrays are kept for reuse
+    memset(p_int_dict->buckets.data, 0, p_int_dict->buckets.max * sizeof(size_t));
+
+    // Zero the count
+    p_int_dict->entries.count = 0;
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int int_dict_destroy ( int_dict **const pp_int_dict )
+{
+
+    // Argument check
+    if ( pp_int_dict  == (void *) 0 ) goto no_dictionary;
+    if ( *pp_int_dict == (void *) 0 ) goto pp_int_dict_null;
+
+    // Initialized data
+    int_dict *p_int_dict = *pp_int_dict;
+
+    // Lock
+    mutex_lock(&p_int_dict->_lock);
+
+    // No more pointer for end user
+    *pp_int_dict = (int_dict *) 0;
+
+    // Unlock
+    mutex_unlock(&p_int_dict->_lock);
+
+    // Free the entry arrays
+    if ( p_int_dict->entries.keys   && DICT_REALLOC(p_int_dict->entries.keys  , 0) ) goto failed_to_free;
+    if ( p_int_dict->entries.values && DICT_REALLOC(p_int_dict->entries.values, 0) ) goto failed_to_free;
+    if ( p_int_dict->entries.next   && DICT_REALLOC(p_int_dict->entries.next  , 0) ) goto failed_to_free;
+
+    // Free the hash table
+    if ( DICT_REALLOC(p_int_dict->buckets.data, 0) ) goto failed_to_free;
+
+    // Destroy the mutex
+    mutex_destroy(&p_int_dict->_lock);
+
+    // Free the dictionary
+    if ( DICT_REALLOC(p_int_dict, 0) ) goto failed_to_free;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"pp_int_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pp_int_dict_null:
+                #ifndef NDEBUG
+                    log_warning("[dict] Parameter \"pp_int_dict\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int intern_table_construct ( intern_table **const pp_intern_table, size_t size )
+{
+
+    // Argument check
+    if ( pp_intern_table == (void *) 0 ) goto no_table;
+
+    // Initialized data
+    intern_table *p_intern_table = DICT_REALLOC(0, sizeof(intern_table));
+
+    // Error checking
+    if ( p_intern_table == (void *) 0 ) goto no_mem;
+
+    // Construct the dictionary of canonical strings
+    if ( dict_construct(&p_intern_table->p_dict, size, 0) == 0 ) goto failed_to_construct_dict;
+
+    // Return a pointer to the caller
+    *pp_intern_table = p_intern_table;
 
     // Success
     return 1;
@@ -95,11 +10555,25 @@ int dict_create ( dict **const pp_dict )
 
         // Argument errors
         {
-            no_dictionary:
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"pp_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_construct_dict:
+                #ifndef NDEBUG
+                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Clean up
+                if ( DICT_REALLOC(p_intern_table, 0) ) return 0;
+
                 // Error
                 return 0;
         }
@@ -117,53 +10591,60 @@ int dict_create ( dict **const pp_dict )
     }
 }
 
-int dict_construct ( dict **const pp_dict, size_t size, fn_hash64 pfn_hash_function )
+int intern_table_intern ( intern_table *const p_intern_table, const char *const string, size_t *const p_id, const char **const pp_string )
 {
 
     // Argument check
-    if ( pp_dict == (void *) 0 ) goto no_dictionary;
-    if ( size    ==          0 ) goto zero_size;
+    if ( p_intern_table == (void *) 0 ) goto no_table;
+    if ( string         == (void *) 0 ) goto no_string;
 
     // Initialized data
-    dict *p_dict = 0;
+    dict               *p_dict    = p_intern_table->p_dict;
+    size_t              length    = strlen(string);
+    unsigned long long  h         = p_dict->pfn_hash_function(string, length);
+    void               *p_value   = 0;
+    char               *canonical = 0;
+    size_t              id        = 0;
 
-    // Allocate a dictionary
-    if ( dict_create(pp_dict) == 0 ) goto failed_to_create_dict;
+    // Lock
+    dict_lock(p_dict);
 
-    // Get a pointer to the allocated dictionary
-    p_dict = *pp_dict;
+    // Already interned?
+    if ( dict_get_locked(p_dict, string, h, &p_value) )
+    {
 
-    // Set the count and iterator max
-    p_dict->entries.max  = size;
-    p_dict->iterable.max = 1;
+        // Store the ID
+        id = (size_t) p_value;
 
-    // Allocate "size" number of properties
-    p_dict->entries.data = DICT_REALLOC(0, size * sizeof(dict_item *));
+        // Done
+        goto done;
+    }
 
-    // Allocate key and value lists
-    p_dict->iterable.keys   = DICT_REALLOC(0, sizeof(char *));
-    p_dict->iterable.values = DICT_REALLOC(0, sizeof(void *));
+    // Copy the string
+    canonical = DICT_REALLOC(0, length + 1);
 
-    // Zero set the allocated memory
-    memset(p_dict->entries.data, 0, size * sizeof(dict_item *));
-    memset(p_dict->iterable.keys, 0, sizeof(char *));
-    memset(p_dict->iterable.values, 0, sizeof(char *));
+    // Error checking
+    if ( canonical == (void *) 0 ) goto no_mem;
 
-    // Create a mutex
-    if ( mutex_create(&p_dict->_lock) == 0 ) goto failed_to_create_mutex;
+    // Copy the string
+    memcpy(canonical, string, length + 1);
 
-    // Set the hash function
-    if ( pfn_hash_function ) 
-        p_dict->pfn_hash_function = pfn_hash_function;
+    // Nothing is ever popped, so the next ID is the canonical string's iterable index
+    id = p_dict->entries.count;
 
-    // Default
-    else
-        p_dict->pfn_hash_function = hash_crc64;
+    // Add the canonical string
+    if ( dict_add_locked(p_dict, canonical, (void *) id, h) == 0 ) goto failed_to_insert;
 
-    // Error checking
-    if ( p_dict->entries.data    == (void *) 0 ) goto no_mem;
-    if ( p_dict->iterable.keys   == (void *) 0 ) goto no_mem;
-    if ( p_dict->iterable.values == (void *) 0 ) goto no_mem;
+    done:
+
+    // Return the canonical string
+    if ( pp_string ) *pp_string = p_dict->iterable.keys[id];
+
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
+
+    // Return the ID
+    if ( p_id ) *p_id = id;
 
     // Success
     return 1;
@@ -173,38 +10654,35 @@ int dict_construct ( dict **const pp_dict, size_t size, fn_hash64 pfn_hash_funct
 
         // Argument errors
         {
-            no_dictionary:
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            zero_size:
+            no_string:
                 #ifndef NDEBUG
-                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"string\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-
         }
 
-        // Dictionary errors
+        // dict errors
         {
-            failed_to_create_dict:
+            failed_to_insert:
                 #ifndef NDEBUG
-                    log_error("[dict] Failed to create dictionary in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Failed to insert property \"%s\" in call to function \"%s\"\n", string, __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
 
-            failed_to_create_mutex:
-                #ifndef NDEBUG
-                    log_error("[dict] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+                // Clean up
+                if ( DICT_REALLOC(canonical, 0) ) return 0;
 
                 // Error
                 return 0;
@@ -217,68 +10695,59 @@ int dict_construct ( dict **const pp_dict, size_t size, fn_hash64 pfn_hash_funct
                     log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                mutex_unlock(&p_dict->_lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int dict_from_keys ( dict **const pp_dict, const char **const keys, size_t size )
+int intern_table_find ( intern_table *const p_intern_table, const char *const string, size_t *const p_id )
 {
 
     // Argument check
-    if ( pp_dict == (void *) 0 ) goto no_dictionary;
-    if ( keys    == (void *) 0 ) goto no_keys;
-
-    // TODO: replace with a goto
-    if ( size == 0 ) return 0;
+    if ( p_intern_table == (void *) 0 ) goto no_table;
+    if ( string         == (void *) 0 ) goto no_string;
 
     // Initialized data
-    dict *p_dict = 0;
+    dict               *p_dict  = p_intern_table->p_dict;
+    unsigned long long  h       = p_dict->pfn_hash_function(string, strlen(string));
+    void               *p_value = 0;
+    bool                found   = false;
 
-    // Allocate a dictionary
-    if ( dict_construct(&p_dict, size, 0) == 0 ) goto failed_to_construct_dict;
+    // Lock
+    dict_lock(p_dict);
 
-    // Iterate over each key
-    for (size_t i = 0; keys[i]; i++)
+    // Find the canonical string
+    found = dict_get_locked(p_dict, string, h, &p_value);
 
-        // Add the key to the dictionary
-        dict_add(p_dict, keys[i], (void *)0);
+    // Unlock
+    mutex_unlock(&p_dict->_lock);
 
-    // Return
-    *pp_dict = p_dict;
+    // Return the ID
+    if ( found && p_id ) *p_id = (size_t) p_value;
 
-    // Success
-    return 1;
+    // Done
+    return found;
 
     // Error handling
     {
 
         // Argument errors
         {
-            no_dictionary:
-                #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-
-                // Error
-                return 0;
-
-            no_keys:
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"keys\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-        }
-
-        // dict errors
-        {
-            failed_to_construct_dict:
+            no_string:
                 #ifndef NDEBUG
-                    log_error("[dict] Call to \"dict_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"string\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -287,57 +10756,61 @@ int dict_from_keys ( dict **const pp_dict, const char **const keys, size_t size
     }
 }
 
-const void *dict_get ( dict *const p_dict, const char *const key )
+const char *intern_table_string ( intern_table *const p_intern_table, size_t id )
 {
 
     // Argument check
-    if ( p_dict == (void *) 0 ) goto no_dictionary;
-    if ( key    == (void *) 0 ) goto no_name;
-
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    if ( p_intern_table == (void *) 0 ) goto no_table;
 
     // Initialized data
-    dict_item *ret = p_dict->entries.data[p_dict->pfn_hash_function(key, strlen(key)) % p_dict->entries.max];
-    void      *val = 0;
+    dict       *p_dict = p_intern_table->p_dict;
+    const char *ret    = 0;
 
-    // Walk the list
-    while ( ret != 0 )
-    {
-
-        // Is this the right entry?
-        if ( strcmp(key, ret->key) == 0 )
-            break;
-
-        // Iterate
-        ret = ret->next;
-    }
+    // Lock
+    dict_lock(p_dict);
 
-    // If the walk yielded a property, extract the value of the property, else value = 0
-    val = (ret) ? ret->value : (void *)0;
+    // The ID is the canonical string's iterable index
+    if ( id < p_dict->entries.count ) ret = p_dict->iterable.keys[id];
 
     // Unlock
     mutex_unlock(&p_dict->_lock);
 
-    // Return the value if it exists, otherwise null pointer
-    return val;
+    // Return the canonical string if it exists, otherwise null pointer
+    return ret;
 
     // Error handling
     {
 
         // Argument errors
         {
-            no_dictionary:
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
+        }
+    }
+}
 
-            no_name:
+size_t intern_table_count ( intern_table *const p_intern_table )
+{
+
+    // Argument check
+    if ( p_intern_table == (void *) 0 ) goto no_table;
+
+    // Done
+    return dict_keys(p_intern_table->p_dict, 0);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -346,35 +10819,33 @@ const void *dict_get ( dict *const p_dict, const char *const key )
     }
 }
 
-size_t dict_values ( dict *const p_dict, void **const values )
+int intern_table_memory_usage ( intern_table *const p_intern_table, dict_memory *const p_memory )
 {
 
     // Argument check
-    if ( p_dict == (void *) 0 ) goto no_dictioanry;
-
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    if ( p_intern_table == (void *) 0 ) goto no_table;
+    if ( p_memory       == (void *) 0 ) goto no_memory;
 
     // Initialized data
-    size_t entry_count = p_dict->entries.count;
-
-    // Error check
-    if (values == 0)
-    {
+    dict *p_dict = p_intern_table->p_dict;
 
-        // Unlock
-        mutex_unlock(&p_dict->_lock);
+    // Lock
+    dict_lock(p_dict);
 
-        // Success
-        return entry_count;
-    }
+    // Count the dictionary
+    dict_memory_locked(p_dict, p_memory);
 
-    // Copy memory
-    memcpy(values, p_dict->iterable.values, entry_count * sizeof(void *));
+    // The table owns its canonical strings
+    for (size_t i = 0; i < p_dict->entries.count; i++)
+        p_memory->keys += strlen(p_dict->iterable.keys[i]) + 1;
 
     // Unlock
     mutex_unlock(&p_dict->_lock);
 
+    // Count the table, and the strings
+    p_memory->dict  += sizeof(intern_table);
+    p_memory->total += sizeof(intern_table) + p_memory->keys;
+
     // Success
     return 1;
 
@@ -383,9 +10854,17 @@ size_t dict_values ( dict *const p_dict, void **const values )
 
         // Argument errors
         {
-            no_dictioanry:
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_memory:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_memory\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -394,34 +10873,29 @@ size_t dict_values ( dict *const p_dict, void **const values )
     }
 }
 
-size_t dict_keys ( dict *const p_dict, const char **const keys )
+int intern_table_destroy ( intern_table **const pp_intern_table )
 {
 
     // Argument check
-    if ( p_dict == (void *) 0 ) goto no_dictioanry;
-
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    if ( pp_intern_table  == (void *) 0 ) goto no_table;
+    if ( *pp_intern_table == (void *) 0 ) goto pp_intern_table_null;
 
     // Initialized data
-    size_t entry_count = p_dict->entries.count;
-
-    // Counting branch?
-    if ( keys == 0 )
-    {
+    intern_table *p_intern_table = *pp_intern_table;
+    dict         *p_dict         = p_intern_table->p_dict;
 
-        // Unlock
-        mutex_unlock(&p_dict->_lock);
+    // No more pointer for end user
+    *pp_intern_table = (intern_table *) 0;
 
-        // Return
-        return entry_count;
-    }
+    // Free the canonical strings
+    for (size_t i = 0; i < p_dict->entries.count; i++)
+        if ( DICT_REALLOC(p_dict->iterable.keys[i], 0) ) goto failed_to_free;
 
-    // Copy memory
-    memcpy(keys, p_dict->iterable.keys, entry_count * sizeof(char *));
+    // Destroy the dictionary
+    if ( dict_destroy(&p_dict) == 0 ) goto failed_to_destroy_dict;
 
-    // Unlock
-    mutex_unlock(&p_dict->_lock);
+    // Free the table
+    if ( DICT_REALLOC(p_intern_table, 0) ) goto failed_to_free;
 
     // Success
     return 1;
@@ -431,102 +10905,132 @@ size_t dict_keys ( dict *const p_dict, const char **const keys )
 
         // Argument errors
         {
-            no_dictioanry:
+            no_table:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_warning("[dict] Null pointer provided for parameter \"pp_intern_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pp_intern_table_null:
+                #ifndef NDEBUG
+                    log_warning("[dict] Parameter \"pp_intern_table\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // dict errors
+        {
+            failed_to_destroy_dict:
+                #ifndef NDEBUG
+                    log_warning("[dict] Call to \"dict_destroy\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
+        // Standard library errors
+        {
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
     }
 }
 
-int dict_add ( dict *const p_dict, const char *const key,   void * const p_value )
+#ifdef DICT_POSIX
+int shm_dict_create ( shm_dict **const pp_shm_dict, const char *const name, size_t size, size_t bytes )
 {
 
     // Argument check
-    if ( p_dict == (void *) 0 ) goto no_dictionary;
-    if ( key    == (void *) 0 ) goto no_name;
-
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    if ( pp_shm_dict == (void *) 0 ) goto no_dictionary;
+    if ( size        ==          0 ) goto zero_size;
 
     // Initialized data
-    unsigned long long  h        = p_dict->pfn_hash_function((void *)key, strlen(key));
-    dict_item          *property = p_dict->entries.data[h % p_dict->entries.max];
-
-    // Find the key in the hash table
-
-    // Walk the linked list
-    for (; property != 0; property = property->next)
+    shm_dict             *p_shm_dict = 0;
+    shm_dict_header      *p_header   = MAP_FAILED;
+    pthread_rwlockattr_t  attr;
+    uint64_t              buckets    = ( sizeof(shm_dict_header) + SHM_DICT_ALIGN - 1 ) & ~( SHM_DICT_ALIGN - 1 ),
+                          arena      = 0;
 
-        // Is this the correct entry?
-        if ( strcmp(key, property->key) == 0 )
+    // The hash table and the region must be addressable, and fit in an off_t
+    if ( size > ( INT64_MAX - buckets ) / sizeof(uint64_t) || (uint64_t) bytes > INT64_MAX ) goto too_large;
 
-            // Stop looking
-            break;
-
-    // Make a new property
-    if ( property == (void *) 0 )
-    {
+    // Compute the offset of the arena
+    arena = buckets + size * sizeof(uint64_t);
 
-        // Resize iterable max?
-        if ( p_dict->entries.count >= p_dict->iterable.max )
-        {
+    // The region must hold the header and the hash table
+    if ( bytes < arena ) goto too_small;
 
-            // Double the size
-            p_dict->iterable.max *= 2;
+    // Allocate the handle
+    p_shm_dict = DICT_REALLOC(0, sizeof(shm_dict));
 
-            // Reallocate iterable arrays
-            p_dict->iterable.keys   = DICT_REALLOC(p_dict->iterable.keys  , p_dict->iterable.max * sizeof(char *));
-            p_dict->iterable.values = DICT_REALLOC(p_dict->iterable.values, p_dict->iterable.max * sizeof(void *));
+    // Error checking
+    if ( p_shm_dict == (void *) 0 ) goto no_mem;
 
-            // Error checking
-            if ( p_dict->iterable.keys   == (void *) 0 ) goto no_mem;
-            if ( p_dict->iterable.values == (void *) 0 ) goto no_mem;
-        }
+    // Store the size
+    p_shm_dict->bytes = bytes;
+    p_shm_dict->fd    = -1;
 
-        // Allocate a new dict_item
-        property = DICT_REALLOC(0, sizeof(dict_item));
+    // Named region?
+    if ( name )
+    {
 
-        // Zero
-        memset(property, 0, sizeof(dict_item));
+        // Create the shared memory object. It must not exist yet
+        p_shm_dict->fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
 
         // Error checking
-        if ( property == (void *) 0 ) goto no_mem;
+        if ( p_shm_dict->fd < 0 ) goto failed_to_open;
 
-        // Set the property
-        property->key = (char *) key;
-        property->value = p_value;
+        // Size the object. The new bytes read as zero
+        if ( ftruncate(p_shm_dict->fd, (off_t) bytes) ) goto failed_to_map;
+    }
+
+    // Map the region. An anonymous region is shared with processes forked after this call
+    p_header = mmap(0, bytes, PROT_READ | PROT_WRITE, ( name ) ? MAP_SHARED : MAP_SHARED | MAP_ANONYMOUS, p_shm_dict->fd, 0);
 
-        // Insert the hash
-        property->next = p_dict->entries.data[(h % p_dict->entries.max)];
-        property->index = p_dict->entries.count;
-        p_dict->entries.data[(h % p_dict->entries.max)] = property;
+    // Error checking
+    if ( p_header == MAP_FAILED ) goto failed_to_map;
+
+    // Lay out the region
+    p_header->layout         = sizeof(shm_dict_header);
+    p_header->bytes          = bytes;
+    p_header->buckets.offset = buckets;
+    p_header->buckets.max    = size;
+    p_header->arena          = arena;
+    p_header->used           = arena;
+
+    // Create a process shared lock
+    if ( pthread_rwlockattr_init(&attr) ) goto failed_to_create_lock;
+    if ( pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) || pthread_rwlock_init(&p_header->lock, &attr) )
+    {
 
-        // Update the iterables
-        p_dict->iterable.keys[p_dict->entries.count] = (char *) key;
-        p_dict->iterable.values[p_dict->entries.count] = p_value;
+        // Clean up
+        pthread_rwlockattr_destroy(&attr);
 
-        // Increment the entry counter
-        p_dict->entries.count++;
+        // Error
+        goto failed_to_create_lock;
     }
 
-    // Update an existing property
-    else
-    {
+    // Clean up
+    pthread_rwlockattr_destroy(&attr);
 
-        // Update the property
-        property->value = p_value;
+    // Publish the region. A process that attaches sees the magic only after everything above
+    __atomic_store_n(&p_header->magic, SHM_DICT_MAGIC, __ATOMIC_RELEASE);
 
-        // Update the iterable
-        p_dict->iterable.values[property->index] = property->value;
-    }
+    // Store the mapping
+    p_shm_dict->p_header = p_header;
 
-    // Unlock
-    mutex_unlock(&p_dict->_lock);
+    // Return a pointer to the caller
+    *pp_shm_dict = p_shm_dict;
 
     // Success
     return 1;
@@ -534,25 +11038,52 @@ int dict_add ( dict *const p_dict, const char *const key,   void * const p_value
     // Error handling
     {
 
-        // Argument errors
-        {
-            no_dictionary:
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"pp_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            zero_size:
+                #ifndef NDEBUG
+                    log_error("[dict] Zero provided for parameter \"size\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            too_small:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Parameter \"bytes\" is too small for %zu buckets in call to function \"%s\"\n", size, __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            no_name:
+            too_large:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Parameter \"size\" or \"bytes\" is too large for a region in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
+        // Sync errors
+        {
+            failed_to_create_lock:
+                #ifndef NDEBUG
+                    log_error("[dict] Failed to create a process shared lock in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto clean_up;
+        }
+
         // Standard library errors
         {
             no_mem:
@@ -560,145 +11091,90 @@ int dict_add ( dict *const p_dict, const char *const key,   void * const p_value
                     log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Unlock
-                mutex_unlock(&p_dict->_lock);
-
                 // Error
                 return 0;
-        }
-    }
-}
-
-int dict_pop ( dict *const p_dict, const char *const key, const void **const pp_value )
-{
-
-    // Argument check
-    if ( p_dict == (void *) 0 ) goto no_dictionary;
-    if ( key    == (void *) 0 ) goto no_name;
-
-    // Lock
-    mutex_lock(&p_dict->_lock);
-
-    // Initialized data
-    unsigned long long  h = p_dict->pfn_hash_function(key, strlen(key));
-    dict_item          *i = p_dict->entries.data[h % p_dict->entries.max],
-                       *k = 0;
-
-    // Error check
-    if ( i == 0 ) goto no_item;
-
-    // Check the head
-    if ( strcmp(key, i->key) == 0 )
-    {
 
-        // Initialized data
-        dict_item *j = i->next;
+            failed_to_open:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to create shared memory object \"%s\" in call to function \"%s\"\n", name, __FUNCTION__);
+                #endif
 
-        // Get a dict item
-        i = p_dict->entries.data[h % p_dict->entries.max];
+                // Clean up
+                goto clean_up;
 
-        p_dict->entries.data[h % p_dict->entries.max] = j;
+            failed_to_map:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to map %zu bytes of shared memory in call to function \"%s\"\n", bytes, __FUNCTION__);
+                #endif
 
-        goto free_item;
-    }
+            clean_up:
 
-    while (i->next)
-    {
+                // Release the region, and the name this call created
+                if ( p_header != MAP_FAILED ) munmap(p_header, bytes);
+                if ( p_shm_dict->fd >= 0 ) close(p_shm_dict->fd), shm_unlink(name);
+                if ( DICT_REALLOC(p_shm_dict, 0) ) return 0;
 
-        if (strcmp(key, i->next->key) == 0)
-        {
-            dict_item *j = i->next->next;
-            k=i->next;
-            // Stitch up the linked list
-            i->next = j;
-            goto free_item;
+                // Error
+                return 0;
         }
-
-        i = i->next;
     }
+}
 
-    goto no_item;
-
-    free_item:
-
-    if ( strcmp(key, i->key) == 0 )
-        k=i;
-
-    // Return the value
-    if (pp_value)
-        *pp_value = k->value;
-
-    // Clean up the iterables
-    {
-
-        // Initialized data
-        size_t              idx       = k->index;
-        char               *swap_key  = p_dict->iterable.keys[p_dict->entries.count-1];
-        unsigned long long  swap_hash = p_dict->pfn_hash_function(swap_key, strlen(swap_key));
-        dict_item          *swap_item = p_dict->entries.data[swap_hash % p_dict->entries.max];
-
-        if ( swap_key == (void *) 0 ) goto no_swap_key;
+int shm_dict_open ( shm_dict **const pp_shm_dict, const char *const name )
+{
 
-        if (idx == p_dict->entries.count-1)
-        {
-            p_dict->iterable.keys[p_dict->entries.count-1] = 0;
-            p_dict->iterable.values[p_dict->entries.count-1] = 0;
-            goto done;
-        }
+    // Argument check
+    if ( pp_shm_dict == (void *) 0 ) goto no_dictionary;
+    if ( name        == (void *) 0 ) goto no_name;
 
-        // Clean up key iterable
-        p_dict->iterable.keys[idx] = p_dict->iterable.keys[p_dict->entries.count-1];
-        p_dict->iterable.keys[p_dict->entries.count-1] = 0;
+    // Initialized data
+    shm_dict        *p_shm_dict = DICT_REALLOC(0, sizeof(shm_dict));
+    shm_dict_header *p_header   = MAP_FAILED;
+    struct stat      st;
 
-        // Clean up value iterable
-        p_dict->iterable.values[idx] = p_dict->iterable.values[p_dict->entries.count-1];
-        p_dict->iterable.values[p_dict->entries.count-1] = 0;
+    // Error checking
+    if ( p_shm_dict == (void *) 0 ) goto no_mem;
 
-        if ( swap_item )
-            swap_item->index = idx;
-    }
+    // Open the shared memory object
+    p_shm_dict->fd = shm_open(name, O_RDWR, 0);
 
-    done:
+    // Error checking
+    if ( p_shm_dict->fd < 0 ) goto failed_to_open;
 
-    // Free the pop'd dict_item
-    if ( DICT_REALLOC(k, 0) ) goto failed_to_free;
+    // Measure the region
+    if ( fstat(p_shm_dict->fd, &st) ) goto failed_to_open;
+    if ( (size_t) st.st_size < sizeof(shm_dict_header) ) goto bad_region;
 
-    // Decrement entries
-    p_dict->entries.count--;
+    // Store the size
+    p_shm_dict->bytes = (size_t) st.st_size;
 
-    // Resize iterable max?
-    if ( p_dict->entries.count > p_dict->iterable.max / 2)
-    {
+    // Map the region. Readers still write the lock, so the mapping is writable
+    p_header = mmap(0, p_shm_dict->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, p_shm_dict->fd, 0);
 
-        // Double the size
-        p_dict->iterable.max /= 2;
+    // Error checking
+    if ( p_header == MAP_FAILED ) goto failed_to_map;
 
-        // Reallocate iterable arrays
-        p_dict->iterable.keys   = DICT_REALLOC(p_dict->iterable.keys  , p_dict->iterable.max * sizeof(void *));
-        p_dict->iterable.values = DICT_REALLOC(p_dict->iterable.values, p_dict->iterable.max * sizeof(void *));
+    // Is the region a published dictionary, laid out by this build?
+    if ( __atomic_load_n(&p_header->magic, __ATOMIC_ACQUIRE) != SHM_DICT_MAGIC ) goto bad_region;
+    if ( p_header->layout != sizeof(shm_dict_header) || p_header->bytes != p_shm_dict->bytes ) goto bad_region;
 
-        // Error checking
-        if ( p_dict->iterable.keys == (void *) 0 ) goto no_mem;
-        if ( p_dict->iterable.keys == (void *) 0 ) goto no_mem;
-    }
+    // Store the mapping
+    p_shm_dict->p_header = p_header;
 
-    // Unlock
-    mutex_unlock(&p_dict->_lock);
+    // Return a pointer to the caller
+    *pp_shm_dict = p_shm_dict;
 
     // Success
     return 1;
 
-    no_swap_key:
-    return 0;
-
     // Error handling
     {
 
-        // Argument error
+        // Argument errors
         {
             no_dictionary:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"pp_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -706,73 +11182,98 @@ int dict_pop ( dict *const p_dict, const char *const key, const void **const pp_
 
             no_name:
                 #ifndef NDEBUG
-                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
-        // Failed to find item
+        // dict errors
         {
-            no_item:
+            bad_region:
                 #ifndef NDEBUG
-                    log_warning("[dict] Failed to find property from key \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
+                    log_error("[dict] \"%s\" is not a shared memory dictionary in call to function \"%s\"\n", name, __FUNCTION__);
                 #endif
 
-                // Unlock
-                mutex_unlock(&p_dict->_lock);
-
-                // Error
-                return 0;
+                // Clean up
+                goto clean_up;
         }
 
         // Standard library errors
         {
             no_mem:
                 #ifndef NDEBUG
-                    log_warning("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Unlock
-                mutex_unlock(&p_dict->_lock);
-
                 // Error
                 return 0;
-                
-            failed_to_free:
+
+            failed_to_open:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[Standard library] Failed to open shared memory object \"%s\" in call to function \"%s\"\n", name, __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto clean_up;
+
+            failed_to_map:
+                #ifndef NDEBUG
+                    log_error("[Standard library] Failed to map shared memory object \"%s\" in call to function \"%s\"\n", name, __FUNCTION__);
                 #endif
 
+            clean_up:
+
+                // Release the region
+                if ( p_header != MAP_FAILED ) munmap(p_header, p_shm_dict->bytes);
+                if ( p_shm_dict->fd >= 0 ) close(p_shm_dict->fd);
+                if ( DICT_REALLOC(p_shm_dict, 0) ) return 0;
+
                 // Error
                 return 0;
         }
     }
 }
 
-int dict_foreach ( dict *const p_dict, void (*function)(const void * const, size_t) )
+const void *shm_dict_get ( shm_dict *const p_shm_dict, const char *const key, size_t *const p_size )
 {
 
     // Argument check
-    if ( p_dict                == (void *) 0 ) goto no_dictionary;
-    if ( function              == (void *) 0 ) goto no_function;
-    if ( p_dict->entries.count ==          0 ) return 1;
+    if ( p_shm_dict == (void *) 0 ) goto no_dictionary;
+    if ( key        == (void *) 0 ) goto no_key;
 
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    // Initialized data
+    shm_dict_header    *p_header = p_shm_dict->p_header;
+    unsigned long long  h        = dict_hash(key, strlen(key));
+    const void         *val      = 0;
+    uint64_t            link     = 0;
 
-    // Iterate over each hash table item
-    for (size_t i = 0; i < p_dict->entries.count; i++)
+    // Read lock
+    pthread_rwlock_rdlock(&p_header->lock);
 
-        // Call the function on the item
-        function(p_dict->iterable.values[i], i);
+    // Find the property
+    link = *shm_dict_find(p_header, key, h);
+
+    // Found?
+    if ( link )
+    {
+
+        // Initialized data
+        const shm_dict_node *p_node = SHM_DICT_AT(p_header, link);
+
+        // Extract the value
+        val = SHM_DICT_AT(p_header, p_node->value);
+
+        // Return the size
+        if ( p_size ) *p_size = p_node->size;
+    }
 
     // Unlock
-    mutex_unlock(&p_dict->_lock);
+    pthread_rwlock_unlock(&p_header->lock);
 
-    // Success
-    return 1;
+    // Return the value if it exists, otherwise null pointer
+    return val;
 
     // Error handling
     {
@@ -781,15 +11282,15 @@ int dict_foreach ( dict *const p_dict, void (*function)(const void * const, size
         {
             no_dictionary:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            no_function:
+            no_key:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -798,47 +11299,49 @@ int dict_foreach ( dict *const p_dict, void (*function)(const void * const, size
     }
 }
 
-int dict_copy ( dict *const p_dict, dict **const pp_dict )
+size_t shm_dict_values ( shm_dict *const p_shm_dict, const void **const values )
 {
 
     // Argument check
-    if ( p_dict  == (void *) 0 ) goto no_dictionary;
-    if ( pp_dict == (void *) 0 ) goto no_target;
+    if ( p_shm_dict == (void *) 0 ) goto no_dictionary;
 
     // Initialized data
-    dict  *i_dict = 0;
-    const char **keys   = DICT_REALLOC(0, p_dict->entries.max * sizeof(char *));
-    void **values = DICT_REALLOC(0, p_dict->entries.max * sizeof(void *));
+    shm_dict_header *p_header    = p_shm_dict->p_header;
+    size_t           entry_count = 0;
 
-    // Error checking
-    if ( keys   == (void *) 0 ) goto no_mem;
-    if ( values == (void *) 0 ) goto no_mem;
+    // Read lock
+    pthread_rwlock_rdlock(&p_header->lock);
 
-    // Zero set
-    memset(keys  , 0, p_dict->entries.max * sizeof(char *));
-    memset(values, 0, p_dict->entries.max * sizeof(char *));
+    // Store the count
+    entry_count = p_header->buckets.count;
 
-    // Construct a new dictionary of the same size
-    dict_construct(pp_dict, p_dict->entries.max, 0);
+    // Counting branch?
+    if ( values == 0 )
+    {
 
-    // Get the keys and values out of the first dictionary
-    dict_keys(p_dict, keys);
-    dict_values(p_dict, values);
+        // Unlock
+        pthread_rwlock_unlock(&p_header->lock);
 
-    // Iterate over each value
-    for (size_t i = 0; i < p_dict->entries.count && keys[i]; i++)
+        // Return
+        return entry_count;
+    }
 
-        // Insert each value
-        dict_add(*pp_dict, keys[i], values[i]);
+    // Copy each live value, in insertion order
+    for (size_t i = 0, j = 0; i < p_header->iterable.count; i++)
+    {
 
-    // Free the lists
-    // Free the keys
-    if ( DICT_REALLOC(keys, 0) ) goto failed_to_free;
+        // Initialized data
+        uint64_t link = ( (const uint64_t *) SHM_DICT_AT(p_header, p_header->iterable.offset) )[i];
 
-    // Free the values
-    if ( DICT_REALLOC(values, 0) ) goto failed_to_free;
+        // Skip tombstones
+        if ( link == 0 ) continue;
 
-    *pp_dict = i_dict;
+        // Store the value
+        values[j++] = SHM_DICT_AT(p_header, ( (const shm_dict_node *) SHM_DICT_AT(p_header, link) )->value);
+    }
+
+    // Unlock
+    pthread_rwlock_unlock(&p_header->lock);
 
     // Success
     return 1;
@@ -850,39 +11353,70 @@ int dict_copy ( dict *const p_dict, dict **const pp_dict )
         {
             no_dictionary:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-
-                // Error
-                return 0;
-            no_target:
-                #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
+    }
+}
 
-        // Standard library errors
-        {
-            no_mem:
-                #ifndef NDEBUG
-                    log_warning("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+size_t shm_dict_keys ( shm_dict *const p_shm_dict, const char **const keys )
+{
 
-                // Unlock
-                mutex_unlock(&p_dict->_lock);
+    // Argument check
+    if ( p_shm_dict == (void *) 0 ) goto no_dictionary;
 
-                // Error
-                return 0;
-        }
+    // Initialized data
+    shm_dict_header *p_header    = p_shm_dict->p_header;
+    size_t           entry_count = 0;
 
-        // Standard library errors
+    // Read lock
+    pthread_rwlock_rdlock(&p_header->lock);
+
+    // Store the count
+    entry_count = p_header->buckets.count;
+
+    // Counting branch?
+    if ( keys == 0 )
+    {
+
+        // Unlock
+        pthread_rwlock_unlock(&p_header->lock);
+
+        // Return
+        return entry_count;
+    }
+
+    // Copy each live key, in insertion order
+    for (size_t i = 0, j = 0; i < p_header->iterable.count; i++)
+    {
+
+        // Initialized data
+        uint64_t link = ( (const uint64_t *) SHM_DICT_AT(p_header, p_header->iterable.offset) )[i];
+
+        // Skip tombstones
+        if ( link == 0 ) continue;
+
+        // Store the key
+        keys[j++] = SHM_DICT_AT(p_header, ( (const shm_dict_node *) SHM_DICT_AT(p_header, link) )->key);
+    }
+
+    // Unlock
+    pthread_rwlock_unlock(&p_header->lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
         {
-            failed_to_free:
+            no_dictionary:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -891,76 +11425,111 @@ int dict_copy ( dict *const p_dict, dict **const pp_dict )
     }
 }
 
-int dict_clear ( dict *const p_dict )
+int shm_dict_add ( shm_dict *const p_shm_dict, const char *const key, const void *const p_value, size_t size )
 {
 
     // Argument check
-    if ( p_dict                == (void *) 0 ) goto no_dictionary;
-    if ( p_dict->entries.count ==          0 ) return 1;
+    if ( p_shm_dict == (void *) 0 )              goto no_dictionary;
+    if ( key        == (void *) 0 )              goto no_key;
+    if ( p_value    == (void *) 0 && size != 0 ) goto no_value;
 
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    // Initialized data
+    shm_dict_header    *p_header = p_shm_dict->p_header;
+    size_t              length   = strlen(key);
+    unsigned long long  h        = dict_hash(key, length);
+    uint64_t           *p_link   = 0,
+                       *iterable = 0,
+                        used     = 0,
+                        value    = 0,
+                        node     = 0;
+    shm_dict_node      *p_node   = 0;
+
+    // Write lock
+    pthread_rwlock_wrlock(&p_header->lock);
+
+    // Remember the arena, to give back a partial allocation
+    used = p_header->used;
 
-    // Iterate over each hash table item
-    for (size_t i = 0; i < p_dict->entries.max; i++)
-    {
+    // Find the key in the hash table
+    p_link = shm_dict_find(p_header, key, h);
 
-        // Is there a valid entry at the index?
-        if (p_dict->entries.data[i])
-        {
+    // Copy the value. An update gets new bytes too, since readers may hold the old ones
+    value = shm_dict_alloc(p_header, size);
+    if ( value == 0 ) goto region_full;
+    if ( size ) memcpy(SHM_DICT_AT(p_header, value), p_value, size);
 
-            // Initialized data
-            dict_item *i_di = p_dict->entries.data[i];
+    // Update an existing property
+    if ( *p_link )
+    {
 
-            // Iterate through linked list
-            while ( i_di )
-            {
+        // Update the property
+        p_node        = SHM_DICT_AT(p_header, *p_link);
+        p_node->value = value;
+        p_node->size  = size;
 
-                // Initialized data
-                dict_item *n = i_di->next;
+        // Done
+        goto done;
+    }
 
-                // Free the item
-                if ( DICT_REALLOC(i_di, 0) ) goto failed_to_free;
+    // Allocate the node, with the key after it. Every allocation comes before the
+    // header changes, so a full region leaves the dictionary as it was
+    node = shm_dict_alloc(p_header, sizeof(shm_dict_node) + length + 1);
+    if ( node == 0 ) goto region_full;
 
-                // Iterate
-                i_di = n;
-            }
+    // Make room in the iterable array
+    if ( p_header->iterable.count == p_header->iterable.max )
+    {
 
-            // Prevent double free
-            p_dict->entries.data[i] = 0;
-        }
-    }
+        // Reuse the slots of popped properties
+        if ( p_header->iterable.count > p_header->buckets.count ) shm_dict_squeeze(p_header);
 
-    // Clear iterables
+        // Grow the array. The old array stays in the arena until a clear
+        else
+        {
 
-    // If there are no iterables, there is nothing to do
-    if ( p_dict->iterable.keys == 0 && p_dict->iterable.values == 0 ) goto done;
+            // Initialized data
+            uint64_t max    = ( p_header->iterable.max ) ? p_header->iterable.max * 2 : DICT_SMALL_MAX,
+                     offset = shm_dict_alloc(p_header, max * sizeof(uint64_t));
 
-    // Check for a valid pointer
-    if ( p_dict->iterable.keys )
+            // Error checking
+            if ( offset == 0 ) goto region_full;
 
-        // Iterate over each key
-        for (size_t i = 0; i < p_dict->entries.count; i++)
+            // Copy the node offsets
+            if ( p_header->iterable.count ) memcpy(SHM_DICT_AT(p_header, offset), SHM_DICT_AT(p_header, p_header->iterable.offset), p_header->iterable.count * sizeof(uint64_t));
 
-            // Zero set the key
-            p_dict->iterable.keys[i] = 0;
+            // Store the array
+            p_header->iterable.offset = offset;
+            p_header->iterable.max    = max;
+        }
+    }
 
-    // Check for a valid pointer
-    if ( p_dict->iterable.values )
+    // Populate the node
+    p_node = SHM_DICT_AT(p_header, node);
+    *p_node = (shm_dict_node)
+    {
+        .hash  = h,
+        .next  = 0,
+        .key   = node + sizeof(shm_dict_node),
+        .value = value,
+        .size  = size,
+        .index = p_header->iterable.count
+    };
+    memcpy(SHM_DICT_AT(p_header, p_node->key), key, length + 1);
 
-        // Iterate over each value
-        for (size_t i = 0; i < p_dict->entries.count; i++)
+    // Append the node to the iterable array
+    iterable = SHM_DICT_AT(p_header, p_header->iterable.offset);
+    iterable[p_header->iterable.count++] = node;
 
-            // Zero the value
-            p_dict->iterable.values[i] = 0;
+    // Link it into the chain
+    *p_link = node;
 
-    // Zero the count
-    p_dict->entries.count = 0;
+    // Increment entries
+    p_header->buckets.count++;
 
     done:
 
     // Unlock
-    mutex_unlock(&p_dict->_lock);
+    pthread_rwlock_unlock(&p_header->lock);
 
     // Success
     return 1;
@@ -972,70 +11541,88 @@ int dict_clear ( dict *const p_dict )
         {
             no_dictionary:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_key:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_value:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_value\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
-        // Standard library errors
+        // dict errors
         {
-            failed_to_free:
+            region_full:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Shared memory region is full, failed to add property \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
                 #endif
 
+                // Give back the partial allocation
+                p_header->used = used;
+
+                // Unlock
+                pthread_rwlock_unlock(&p_header->lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int dict_free_clear ( dict *const p_dict, void (*const free_func)(const void *const) )
+int shm_dict_pop ( shm_dict *const p_shm_dict, const char *const key, const void **const pp_value )
 {
 
     // Argument check
-    if ( p_dict                == (void *) 0 ) goto no_dictionary;
-    if ( free_func             == (void *) 0 ) goto no_free_func;
-    if ( p_dict->entries.count ==          0 ) return 1;
-    
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    if ( p_shm_dict == (void *) 0 ) goto no_dictionary;
+    if ( key        == (void *) 0 ) goto no_key;
 
-    // Iterate over each hash table item
-    for (size_t i = 0; i < p_dict->entries.max; i++)
-    {
+    // Initialized data
+    shm_dict_header    *p_header = p_shm_dict->p_header;
+    unsigned long long  h        = dict_hash(key, strlen(key));
+    uint64_t           *p_link   = 0;
+    shm_dict_node      *p_node   = 0;
 
-        // Is there a valid entry at the index?
-        if (p_dict->entries.data[i])
-        {
+    // Write lock
+    pthread_rwlock_wrlock(&p_header->lock);
 
-            // Initialzied data
-            dict_item *i_di = p_dict->entries.data[i];
+    // Find the key in the hash table
+    p_link = shm_dict_find(p_header, key, h);
 
-            // Iterate through linked list
-            while ( i_di )
-            {
-                dict_item *n = i_di->next;
+    // Error check
+    if ( *p_link == 0 ) goto no_item;
 
-                // Call the specified deallocator
-                free_func(i_di->value);
+    // Store the node
+    p_node = SHM_DICT_AT(p_header, *p_link);
 
-                // Free the item
-                if ( DICT_REALLOC(i_di, 0) ) goto failed_to_free;
+    // Return the value. Its bytes stay in the arena until a clear
+    if ( pp_value ) *pp_value = SHM_DICT_AT(p_header, p_node->value);
 
-                // Iterate
-                i_di = n;
-            }
+    // Unlink the node, and leave a tombstone in the iterable array
+    *p_link = p_node->next;
+    ( (uint64_t *) SHM_DICT_AT(p_header, p_header->iterable.offset) )[p_node->index] = 0;
 
-            // Prevent double free
-            p_dict->entries.data[i] = 0;
-        }
-    }
+    // Decrement entries
+    p_header->buckets.count--;
+
+    // Squeeze out the tombstones once they outnumber the properties
+    if ( p_header->iterable.count - p_header->buckets.count > p_header->buckets.count ) shm_dict_squeeze(p_header);
 
     // Unlock
-    mutex_unlock(&p_dict->_lock);
+    pthread_rwlock_unlock(&p_header->lock);
 
     // Success
     return 1;
@@ -1047,71 +11634,134 @@ int dict_free_clear ( dict *const p_dict, void (*const free_func)(const void *co
         {
             no_dictionary:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"p_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            no_free_func:
+            no_key:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"free_func\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[dict] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
-        // Standard library errors
+        // Failed to find item
         {
-            failed_to_free:
+            no_item:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_warning("[dict] Failed to find property from key \"%s\" in call to function \"%s\"\n", key, __FUNCTION__);
                 #endif
 
+                // Unlock
+                pthread_rwlock_unlock(&p_header->lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int dict_destroy ( dict **const pp_dict )
+int shm_dict_clear ( shm_dict *const p_shm_dict )
 {
 
     // Argument check
-    if ( pp_dict  == (void *) 0 ) goto no_dictionary;
-    if ( *pp_dict == (void *) 0 ) goto pp_dict_null;
+    if ( p_shm_dict == (void *) 0 ) goto no_dictionary;
 
     // Initialized data
-    dict *p_dict = *pp_dict;
+    shm_dict_header *p_header = p_shm_dict->p_header;
 
-    // Lock
-    mutex_lock(&p_dict->_lock);
+    // Write lock
+    pthread_rwlock_wrlock(&p_header->lock);
 
-    // No more pointer for end user
-    *pp_dict = (dict *) 0;
+    // Empty every bucket
+    memset(SHM_DICT_AT(p_header, p_header->buckets.offset), 0, p_header->buckets.max * sizeof(uint64_t));
+
+    // Start a new generation, ordered before any later write into the arena, so readers
+    // can tell their values may be overwritten
+    __atomic_add_fetch(&p_header->generation, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    // Zero the counts, and give back the arena
+    p_header->buckets.count = 0;
+    p_header->iterable.offset = p_header->iterable.count = p_header->iterable.max = 0;
+    p_header->used = p_header->arena;
 
     // Unlock
-    mutex_unlock(&p_dict->_lock);
+    pthread_rwlock_unlock(&p_header->lock);
 
-    // Remove all the dictionary properties
-    if ( dict_clear(p_dict) == 0 ) goto failed_to_clear;
+    // Success
+    return 1;
 
-    // Free the hash table
-    if ( DICT_REALLOC(p_dict->entries.data, 0) ) goto failed_to_free;
+    // Error handling
+    {
 
-    // Free the iterables
-    // Free the keys
-    if ( DICT_REALLOC(p_dict->iterable.keys, 0) ) goto failed_to_free;
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Free the values
-    if ( DICT_REALLOC(p_dict->iterable.values, 0) ) goto failed_to_free;
+                // Error
+                return 0;
+        }
+    }
+}
 
-    // Destroy the mutex
-    mutex_destroy(&p_dict->_lock);
+unsigned long long shm_dict_generation ( shm_dict *const p_shm_dict )
+{
 
-    // Free the dictionary
-    if ( DICT_REALLOC(p_dict, 0) ) goto failed_to_free;
+    // Argument check
+    if ( p_shm_dict == (void *) 0 ) goto no_dictionary;
+
+    // Reads of values before this call are ordered before the load, and reads after it
+    // are ordered after the load
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    // Done
+    return __atomic_load_n(&p_shm_dict->p_header->generation, __ATOMIC_ACQUIRE);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_dictionary:
+                #ifndef NDEBUG
+                    log_error("[dict] Null pointer provided for parameter \"p_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int shm_dict_close ( shm_dict **const pp_shm_dict )
+{
+
+    // Argument check
+    if ( pp_shm_dict  == (void *) 0 ) goto no_dictionary;
+    if ( *pp_shm_dict == (void *) 0 ) goto pp_shm_dict_null;
+
+    // Initialized data
+    shm_dict *p_shm_dict = *pp_shm_dict;
+
+    // No more pointer for end user
+    *pp_shm_dict = (shm_dict *) 0;
+
+    // Unmap the region. Other processes keep their mappings, and the lock inside it
+    if ( munmap(p_shm_dict->p_header, p_shm_dict->bytes) ) goto failed_to_unmap;
+
+    // Close the shared memory object
+    if ( p_shm_dict->fd >= 0 ) close(p_shm_dict->fd);
+
+    // Free the handle
+    if ( DICT_REALLOC(p_shm_dict, 0) ) goto failed_to_free;
 
     // Success
     return 1;
@@ -1123,26 +11773,62 @@ int dict_destroy ( dict **const pp_dict )
         {
             no_dictionary:
                 #ifndef NDEBUG
-                    log_warning("[dict] Null pointer provided for parameter \"pp_dict\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_warning("[dict] Null pointer provided for parameter \"pp_shm_dict\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            pp_dict_null:
+            pp_shm_dict_null:
                 #ifndef NDEBUG
-                    log_warning("[dict] Parameter \"pp_dict\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                    log_warning("[dict] Parameter \"pp_shm_dict\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
-        // dict errors
+        // Standard library errors
         {
-            failed_to_clear:
+            failed_to_unmap:
                 #ifndef NDEBUG
-                    log_warning("[dict] Call to \"dict_clear\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[Standard library] Call to \"munmap\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_free:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int shm_dict_unlink ( const char *const name )
+{
+
+    // Argument check
+    if ( name == (void *) 0 ) goto no_name;
+
+    // Remove the name. Mapped regions live on until every process closes them
+    if ( shm_unlink(name) ) goto failed_to_unlink;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_name:
+                #ifndef NDEBUG
+                    log_warning("[dict] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -1151,9 +11837,9 @@ int dict_destroy ( dict **const pp_dict )
 
         // Standard library errors
         {
-            failed_to_free:
+            failed_to_unlink:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Call to \"realloc\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    log_warning("[Standard library] Failed to remove shared memory object \"%s\" in call to function \"%s\"\n", name, __FUNCTION__);
                 #endif
 
                 // Error
@@ -1161,6 +11847,175 @@ int dict_destroy ( dict **const pp_dict )
         }
     }
 }
+#else
+
+int shm_dict_create ( shm_dict **const pp_shm_dict, const char *const name, size_t size, size_t bytes )
+{
+
+    // Suppress warnings
+    (void) pp_shm_dict;
+    (void) name;
+    (void) size;
+    (void) bytes;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int shm_dict_open ( shm_dict **const pp_shm_dict, const char *const name )
+{
+
+    // Suppress warnings
+    (void) pp_shm_dict;
+    (void) name;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+const void *shm_dict_get ( shm_dict *const p_shm_dict, const char *const key, size_t *const p_size )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+    (void) key;
+    (void) p_size;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return (void *) 0;
+}
+
+size_t shm_dict_values ( shm_dict *const p_shm_dict, const void **const values )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+    (void) values;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+size_t shm_dict_keys ( shm_dict *const p_shm_dict, const char **const keys )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+    (void) keys;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int shm_dict_add ( shm_dict *const p_shm_dict, const char *const key, const void *const p_value, size_t size )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+    (void) key;
+    (void) p_value;
+    (void) size;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int shm_dict_pop ( shm_dict *const p_shm_dict, const char *const key, const void **const pp_value )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+    (void) key;
+    (void) pp_value;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int shm_dict_clear ( shm_dict *const p_shm_dict )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+unsigned long long shm_dict_generation ( shm_dict *const p_shm_dict )
+{
+
+    // Suppress warnings
+    (void) p_shm_dict;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int shm_dict_close ( shm_dict **const pp_shm_dict )
+{
+
+    // Suppress warnings
+    (void) pp_shm_dict;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+
+int shm_dict_unlink ( const char *const name )
+{
+
+    // Suppress warnings
+    (void) name;
+
+    #ifndef NDEBUG
+        log_error("[dict] Shared memory dictionaries need POSIX shared memory, which this platform does not have, in call to function \"%s\"\n", __FUNCTION__);
+    #endif
+
+    // Error
+    return 0;
+}
+#endif
 
 void dict_exit ( void )
 {
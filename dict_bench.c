@@ -0,0 +1,990 @@
+/** !
+ * dict benchmark
+ *
+ * @file dict_bench.c
+ * @author Jacob C Smith
+*/
+
+// Include
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <dict/dict.h>
+#include <log/log.h>
+
+// Operations timed per sample
+#define BENCH_BATCH 64
+
+// Key length distributions
+enum bench_length_e
+{
+    length_8,
+    length_32,
+    length_128,
+    length_mixed,
+    length_quantity
+};
+
+// Type definitions
+typedef struct bench_samples_s bench_samples;
+typedef struct bench_state_s   bench_state;
+typedef struct bench_thread_s  bench_thread;
+typedef void (fn_bench_op)( bench_state *const p_state, size_t i );
+
+// Structure definitions
+struct bench_samples_s
+{
+    double *ns;    // Nanoseconds per operation, one per batch
+    size_t  count, // Samples
+            max,   // Sample array bound
+            ops;   // Operations
+};
+
+struct bench_state_s
+{
+    dict             *p_dict;            // The dictionary under test
+    sharded_dict     *p_sharded_dict;    // The sharded dictionary under test
+    replicated_dict  *p_replicated_dict; // The replicated dictionary under test
+    int_dict         *p_int_dict;        // The integer keyed dictionary under test
+    const char      **keys,              // Keys in the dictionary
+                    **miss_keys;         // Keys not in the dictionary
+    size_t           *order,             // Lookup order
+                      keys_count;        // Number of keys
+    void            **buffer;            // Export buffer, keys_count elements
+};
+
+struct bench_thread_s
+{
+    pthread_t      thread;  // The thread
+    bench_state   *p_state; // Shared state
+    fn_bench_op   *pfn_op;  // The operation
+    size_t         begin,   // First index
+                   end;     // One past the last index
+    bench_samples  samples; // Samples
+};
+
+// Data
+static const char *length_names[length_quantity] = { "8", "32", "128", "mixed" };
+static _Thread_local size_t sink                 = 0;
+static pthread_barrier_t start_barrier;
+
+// Hash functions under comparison
+static const struct
+{
+    const char *name;
+    fn_hash64  *pfn_hash_function;
+} hash_functions[] =
+{
+    { "dict" , dict_hash  },
+    { "crc64", hash_crc64 },
+    { "fnv64", hash_fnv64 },
+    { "mmh64", hash_mmh64 },
+    { "xxh64", hash_xxh64 }
+};
+
+// Placements under comparison, against the heap allocated get_hit rows
+static const struct
+{
+    const char            *name;
+    dict_placement_config  placement;
+} placements[] =
+{
+    { "thp_get_hit"       , { .pages = DICT_PAGES_TRANSPARENT } },
+    { "hugetlb_get_hit"   , { .pages = DICT_PAGES_EXPLICIT } },
+    { "interleave_get_hit", { .pages = DICT_PAGES_TRANSPARENT, .numa = DICT_NUMA_INTERLEAVE } }
+};
+
+// Forward declarations
+int    bench_keys_generate ( const char ***const p_keys, char **const p_arena, size_t count, enum bench_length_e length, char pad );
+int    bench_samples_push  ( bench_samples *const p_samples, timestamp elapsed, size_t ops );
+int    bench_samples_merge ( bench_samples *const p_samples, const bench_samples *const p_other );
+int    bench_compare_double( const void *a, const void *b );
+double bench_percentile    ( bench_samples *const p_samples, double p );
+int    bench_report        ( const char *name, size_t keys, enum bench_length_e length, size_t size, size_t threads, bench_samples *const p_samples, timestamp elapsed );
+int    bench_run           ( const char *name, bench_state *const p_state, fn_bench_op *pfn_op, size_t count, size_t threads, enum bench_length_e length, size_t size );
+int    bench_whole         ( const char *name, bench_state *const p_state, enum bench_length_e length, size_t size, int (*pfn_whole)(bench_state *const) );
+int    bench_config        ( size_t keys, enum bench_length_e length, size_t size, size_t max_threads );
+int    bench_corpus        ( const char *path );
+void  *bench_thread_main   ( void *p_parameter );
+void   bench_foreach_op    ( const void *const p_value, size_t i );
+
+void op_add         ( bench_state *const p_state, size_t i );
+void op_get_hit     ( bench_state *const p_state, size_t i );
+void op_get_miss    ( bench_state *const p_state, size_t i );
+void op_pop         ( bench_state *const p_state, size_t i );
+void op_prefix      ( bench_state *const p_state, size_t i );
+void op_sharded_add ( bench_state *const p_state, size_t i );
+void op_int_add     ( bench_state *const p_state, size_t i );
+void op_int_get_hit ( bench_state *const p_state, size_t i );
+void op_int_pop     ( bench_state *const p_state, size_t i );
+void op_replicated_get_hit ( bench_state *const p_state, size_t i );
+
+int whole_keys    ( bench_state *const p_state );
+int whole_values  ( bench_state *const p_state );
+int whole_foreach ( bench_state *const p_state );
+int whole_copy    ( bench_state *const p_state );
+int whole_batch   ( bench_state *const p_state );
+
+// Entry point
+int main ( int argc, const char* argv[] )
+{
+
+    // Initialized data
+    size_t min_keys    = 100,
+           max_keys    = 1000000,
+           max_threads = 4;
+    int    lengths     = ( 1 << length_quantity ) - 1;
+    bool   corpus      = false;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; i++)
+    {
+
+        // Largest key count
+        if      ( strcmp(argv[i], "-n") == 0 && i + 1 < argc ) max_keys    = strtoull(argv[++i], 0, 10);
+
+        // Smallest key count
+        else if ( strcmp(argv[i], "-m") == 0 && i + 1 < argc ) min_keys    = strtoull(argv[++i], 0, 10);
+
+        // Most threads
+        else if ( strcmp(argv[i], "-t") == 0 && i + 1 < argc ) max_threads = strtoull(argv[++i], 0, 10);
+
+        // Key length distribution
+        else if ( strcmp(argv[i], "-l") == 0 && i + 1 < argc )
+        {
+
+            // Reset
+            lengths = 0;
+
+            // Match the name
+            for (int j = 0; j < length_quantity; j++)
+                if ( strcmp(argv[i + 1], length_names[j]) == 0 ) lengths = 1 << j;
+
+            // Iterate
+            i++;
+        }
+
+        // Key corpus. Compare the hash functions on each file, instead of the operation benchmarks
+        else if ( strcmp(argv[i], "-k") == 0 && i + 1 < argc )
+        {
+
+            // Print the header before the first corpus
+            if ( corpus == false ) printf("hash,corpus,keys,mean_key_length,hash_ns_per_key,hash_gb_per_sec,get_ns_per_op,p50_ns,p90_ns,p99_ns,load_factor,empty_fraction,max_chain,mean_chain,uniformity\n");
+
+            // Set the flag
+            corpus = true;
+
+            // Compare the hash functions on the corpus
+            if ( bench_corpus(argv[++i]) == 0 ) return EXIT_FAILURE;
+        }
+
+        // Usage
+        else goto print_usage;
+    }
+
+    // Done, if the hash functions were compared
+    if ( corpus ) return EXIT_SUCCESS;
+
+    // Error check
+    if ( min_keys == 0 || max_keys < min_keys || max_threads == 0 || lengths == 0 ) goto print_usage;
+
+    // CSV header
+    printf("benchmark,keys,key_length,size,threads,ops,ns_per_op,ops_per_sec,p50_ns,p90_ns,p99_ns\n");
+
+    // Iterate over each key count, by powers of ten
+    for (size_t keys = min_keys; keys <= max_keys; keys *= 10)
+
+        // Iterate over each key length distribution
+        for (int length = 0; length < length_quantity; length++)
+        {
+
+            // Skip unselected distributions
+            if ( ( lengths & ( 1 << length ) ) == 0 ) continue;
+
+            // Load factor 4, 1, 0.5
+            bench_config(keys, (enum bench_length_e) length, ( keys / 4 ) ? keys / 4 : 1, 1);
+            bench_config(keys, (enum bench_length_e) length, keys, max_threads);
+            bench_config(keys, (enum bench_length_e) length, keys * 2, 1);
+        }
+
+    // Success
+    return EXIT_SUCCESS;
+
+    print_usage:
+        fprintf(stderr, "Usage: %s [-n max_keys] [-m min_keys] [-t max_threads] [-l 8|32|128|mixed]\n", argv[0]);
+        fprintf(stderr, "       %s -k key_file [-k key_file ...]\n", argv[0]);
+
+        // Error
+        return EXIT_FAILURE;
+}
+
+int bench_keys_generate ( const char ***const p_keys, char **const p_arena, size_t count, enum bench_length_e length, char pad )
+{
+
+    // Initialized data
+    const char         **keys   = DICT_REALLOC(0, count * sizeof(char *));
+    size_t              *sizes  = DICT_REALLOC(0, count * sizeof(size_t));
+    char                *arena  = 0;
+    size_t               total  = 0;
+    unsigned long long   state  = 0x9E3779B97F4A7C15ULL;
+
+    // Error checking
+    if ( keys == (void *) 0 || sizes == (void *) 0 ) goto no_mem;
+
+    // Choose each key length
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Step the generator
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+
+        // Fixed lengths, or uniform on [8, 64]
+        switch ( length )
+        {
+            case length_8:   sizes[i] = 8;   break;
+            case length_32:  sizes[i] = 32;  break;
+            case length_128: sizes[i] = 128; break;
+            default:         sizes[i] = 8 + (size_t) ( state % 57 ); break;
+        }
+
+        // Accumulate, with room for the null terminator
+        total += sizes[i] + 1;
+    }
+
+    // Allocate the keys
+    arena = DICT_REALLOC(0, total);
+
+    // Error checking
+    if ( arena == (void *) 0 ) goto no_mem;
+
+    // Write each key
+    for (size_t i = 0, offset = 0; i < count; i++)
+    {
+
+        // Initialized data
+        char   *key     = &arena[offset];
+        size_t  written = (size_t) snprintf(key, sizes[i] + 1, "%zx", i);
+
+        // Pad with letters that are not hex digits, so every key is unique
+        for (size_t j = written; j < sizes[i]; j++)
+        {
+
+            // Step the generator
+            state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+
+            // Pad
+            key[j] = (char) ( pad + (char) ( state % 20 ) );
+        }
+
+        // Terminate
+        key[sizes[i]] = '\0';
+
+        // Store the key
+        keys[i] = key;
+
+        // Iterate
+        offset += sizes[i] + 1;
+    }
+
+    // Clean up
+    free(sizes);
+
+    // Return the keys to the caller
+    *p_keys  = keys;
+    *p_arena = arena;
+
+    // Success
+    return 1;
+
+    // Error handling
+    no_mem:
+        log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+        // Clean up
+        free(keys);
+        free(sizes);
+
+        // Error
+        return 0;
+}
+
+int bench_samples_push ( bench_samples *const p_samples, timestamp elapsed, size_t ops )
+{
+
+    // Grow the samples?
+    if ( p_samples->count >= p_samples->max )
+    {
+
+        // Initialized data
+        size_t  max = ( p_samples->max ) ? p_samples->max * 2 : 1024;
+        double *ns  = DICT_REALLOC(p_samples->ns, max * sizeof(double));
+
+        // Error checking
+        if ( ns == (void *) 0 ) return 0;
+
+        // Store the samples
+        p_samples->ns  = ns;
+        p_samples->max = max;
+    }
+
+    // Store the sample as nanoseconds per operation
+    p_samples->ns[p_samples->count++] = (double) elapsed * 1e9 / (double) timer_seconds_divisor() / (double) ops;
+
+    // Accumulate
+    p_samples->ops += ops;
+
+    // Success
+    return 1;
+}
+
+int bench_samples_merge ( bench_samples *const p_samples, const bench_samples *const p_other )
+{
+
+    // Grow the samples?
+    if ( p_samples->count + p_other->count > p_samples->max )
+    {
+
+        // Initialized data
+        size_t  max = p_samples->count + p_other->count;
+        double *ns  = DICT_REALLOC(p_samples->ns, max * sizeof(double));
+
+        // Error checking
+        if ( ns == (void *) 0 ) return 0;
+
+        // Store the samples
+        p_samples->ns  = ns;
+        p_samples->max = max;
+    }
+
+    // Append the other samples
+    memcpy(&p_samples->ns[p_samples->count], p_other->ns, p_other->count * sizeof(double));
+
+    // Accumulate
+    p_samples->count += p_other->count;
+    p_samples->ops   += p_other->ops;
+
+    // Success
+    return 1;
+}
+
+int bench_compare_double ( const void *a, const void *b )
+{
+
+    // Initialized data
+    double x = *(const double *) a,
+           y = *(const double *) b;
+
+    // Done
+    return ( x > y ) - ( x < y );
+}
+
+double bench_percentile ( bench_samples *const p_samples, double p )
+{
+
+    // State check
+    if ( p_samples->count == 0 ) return 0.0;
+
+    // Done
+    return p_samples->ns[(size_t) ( p * (double) ( p_samples->count - 1 ) )];
+}
+
+int bench_report ( const char *name, size_t keys, enum bench_length_e length, size_t size, size_t threads, bench_samples *const p_samples, timestamp elapsed )
+{
+
+    // Initialized data
+    double seconds = (double) elapsed / (double) timer_seconds_divisor();
+
+    // Sort the samples
+    qsort(p_samples->ns, p_samples->count, sizeof(double), bench_compare_double);
+
+    // Print a CSV row
+    printf("%s,%zu,%s,%zu,%zu,%zu,%.2f,%.0f,%.2f,%.2f,%.2f\n",
+        name, keys, length_names[length], size, threads, p_samples->ops,
+        seconds * 1e9 * (double) threads / (double) p_samples->ops,
+        (double) p_samples->ops / seconds,
+        bench_percentile(p_samples, 0.50),
+        bench_percentile(p_samples, 0.90),
+        bench_percentile(p_samples, 0.99)
+    );
+
+    // Flush, so partial results survive a long run
+    fflush(stdout);
+
+    // Success
+    return 1;
+}
+
+void *bench_thread_main ( void *p_parameter )
+{
+
+    // Initialized data
+    bench_thread *p_thread = p_parameter;
+
+    // Wait for every thread
+    pthread_barrier_wait(&start_barrier);
+
+    // Run the operation in batches
+    for (size_t i = p_thread->begin; i < p_thread->end; i += BENCH_BATCH)
+    {
+
+        // Initialized data
+        size_t    end = ( i + BENCH_BATCH < p_thread->end ) ? i + BENCH_BATCH : p_thread->end;
+        timestamp t0  = timer_high_precision();
+
+        // Run the batch
+        for (size_t j = i; j < end; j++) p_thread->pfn_op(p_thread->p_state, j);
+
+        // Store the sample
+        bench_samples_push(&p_thread->samples, timer_high_precision() - t0, end - i);
+    }
+
+    // Done
+    return 0;
+}
+
+int bench_run ( const char *name, bench_state *const p_state, fn_bench_op *pfn_op, size_t count, size_t threads, enum bench_length_e length, size_t size )
+{
+
+    // Initialized data
+    bench_thread  *p_threads = calloc(threads, sizeof(bench_thread));
+    bench_samples  samples   = { 0 };
+    timestamp      t0        = 0,
+                   t1        = 0;
+
+    // Error checking
+    if ( p_threads == (void *) 0 ) return 0;
+
+    // Start line for every thread, and this one
+    pthread_barrier_init(&start_barrier, 0, (unsigned) threads + 1);
+
+    // Split the keys between the threads
+    for (size_t i = 0; i < threads; i++)
+    {
+
+        // Populate the thread
+        p_threads[i] = (bench_thread)
+        {
+            .p_state = p_state,
+            .pfn_op  = pfn_op,
+            .begin   = count * i / threads,
+            .end     = count * ( i + 1 ) / threads
+        };
+
+        // Start the thread
+        pthread_create(&p_threads[i].thread, 0, bench_thread_main, &p_threads[i]);
+    }
+
+    // Start
+    pthread_barrier_wait(&start_barrier);
+    t0 = timer_high_precision();
+
+    // Wait for each thread, and merge the samples
+    for (size_t i = 0; i < threads; i++)
+    {
+
+        // Wait
+        pthread_join(p_threads[i].thread, 0);
+
+        // Merge
+        bench_samples_merge(&samples, &p_threads[i].samples);
+
+        // Clean up
+        free(p_threads[i].samples.ns);
+    }
+
+    // Stop
+    t1 = timer_high_precision();
+
+    // Report
+    bench_report(name, p_state->keys_count, length, size, threads, &samples, t1 - t0);
+
+    // Clean up
+    pthread_barrier_destroy(&start_barrier);
+    free(samples.ns);
+    free(p_threads);
+
+    // Success
+    return 1;
+}
+
+int bench_whole ( const char *name, bench_state *const p_state, enum bench_length_e length, size_t size, int (*pfn_whole)(bench_state *const) )
+{
+
+    // Initialized data
+    bench_samples samples     = { 0 };
+    size_t        repetitions = 1 + 1000000 / p_state->keys_count;
+    timestamp     total       = 0;
+
+    // Repeat small dictionaries, so the timer resolution doesn't dominate
+    for (size_t i = 0; i < repetitions; i++)
+    {
+
+        // Initialized data
+        timestamp t0 = timer_high_precision();
+
+        // Run the operation over every property
+        pfn_whole(p_state);
+
+        // Store the sample
+        t0 = timer_high_precision() - t0;
+        bench_samples_push(&samples, t0, p_state->keys_count);
+        total += t0;
+    }
+
+    // Report
+    bench_report(name, p_state->keys_count, length, size, 1, &samples, total);
+
+    // Clean up
+    free(samples.ns);
+
+    // Success
+    return 1;
+}
+
+void op_add ( bench_state *const p_state, size_t i )
+{
+
+    // Add the key
+    dict_add(p_state->p_dict, p_state->keys[i], (void *) p_state->keys[i]);
+}
+
+void op_sharded_add ( bench_state *const p_state, size_t i )
+{
+
+    // Add the key
+    sharded_dict_add(p_state->p_sharded_dict, p_state->keys[i], (void *) p_state->keys[i]);
+}
+
+void op_replicated_get_hit ( bench_state *const p_state, size_t i )
+{
+
+    // Get the key from this thread's node's replica
+    sink += (size_t) replicated_dict_get(p_state->p_replicated_dict, p_state->keys[p_state->order[i]]);
+}
+
+void op_int_add ( bench_state *const p_state, size_t i )
+{
+
+    // Add the ID
+    int_dict_add(p_state->p_int_dict, i, (void *) p_state->keys[i]);
+}
+
+void op_int_get_hit ( bench_state *const p_state, size_t i )
+{
+
+    // Get the ID
+    sink += (size_t) int_dict_get(p_state->p_int_dict, p_state->order[i]);
+}
+
+void op_int_pop ( bench_state *const p_state, size_t i )
+{
+
+    // Remove the ID
+    int_dict_pop(p_state->p_int_dict, p_state->order[i], 0);
+}
+
+void op_get_hit ( bench_state *const p_state, size_t i )
+{
+
+    // Get the key
+    sink += (size_t) dict_get(p_state->p_dict, p_state->keys[p_state->order[i]]);
+}
+
+void op_get_miss ( bench_state *const p_state, size_t i )
+{
+
+    // Get a missing key
+    sink += (size_t) dict_get(p_state->p_dict, p_state->miss_keys[p_state->order[i]]);
+}
+
+void op_pop ( bench_state *const p_state, size_t i )
+{
+
+    // Remove the key
+    dict_pop(p_state->p_dict, p_state->keys[p_state->order[i]], 0);
+}
+
+void op_prefix ( bench_state *const p_state, size_t i )
+{
+
+    // Initialized data
+    char         prefix[5] = { 0 };
+    dict_cursor  cursor    = { 0 };
+
+    // The first four characters of the key
+    strncpy(prefix, p_state->keys[p_state->order[i]], 4);
+
+    // Visit each key with the prefix
+    dict_prefix(p_state->p_dict, prefix, &cursor);
+    while ( dict_cursor_next(&cursor, 0, 0) ) sink++;
+}
+
+void bench_foreach_op ( const void *const p_value, size_t i )
+{
+
+    // Touch the value
+    sink += (size_t) p_value + i;
+}
+
+int whole_keys ( bench_state *const p_state )
+{
+
+    // Export the keys
+    return (int) dict_keys(p_state->p_dict, (const char **) p_state->buffer);
+}
+
+int whole_values ( bench_state *const p_state )
+{
+
+    // Export the values
+    return (int) dict_values(p_state->p_dict, p_state->buffer);
+}
+
+int whole_foreach ( bench_state *const p_state )
+{
+
+    // Visit each value
+    return dict_foreach(p_state->p_dict, bench_foreach_op);
+}
+
+int whole_copy ( bench_state *const p_state )
+{
+
+    // Initialized data
+    dict *p_copy = 0;
+
+    // Copy the dictionary
+    dict_copy(p_state->p_dict, &p_copy);
+
+    // Clean up
+    return dict_destroy(&p_copy);
+}
+
+int whole_batch ( bench_state *const p_state )
+{
+
+    // Initialized data
+    dict       *p_dict  = 0;
+    dict_batch *p_batch = 0;
+
+    // Record an add for every key
+    dict_batch_construct(&p_batch, p_state->keys_count);
+    for (size_t i = 0; i < p_state->keys_count; i++) dict_batch_add(p_batch, p_state->keys[i], (void *) p_state->keys[i]);
+
+    // Apply the batch to a new dictionary
+    dict_construct(&p_dict, p_state->keys_count, 0);
+    dict_apply_batch(p_dict, p_batch);
+
+    // Clean up
+    dict_batch_destroy(&p_batch);
+    return dict_destroy(&p_dict);
+}
+
+int bench_config ( size_t keys, enum bench_length_e length, size_t size, size_t max_threads )
+{
+
+    // Initialized data
+    bench_state  state      = { .keys_count = keys };
+    char        *arena      = 0,
+                *miss_arena = 0;
+
+    // Generate the keys
+    if ( bench_keys_generate(&state.keys     , &arena     , keys, length, 'g') == 0 ) return 0;
+    if ( bench_keys_generate(&state.miss_keys, &miss_arena, keys, length, 'G') == 0 ) return 0;
+
+    // Allocate the export buffer
+    state.buffer = malloc(keys * sizeof(void *));
+
+    // Shuffle the lookup order
+    state.order = malloc(keys * sizeof(size_t));
+    for (size_t i = 0; i < keys; i++) state.order[i] = i;
+    for (size_t i = keys - 1; i > 0; i--)
+    {
+
+        // Initialized data
+        size_t j = (size_t) rand() % ( i + 1 ),
+               t = state.order[i];
+
+        // Swap
+        state.order[i] = state.order[j], state.order[j] = t;
+    }
+
+    // Single threaded operations
+    dict_construct(&state.p_dict, size, 0);
+    bench_run("add"     , &state, op_add     , keys, 1, length, size);
+    bench_run("update"  , &state, op_add     , keys, 1, length, size);
+    bench_run("get_hit" , &state, op_get_hit , keys, 1, length, size);
+    bench_run("get_miss", &state, op_get_miss, keys, 1, length, size);
+    bench_whole("keys"   , &state, length, size, whole_keys);
+    bench_whole("values" , &state, length, size, whole_values);
+    bench_whole("foreach", &state, length, size, whole_foreach);
+    bench_whole("copy"   , &state, length, size, whole_copy);
+    bench_whole("batch"  , &state, length, size, whole_batch);
+    dict_index_enable(state.p_dict, true);
+    bench_run("prefix"  , &state, op_prefix  , keys, 1, length, size);
+    dict_index_enable(state.p_dict, false);
+    dict_filter_enable(state.p_dict, 16 * keys);
+    bench_run("filtered_get_hit" , &state, op_get_hit , keys, 1, length, size);
+    bench_run("filtered_get_miss", &state, op_get_miss, keys, 1, length, size);
+    dict_filter_enable(state.p_dict, 0);
+    bench_run("pop"     , &state, op_pop     , keys, 1, length, size);
+    dict_destroy(&state.p_dict);
+
+    // Placed hash tables and iterables
+    for (size_t i = 0; i < sizeof(placements) / sizeof(*placements); i++)
+    {
+
+        // Skip placements the system cannot honor
+        if ( dict_construct_placed(&state.p_dict, size, 0, &placements[i].placement, 0) == 0 ) continue;
+
+        // Fill the dictionary, and time lookups
+        for (size_t j = 0; j < keys; j++) op_add(&state, j);
+        bench_run(placements[i].name, &state, op_get_hit, keys, 1, length, size);
+        dict_destroy(&state.p_dict);
+    }
+
+    // Integer keyed operations
+    int_dict_construct(&state.p_int_dict, size);
+    bench_run("int_add"    , &state, op_int_add    , keys, 1, length, size);
+    bench_run("int_get_hit", &state, op_int_get_hit, keys, 1, length, size);
+    bench_run("int_pop"    , &state, op_int_pop    , keys, 1, length, size);
+    int_dict_destroy(&state.p_int_dict);
+
+    // Clear
+    {
+
+        // Initialized data
+        bench_samples samples = { 0 };
+        timestamp     t0      = 0;
+
+        // Fill a dictionary
+        dict_construct(&state.p_dict, size, 0);
+        for (size_t i = 0; i < keys; i++) op_add(&state, i);
+
+        // Time the clear
+        t0 = timer_high_precision();
+        dict_clear(state.p_dict);
+        t0 = timer_high_precision() - t0;
+
+        // Report
+        bench_samples_push(&samples, t0, keys);
+        bench_report("clear", keys, length, size, 1, &samples, t0);
+
+        // Clean up
+        free(samples.ns);
+        dict_destroy(&state.p_dict);
+    }
+
+    // Multithreaded operations
+    for (size_t threads = 2; threads <= max_threads; threads *= 2)
+    {
+
+        // Concurrent adds to one dictionary
+        dict_construct(&state.p_dict, size, 0);
+        bench_run("add"    , &state, op_add    , keys, threads, length, size);
+        bench_run("get_hit", &state, op_get_hit, keys, threads, length, size);
+        dict_destroy(&state.p_dict);
+
+        // Concurrent lookups, with the hash table spread over every NUMA node
+        if ( dict_construct_placed(&state.p_dict, size, 0, &placements[2].placement, 0) )
+        {
+
+            // Fill the dictionary, and time lookups
+            for (size_t j = 0; j < keys; j++) op_add(&state, j);
+            bench_run(placements[2].name, &state, op_get_hit, keys, threads, length, size);
+            dict_destroy(&state.p_dict);
+        }
+
+        // Concurrent lookups, each on its own node's replica
+        if ( replicated_dict_construct(&state.p_replicated_dict, size, 0, 0) )
+        {
+
+            // Fill the replicas, and time lookups
+            for (size_t j = 0; j < keys; j++) replicated_dict_add(state.p_replicated_dict, state.keys[j], (void *) state.keys[j]);
+            replicated_dict_sync(state.p_replicated_dict);
+            bench_run("replicated_get_hit", &state, op_replicated_get_hit, keys, threads, length, size);
+            replicated_dict_destroy(&state.p_replicated_dict);
+        }
+
+        // Concurrent adds to a sharded dictionary
+        sharded_dict_construct(&state.p_sharded_dict, threads * 4, size, 0);
+        bench_run("sharded_add", &state, op_sharded_add, keys, threads, length, size);
+        sharded_dict_destroy(&state.p_sharded_dict);
+    }
+
+    // Clean up
+    free(state.buffer);
+    free(state.order);
+    free(state.keys);
+    free(state.miss_keys);
+    free(arena);
+    free(miss_arena);
+
+    // Success
+    return 1;
+}
+
+int bench_corpus ( const char *path )
+{
+
+    // Initialized data
+    FILE         *p_file  = fopen(path, "rb");
+    char         *text    = 0;
+    const char  **keys    = 0;
+    size_t       *lengths = 0,
+                  size    = 0,
+                  count   = 0,
+                  bytes   = 0;
+
+    // Error checking
+    if ( p_file == (void *) 0 ) goto failed_to_open;
+
+    // Find the size of the file
+    fseek(p_file, 0, SEEK_END);
+    size = (size_t) ftell(p_file);
+    fseek(p_file, 0, SEEK_SET);
+
+    // Read the file
+    text = malloc(size + 1);
+    if ( text == (void *) 0 ) goto no_mem;
+    size = fread(text, 1, size, p_file);
+    text[size] = '\0';
+    fclose(p_file);
+
+    // One key per line
+    keys    = malloc(( size / 2 + 1 ) * sizeof(char *));
+    lengths = malloc(( size / 2 + 1 ) * sizeof(size_t));
+    if ( keys == (void *) 0 || lengths == (void *) 0 ) goto no_mem;
+
+    // Split the lines
+    for (char *line = text; *line; )
+    {
+
+        // Initialized data
+        size_t length = strcspn(line, "\n");
+        char  *next   = ( line[length] ) ? &line[length + 1] : &line[length];
+
+        // Terminate the line, and strip carriage returns
+        line[length] = '\0';
+        if ( length && line[length - 1] == '\r' ) line[--length] = '\0';
+
+        // Store the key, skipping empty lines
+        if ( length )
+        {
+            keys[count]    = line;
+            lengths[count] = length;
+            bytes         += length;
+            count++;
+        }
+
+        // Iterate
+        line = next;
+    }
+
+    // Error check
+    if ( count == 0 ) goto no_keys;
+
+    // Iterate over each hash function
+    for (size_t h = 0; h < sizeof(hash_functions) / sizeof(*hash_functions); h++)
+    {
+
+        // Initialized data
+        fn_hash64     *pfn_hash_function = hash_functions[h].pfn_hash_function;
+        dict          *p_dict            = 0;
+        dict_analysis  analysis          = { 0 };
+        bench_samples  samples           = { 0 };
+        size_t         repetitions       = 1 + 10000000 / bytes;
+        timestamp      hash_time         = 0,
+                       get_time          = 0;
+
+        // Time the hash function alone
+        hash_time = timer_high_precision();
+        for (size_t r = 0; r < repetitions; r++)
+            for (size_t i = 0; i < count; i++)
+                sink += (size_t) pfn_hash_function(keys[i], lengths[i]);
+        hash_time = timer_high_precision() - hash_time;
+
+        // Fill a dictionary with one bucket per key
+        dict_construct(&p_dict, count, pfn_hash_function);
+        for (size_t i = 0; i < count; i++) dict_add(p_dict, keys[i], (void *) keys[i]);
+
+        // Time lookups of every key
+        for (size_t i = 0; i < count; i += BENCH_BATCH)
+        {
+
+            // Initialized data
+            size_t    end = ( i + BENCH_BATCH < count ) ? i + BENCH_BATCH : count;
+            timestamp t0  = timer_high_precision();
+
+            // Run the batch
+            for (size_t j = i; j < end; j++) sink += (size_t) dict_get(p_dict, keys[j]);
+
+            // Store the sample
+            t0 = timer_high_precision() - t0;
+            bench_samples_push(&samples, t0, end - i);
+            get_time += t0;
+        }
+
+        // Measure the chains
+        dict_analyze(p_dict, &analysis);
+
+        // Sort the samples
+        qsort(samples.ns, samples.count, sizeof(double), bench_compare_double);
+
+        // Print a CSV row
+        printf("%s,%s,%zu,%.2f,%.2f,%.3f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%zu,%.3f,%.3f\n",
+            hash_functions[h].name, path, count, (double) bytes / (double) count,
+            (double) hash_time * 1e9 / (double) timer_seconds_divisor() / (double) ( count * repetitions ),
+            (double) ( bytes * repetitions ) / ( (double) hash_time / (double) timer_seconds_divisor() ) / 1e9,
+            (double) get_time * 1e9 / (double) timer_seconds_divisor() / (double) count,
+            bench_percentile(&samples, 0.50),
+            bench_percentile(&samples, 0.90),
+            bench_percentile(&samples, 0.99),
+            analysis.load_factor, analysis.empty_fraction, analysis.max_chain, analysis.mean_chain, analysis.uniformity
+        );
+
+        // Clean up
+        free(samples.ns);
+        dict_destroy(&p_dict);
+    }
+
+    // Clean up
+    free(keys);
+    free(lengths);
+    free(text);
+
+    // Success
+    return 1;
+
+    // Error handling
+    failed_to_open:
+        log_error("[dict] Failed to open key file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+
+        // Error
+        return 0;
+
+    no_keys:
+        log_error("[dict] Key file \"%s\" has no keys in call to function \"%s\"\n", path, __FUNCTION__);
+
+        // Clean up
+        free(keys);
+        free(lengths);
+        free(text);
+
+        // Error
+        return 0;
+
+    no_mem:
+        log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+        // Clean up
+        free(keys);
+        free(lengths);
+        free(text);
+
+        // Error
+        return 0;
+}
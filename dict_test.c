@@ -12,12 +12,21 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
 #include <dict/dict.h>
+#include <dict/dict_define.h>
 #include <log/log.h>
 
 // (Un)comment for no output
 //#define BUILD_DICT_TEST_WITHOUT_TEST_OUTPUT
 
+// Type specialized dictionary, 64-bit keys to double values
+DICT_DEFINE(id_dict, uint64_t, double, dict_mix64, DICT_EQ)
+
 // Possible values
 void *A_value = (void *) 0x0000000000000001,
      *B_value = (void *) 0x0000000000000002,
@@ -66,13 +75,22 @@ int total_tests      = 0,
     ephemeral_passes = 0,
     ephemeral_fails  = 0;
 
+// Expiry clock. Zero follows the timer
+timestamp test_clock = 0;
 
 // Forward declarations
 int print_time_pretty       ( double seconds );
+unsigned long long hash_constant ( const void *const k, size_t l );
 int run_tests               ( void );
 int print_final_summary     ( void );
 int print_test              ( const char  *scenario_name, const char *test_name, bool passed );
 
+timestamp dict_test_clock   ( void );
+
+#ifdef DICT_HASH_TEST
+unsigned long long dict_hash_with_kernel ( bool sse42, const void *const k, size_t l );
+#endif
+
 bool test_add               ( int (*dict_constructor)(dict **), char  *key            , void     *value         , result_t expected );
 bool test_get               ( int (*dict_constructor)(dict **), char  *key            , void     *expected_value, result_t expected );
 bool test_key_count         ( int (*dict_constructor)(dict **), char **expected_keys  , result_t  expected );
@@ -85,6 +103,29 @@ int test_empty_dict         ( int (*dict_constructor)(dict **), char *name );
 int test_one_element_dict   ( int (*dict_constructor)(dict **), char *name, char **keys, void **values );
 int test_two_element_dict   ( int (*dict_constructor)(dict **), char *name, char **keys, void **values );
 int test_three_element_dict ( int (*dict_constructor)(dict **), char *name, char **keys, void **values );
+int test_sharded_dict       ( char *name );
+int test_replicated         ( char *name );
+int test_stats              ( char *name );
+int test_analyze            ( char *name );
+int test_hash               ( char *name );
+int test_small              ( char *name );
+int test_int_dict           ( char *name );
+int test_dict_define        ( char *name );
+int test_sized              ( char *name );
+int test_intern             ( char *name );
+int test_lru                ( char *name );
+int test_ttl                ( char *name );
+int test_memory             ( char *name );
+int test_order              ( char *name );
+int test_index              ( char *name );
+int test_set                ( char *name );
+int test_upsert             ( char *name );
+int test_atomic             ( char *name );
+int test_batch              ( char *name );
+int test_journal            ( char *name );
+int test_shm                ( char *name );
+int test_placement          ( char *name );
+int test_filter             ( char *name );
 
 int construct_empty                 ( dict **pp_dict );
 int construct_empty_addA_A          ( dict **pp_dict );
@@ -233,6 +274,77 @@ int run_tests ( void )
     // [A] -> clear() -> []
     test_empty_dict(construct_A_clear_empty, "A_clear_empty");
 
+    // Sharded [A,B,C] -> pop(B) -> [A,C]
+    test_sharded_dict("sharded");
+
+    // Replicas on nodes 0 and 2, [A,B,C] -> pop(B) -> [A,C], written on one node and read on another
+    test_replicated("replicated");
+
+    // Statistics
+    #ifdef BUILD_DICT_WITH_STATS
+        test_stats("stats");
+    #endif
+
+    // Hash quality
+    test_analyze("analyze");
+
+    // Default hash function
+    test_hash("dict_hash");
+
+    // Small dictionary -> promote -> hash table
+    test_small("small");
+
+    // Integer keys, sequential IDs, pop from the middle
+    test_int_dict("int_dict");
+
+    // Generated dictionary, values stored by value
+    test_dict_define("dict_define");
+
+    // Fixed size values stored inline
+    test_sized("sized");
+
+    // Interned strings, IDs and reverse lookup
+    test_intern("intern");
+
+    // [A,B,C] capacity 3 -> get(A) -> add(D) -> evict(B)
+    test_lru("lru");
+
+    // [A 5ms,B 5ms,C,D 1h] -> wait -> get(A) -> expire(B)
+    test_ttl("ttl");
+
+    // Memory usage by component, budget of [A,B] -> add(C) -> fail / evict(A)
+    test_memory("memory");
+
+    // [A,B,C,D] -> pop(B) -> add(B) -> [A,C,D,B], small and hashed
+    test_order("order");
+
+    // Sorted index, range and prefix cursors
+    test_index("index");
+
+    // [A,B,C] and [B,C,D] -> merge, intersect, difference
+    test_set("set");
+
+    // Counters and memoization with dict_get_or_insert and dict_update
+    test_upsert("upsert");
+
+    // Compare and swap, and counters bumped from many threads
+    test_atomic("atomic");
+
+    // [A,B,C] -> { add(D), pop(A), add(B), pop(X) } -> [B,C,D], applied all at once
+    test_batch("batch");
+
+    // [A,B,C] -> pop(B) -> add(A, X) -> restart -> [A,C], torn records and compaction
+    test_journal("journal");
+
+    // [A,B,C] -> another process pops(B), adds(D) -> [A,C,D], in place in shared memory
+    test_shm("shm");
+
+    // Huge page and NUMA backed hash tables and iterables, growing past and shrinking under 1 MiB
+    test_placement("placement");
+
+    // Membership filter over [A,B] -> add 300 -> pop half -> get, pop and copy, with counters saturated by collisions
+    test_filter("filter");
+
     // Success
     return 1;
 }
@@ -549,6 +661,1559 @@ int test_three_element_dict ( int (*dict_constructor)(dict **), char *name, char
     return 1;
 }
 
+int test_sharded_dict ( char *name )
+{
+
+    // Initialized data
+    sharded_dict *p_sharded_dict = 0;
+    const char   *keys[4]        = { 0 };
+    const void   *p_value        = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    print_test(name, "sharded_dict_construct", sharded_dict_construct(&p_sharded_dict, 4, 16, 0) == 1 );
+    print_test(name, "sharded_dict_add_A"    , sharded_dict_add(p_sharded_dict, A_key, A_value) == 1 );
+    print_test(name, "sharded_dict_add_B"    , sharded_dict_add(p_sharded_dict, B_key, B_value) == 1 );
+    print_test(name, "sharded_dict_add_C"    , sharded_dict_add(p_sharded_dict, C_key, C_value) == 1 );
+    print_test(name, "sharded_dict_get_B"    , sharded_dict_get(p_sharded_dict, B_key) == B_value );
+    print_test(name, "sharded_dict_get_X"    , sharded_dict_get(p_sharded_dict, X_key) == 0 );
+    print_test(name, "sharded_dict_key_count", sharded_dict_keys(p_sharded_dict, 0) == 3 );
+    print_test(name, "sharded_dict_pop_B"    , sharded_dict_pop(p_sharded_dict, B_key, &p_value) == 1 && p_value == B_value );
+    print_test(name, "sharded_dict_get_B"    , sharded_dict_get(p_sharded_dict, B_key) == 0 );
+    print_test(name, "sharded_dict_keys"     , sharded_dict_keys(p_sharded_dict, keys) == 1 && keys[0] && keys[1] && keys[2] == 0 );
+    print_test(name, "sharded_dict_clear"    , sharded_dict_clear(p_sharded_dict) == 1 && sharded_dict_keys(p_sharded_dict, 0) == 0 );
+    print_test(name, "sharded_dict_destroy"  , sharded_dict_destroy(&p_sharded_dict) == 1 && p_sharded_dict == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+// Keys of the replicated dictionary, shared with its reader thread
+static char replicated_keys[2048][8] = { { 0 } };
+
+void *replicated_read ( void *p_replicated_dict )
+{
+
+    // Read node 2's replica until the last key arrives
+    while ( replicated_dict_get_node(p_replicated_dict, 2, replicated_keys[2047]) == 0 ) sched_yield();
+
+    // Done
+    return 0;
+}
+
+int test_replicated ( char *name )
+{
+
+    // Initialized data
+    replicated_dict *p_replicated_dict = 0;
+    pthread_t        thread            = { 0 };
+    const char      *keys[4]           = { 0 };
+    const void      *p_value           = 0;
+    size_t           count             = sizeof(replicated_keys) / sizeof(*replicated_keys);
+    bool             found             = true;
+    char             popped[16]        = { 0 };
+
+    log_info("Scenario: %s\n", name);
+
+    // Small hash tables stay on the heap, so nodes 0 and 2 work on any machine
+    print_test(name, "replicated_dict_construct" , replicated_dict_construct(&p_replicated_dict, 16, 0x5, 0) == 1 );
+    print_test(name, "replicated_dict_add_ABC"   , replicated_dict_add(p_replicated_dict, A_key, A_value) == 1 && replicated_dict_add(p_replicated_dict, B_key, B_value) == 1 && replicated_dict_add(p_replicated_dict, C_key, C_value) == 1 );
+    print_test(name, "replicated_dict_get_B"     , replicated_dict_get(p_replicated_dict, B_key) == B_value );
+    print_test(name, "replicated_dict_get_node_2", replicated_dict_get_node(p_replicated_dict, 2, B_key) == B_value && replicated_dict_get_node(p_replicated_dict, 2, X_key) == 0 );
+    print_test(name, "replicated_dict_get_node_1", replicated_dict_get_node(p_replicated_dict, 1, C_key) == C_value );
+    print_test(name, "replicated_dict_pop_B"     , replicated_dict_pop(p_replicated_dict, B_key, &p_value) == 1 && p_value == B_value );
+    print_test(name, "replicated_dict_pop_X"     , replicated_dict_pop(p_replicated_dict, X_key, 0) == 0 );
+    print_test(name, "replicated_dict_pop_node_2", replicated_dict_get_node(p_replicated_dict, 2, B_key) == 0 && replicated_dict_get_node(p_replicated_dict, 2, A_key) == A_value );
+
+    // The pop is logged with the stored key, so the caller's copy may go before node 2 applies it
+    replicated_dict_add(p_replicated_dict, B_key, B_value);
+    snprintf(popped, sizeof(popped), "%s", B_key);
+    print_test(name, "replicated_dict_pop_copy"  , replicated_dict_pop(p_replicated_dict, popped, 0) == 1 && memset(popped, 0, sizeof(popped)) && replicated_dict_get_node(p_replicated_dict, 2, B_key) == 0 );
+    print_test(name, "replicated_dict_keys"      , replicated_dict_keys(p_replicated_dict, 0) == 2 && replicated_dict_keys(p_replicated_dict, keys) == 1 && keys[0] == A_key && keys[1] == C_key );
+    print_test(name, "replicated_dict_clear"     , replicated_dict_clear(p_replicated_dict) == 1 && replicated_dict_get_node(p_replicated_dict, 2, A_key) == 0 && replicated_dict_values(p_replicated_dict, 0) == 0 );
+
+    // Writes outrun a reader on another node, so the log fills and the writer applies it
+    for (size_t i = 0; i < count; i++) snprintf(replicated_keys[i], sizeof(replicated_keys[i]), "%zu", i);
+    pthread_create(&thread, 0, replicated_read, p_replicated_dict);
+    for (size_t i = 0; i < count; i++) replicated_dict_add(p_replicated_dict, replicated_keys[i], (void *) ( i + 1 ));
+    pthread_join(thread, 0);
+    for (size_t i = 0; i < count; i++) found &= replicated_dict_get_node(p_replicated_dict, 2, replicated_keys[i]) == (void *) ( i + 1 );
+    print_test(name, "replicated_dict_log"       , found );
+    print_test(name, "replicated_dict_sync"      , replicated_dict_sync(p_replicated_dict) == 1 && replicated_dict_get_node(p_replicated_dict, 0, replicated_keys[0]) == (void *) 1 );
+
+    print_test(name, "replicated_dict_null"      , replicated_dict_construct(0, 16, 0, 0) == 0 && replicated_dict_get(p_replicated_dict, 0) == 0 && replicated_dict_add(0, A_key, A_value) == 0 );
+    print_test(name, "replicated_dict_destroy"   , replicated_dict_destroy(&p_replicated_dict) == 1 && p_replicated_dict == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_stats ( char *name )
+{
+
+    // Initialized data
+    dict            *p_dict     = 0;
+    dict_statistics  statistics = { 0 };
+    size_t           probes     = 0,
+                     buckets    = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    // [A,B] -> add(A) -> get(A) -> get(X) -> pop(B) -> [A]
+    dict_construct(&p_dict, 4, 0);
+    memset(&statistics, 0xff, sizeof(statistics));
+    print_test(name, "dict_stats_never" , dict_stats(p_dict, &statistics) == 1 && statistics.gets == 0 && statistics.lock_acquisitions == 0 );
+    print_test(name, "dict_stats_enable", dict_stats_enable(p_dict, true) == 1 );
+    dict_add(p_dict, A_key, A_value);
+    dict_add(p_dict, B_key, B_value);
+    dict_add(p_dict, A_key, C_value);
+    dict_get(p_dict, A_key);
+    dict_get(p_dict, X_key);
+    dict_pop(p_dict, B_key, 0);
+    print_test(name, "dict_stats"       , dict_stats(p_dict, &statistics) == 1 );
+
+    // Sum the histograms
+    for (size_t i = 0; i < DICT_STATS_HISTOGRAM_SIZE; i++)
+        probes += statistics.probe_histogram[i],
+        buckets += statistics.chain_histogram[i];
+
+    print_test(name, "gets"             , statistics.gets    == 2 && statistics.hits == 1 && statistics.misses == 1 );
+    print_test(name, "adds"             , statistics.adds    == 2 );
+    print_test(name, "updates"          , statistics.updates == 1 );
+    print_test(name, "pops"             , statistics.pops    == 1 );
+    print_test(name, "probe_histogram"  , probes  == 2 );
+    print_test(name, "chain_histogram"  , buckets == 0 && statistics.buckets == 0 && statistics.entries == 1 );
+    print_test(name, "dict_stats_reset" , dict_stats_reset(p_dict) == 1 && dict_stats(p_dict, &statistics) == 1 && statistics.gets == 0 );
+
+    // Stopping keeps the counters, and starting again adds to them
+    dict_get(p_dict, A_key);
+    print_test(name, "dict_stats_stop"  , dict_stats_enable(p_dict, false) == 1 && dict_get(p_dict, A_key) == C_value && dict_stats(p_dict, &statistics) == 1 && statistics.gets == 1 );
+    print_test(name, "dict_stats_resume", dict_stats_enable(p_dict, true) == 1 && dict_get(p_dict, A_key) == C_value && dict_stats(p_dict, &statistics) == 1 && statistics.gets == 2 );
+
+    dict_destroy(&p_dict);
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+unsigned long long hash_constant ( const void *const k, size_t l )
+{
+
+    // Suppress warnings
+    (void) k;
+    (void) l;
+
+    // Every key collides
+    return 0;
+}
+
+int test_analyze ( char *name )
+{
+
+    // Initialized data
+    dict          *p_dict   = 0;
+    dict_analysis  analysis = { 0 };
+    char           keys[2 * DICT_SMALL_MAX][4] = { 0 };
+
+    log_info("Scenario: %s\n", name);
+
+    // Empty dictionary, which has no hash table yet
+    dict_construct(&p_dict, 4, 0);
+    print_test(name, "dict_analyze_empty"     , dict_analyze(p_dict, &analysis) == 1 && analysis.buckets == 0 && analysis.max_chain == 0 );
+    dict_destroy(&p_dict);
+
+    // Degenerate hash function, 2 * DICT_SMALL_MAX properties in one bucket
+    dict_construct(&p_dict, 4, hash_constant);
+    for (size_t i = 0; i < 2 * DICT_SMALL_MAX; i++)
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i),
+        dict_add(p_dict, keys[i], A_value);
+    print_test(name, "dict_analyze_degenerate", dict_analyze(p_dict, &analysis) == 1 );
+    print_test(name, "max_chain"              , analysis.max_chain == 2 * DICT_SMALL_MAX && analysis.empty_buckets == 3 );
+    print_test(name, "load_factor"            , analysis.load_factor > DICT_SMALL_MAX / 2.0 - 0.01 && analysis.load_factor < DICT_SMALL_MAX / 2.0 + 0.01 );
+    print_test(name, "uniformity"             , analysis.uniformity > 2.0 * DICT_SMALL_MAX - 0.01 && analysis.uniformity < 2.0 * DICT_SMALL_MAX + 0.01 );
+    print_test(name, "dict_analyze_(null)"    , dict_analyze(p_dict, 0) == 0 );
+    dict_destroy(&p_dict);
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_hash ( char *name )
+{
+
+    log_info("Scenario: %s\n", name);
+
+    // The result is documented, and must not depend on the kernel
+    print_test(name, "dict_hash_empty"       , dict_hash("", 0) == 0x9E69316645315758ULL );
+    print_test(name, "dict_hash_A"           , dict_hash(A_key, 1) == 0x73EF7DA574293A97ULL );
+    print_test(name, "dict_hash_Hello, world", dict_hash("Hello, world", 12) == 0xE3839EB79CEAD530ULL );
+
+    #ifdef DICT_HASH_TEST
+    {
+
+        // Initialized data
+        unsigned char bytes[80] = { 0 };
+        bool          same      = true;
+
+        // Fill with a fixed pseudo random sequence
+        for (size_t i = 0, x = 1; i < sizeof(bytes); i++) x = x * 6364136223846793005ULL + 1442695040888963407ULL, bytes[i] = (unsigned char) ( x >> 56 );
+
+        // Every length up to 64, at every alignment in a word, covers each tail piece
+        for (size_t offset = 0; offset < 8; offset++)
+            for (size_t l = 0; l <= 64; l++)
+                same &= dict_hash_with_kernel(true, bytes + offset, l) == dict_hash_with_kernel(false, bytes + offset, l);
+
+        print_test(name, "dict_hash_kernels"     , same && dict_hash_with_kernel(false, "Hello, world", 12) == 0xE3839EB79CEAD530ULL );
+    }
+    #endif
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_small ( char *name )
+{
+
+    // Initialized data
+    dict          *p_dict   = 0,
+                  *p_copy   = 0;
+    dict_analysis  analysis = { 0 };
+    char           keys[DICT_SMALL_MAX + 1][4] = { 0 };
+    const char    *iterable[DICT_SMALL_MAX + 1] = { 0 };
+    bool           found    = true;
+
+    log_info("Scenario: %s\n", name);
+
+    // Fill the inline properties
+    dict_construct(&p_dict, 16, 0);
+    for (size_t i = 0; i < DICT_SMALL_MAX; i++)
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i),
+        dict_add(p_dict, keys[i], (void *) (i + 1));
+    snprintf(keys[DICT_SMALL_MAX], sizeof(keys[DICT_SMALL_MAX]), "k%d", DICT_SMALL_MAX);
+
+    print_test(name, "small_layout"   , dict_analyze(p_dict, &analysis) == 1 && analysis.buckets == 0 && analysis.entries == DICT_SMALL_MAX );
+    print_test(name, "small_update"   , dict_add(p_dict, keys[0], (void *) 1) == 1 && dict_keys(p_dict, 0) == DICT_SMALL_MAX );
+    print_test(name, "small_copy"     , dict_copy(p_dict, &p_copy) == 1 && dict_get(p_copy, keys[DICT_SMALL_MAX - 1]) == (void *) DICT_SMALL_MAX );
+    dict_destroy(&p_copy);
+
+    // One more property moves them into the hash table
+    print_test(name, "promote"        , dict_add(p_dict, keys[DICT_SMALL_MAX], (void *) (DICT_SMALL_MAX + 1)) == 1 );
+    print_test(name, "promoted_layout", dict_analyze(p_dict, &analysis) == 1 && analysis.buckets == 16 && analysis.entries == DICT_SMALL_MAX + 1 );
+
+    // Every property survives the move
+    for (size_t i = 0; i <= DICT_SMALL_MAX; i++)
+        found &= dict_get(p_dict, keys[i]) == (void *) (i + 1);
+
+    print_test(name, "promoted_get"   , found );
+    print_test(name, "promoted_keys"  , dict_keys(p_dict, iterable) == 1 && iterable[DICT_SMALL_MAX] != 0 );
+    print_test(name, "promoted_copy"  , dict_copy(p_dict, &p_copy) == 1 && dict_get(p_copy, keys[DICT_SMALL_MAX]) == (void *) (DICT_SMALL_MAX + 1) );
+    dict_destroy(&p_copy);
+
+    // Popping back below the limit does not demote
+    print_test(name, "pop"            , dict_pop(p_dict, keys[0], 0) == 1 && dict_pop(p_dict, keys[1], 0) == 1 && dict_get(p_dict, keys[1]) == 0 );
+    print_test(name, "stays_promoted" , dict_analyze(p_dict, &analysis) == 1 && analysis.buckets == 16 );
+    print_test(name, "clear"          , dict_clear(p_dict) == 1 && dict_keys(p_dict, 0) == 0 );
+    print_test(name, "destroy"        , dict_destroy(&p_dict) == 1 && p_dict == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_int_dict ( char *name )
+{
+
+    // Initialized data
+    int_dict    *p_int_dict = 0;
+    uint64_t     keys[64]   = { 0 };
+    const void  *p_value    = 0;
+    bool         found      = true;
+
+    log_info("Scenario: %s\n", name);
+
+    print_test(name, "int_dict_construct", int_dict_construct(&p_int_dict, 16) == 1 );
+
+    // Add more IDs than buckets, so chains form
+    for (uint64_t i = 0; i < 64; i++)
+        found &= int_dict_add(p_int_dict, i, (void *) (i + 1)) == 1;
+
+    print_test(name, "int_dict_add"      , found );
+    print_test(name, "int_dict_update"   , int_dict_add(p_int_dict, 0, A_value) == 1 && int_dict_get(p_int_dict, 0) == A_value );
+    print_test(name, "int_dict_get_X"    , int_dict_get(p_int_dict, UINT64_MAX) == 0 );
+    print_test(name, "int_dict_key_count", int_dict_keys(p_int_dict, 0) == 64 );
+    print_test(name, "int_dict_pop_31"   , int_dict_pop(p_int_dict, 31, &p_value) == 1 && p_value == (void *) 32 );
+    print_test(name, "int_dict_pop_X"    , int_dict_pop(p_int_dict, 31, 0) == 0 );
+
+    // Every other ID survives the pop
+    found = true;
+    for (uint64_t i = 1; i < 64; i++)
+        if ( i != 31 ) found &= int_dict_get(p_int_dict, i) == (void *) (i + 1);
+
+    print_test(name, "int_dict_get"      , found );
+    print_test(name, "int_dict_keys"     , int_dict_keys(p_int_dict, keys) == 1 && keys[31] == 63 && keys[62] == 62 );
+    print_test(name, "int_dict_clear"    , int_dict_clear(p_int_dict) == 1 && int_dict_keys(p_int_dict, 0) == 0 && int_dict_get(p_int_dict, 1) == 0 );
+    print_test(name, "int_dict_destroy"  , int_dict_destroy(&p_int_dict) == 1 && p_int_dict == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void id_dict_double ( double *p_value, size_t i )
+{
+
+    // Suppress warnings
+    (void) i;
+
+    // Double the value in place
+    *p_value *= 2.0;
+}
+
+int test_dict_define ( char *name )
+{
+
+    // Initialized data
+    id_dict  *p_id_dict  = 0;
+    uint64_t  keys[32]   = { 0 };
+    double    values[32] = { 0 },
+              value      = 0.0;
+    bool      found      = true;
+
+    log_info("Scenario: %s\n", name);
+
+    print_test(name, "id_dict_construct", id_dict_construct(&p_id_dict, 8) == 1 );
+
+    // Add more IDs than buckets, so chains form
+    for (uint64_t i = 0; i < 32; i++)
+        found &= id_dict_add(p_id_dict, i, 0.5 * (double) i) == 1;
+
+    print_test(name, "id_dict_add"      , found );
+    print_test(name, "id_dict_get"      , id_dict_get(p_id_dict, 7, &value) == 1 && value > 3.49 && value < 3.51 );
+    print_test(name, "id_dict_get_X"    , id_dict_get(p_id_dict, UINT64_MAX, &value) == 0 );
+    print_test(name, "id_dict_pop_7"    , id_dict_pop(p_id_dict, 7, &value) == 1 && id_dict_get(p_id_dict, 7, 0) == 0 );
+    print_test(name, "id_dict_foreach"  , id_dict_foreach(p_id_dict, id_dict_double) == 1 && id_dict_get(p_id_dict, 31, &value) == 1 && value > 30.99 && value < 31.01 );
+    print_test(name, "id_dict_keys"     , id_dict_keys(p_id_dict, 0) == 31 && id_dict_keys(p_id_dict, keys) == 1 && keys[7] == 31 );
+    print_test(name, "id_dict_values"   , id_dict_values(p_id_dict, values) == 1 && values[7] > 30.99 && values[7] < 31.01 );
+    print_test(name, "id_dict_clear"    , id_dict_clear(p_id_dict) == 1 && id_dict_keys(p_id_dict, 0) == 0 );
+    print_test(name, "id_dict_destroy"  , id_dict_destroy(&p_id_dict) == 1 && p_id_dict == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_sized ( char *name )
+{
+
+    // Initialized data
+    struct point_s { double x, y; int id; };
+    dict           *p_dict  = 0,
+                   *p_copy  = 0;
+    struct point_s  point   = { 1.0, 2.0, 1 },
+                   *p_point = 0;
+    const void     *p_value = 0;
+    bool            found   = true;
+    char            keys[2 * DICT_SMALL_MAX][4] = { 0 };
+
+    log_info("Scenario: %s\n", name);
+
+    print_test(name, "dict_construct_sized"  , dict_construct_sized(&p_dict, 4, sizeof(point), 0) == 1 );
+    print_test(name, "dict_construct_sized_0", dict_construct_sized(&p_copy, 4, 0, 0) == 0 );
+
+    // The value is copied in
+    print_test(name, "dict_add_A"            , dict_add(p_dict, A_key, &point) == 1 );
+    point.id = 2;
+    p_point  = (void *) dict_get(p_dict, A_key);
+    print_test(name, "dict_get_A"            , p_point && p_point != (void *) &point && p_point->id == 1 && p_point->y > 1.99 );
+
+    // An update copies over the same storage
+    print_test(name, "dict_update_A"         , dict_add(p_dict, A_key, &point) == 1 && dict_get(p_dict, A_key) == p_point && p_point->id == 2 );
+    print_test(name, "dict_add_B_zero"       , dict_add(p_dict, B_key, 0) == 1 && ((struct point_s *) dict_get(p_dict, B_key))->id == 0 );
+
+    // Enough properties for chains and an iterable resize
+    for (size_t i = 0; i < 2 * DICT_SMALL_MAX; i++)
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i),
+        point.id = (int) i,
+        found &= dict_add(p_dict, keys[i], &point) == 1;
+
+    print_test(name, "dict_add_many"         , found );
+    print_test(name, "dict_copy"             , dict_copy(p_dict, &p_copy) == 1 && dict_get(p_copy, A_key) != p_point && ((struct point_s *) dict_get(p_copy, keys[5]))->id == 5 );
+    print_test(name, "dict_pop_value"        , dict_pop(p_dict, A_key, &p_value) == 0 );
+    print_test(name, "dict_pop_A"            , dict_pop(p_dict, A_key, 0) == 1 && dict_get(p_dict, A_key) == 0 && dict_get(p_copy, A_key) != 0 );
+
+    // Every value still matches its key
+    found = true;
+    for (size_t i = 0; i < 2 * DICT_SMALL_MAX; i++)
+        found &= ((struct point_s *) dict_get(p_copy, keys[i]))->id == (int) i && ((struct point_s *) dict_get(p_dict, keys[i]))->id == (int) i;
+
+    print_test(name, "dict_get_many"         , found );
+    print_test(name, "dict_destroy"          , dict_destroy(&p_dict) == 1 && dict_destroy(&p_copy) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_intern ( char *name )
+{
+
+    // Initialized data
+    intern_table *p_intern_table = 0;
+    char          buffer[4]      = { 0 };
+    const char   *p_A            = 0,
+                 *p_string       = 0;
+    size_t        id             = 0;
+    bool          found          = true;
+
+    log_info("Scenario: %s\n", name);
+
+    print_test(name, "intern_table_construct", intern_table_construct(&p_intern_table, 4) == 1 );
+    print_test(name, "intern_A"              , intern_table_intern(p_intern_table, A_key, &id, &p_A) == 1 && id == 0 && p_A != A_key && strcmp(p_A, A_key) == 0 );
+    print_test(name, "intern_B"              , intern_table_intern(p_intern_table, B_key, &id, 0) == 1 && id == 1 );
+
+    // A different pointer to an equal string gets the same ID and canonical string
+    buffer[0] = 'A';
+    print_test(name, "intern_A_again"        , intern_table_intern(p_intern_table, buffer, &id, &p_string) == 1 && id == 0 && p_string == p_A );
+
+    // Enough strings to outgrow the small dictionary
+    for (size_t i = 0; i < 2 * DICT_SMALL_MAX; i++)
+        snprintf(buffer, sizeof(buffer), "k%zu", i),
+        found &= intern_table_intern(p_intern_table, buffer, &id, 0) == 1 && id == i + 2;
+
+    print_test(name, "intern_many"           , found );
+    print_test(name, "intern_table_find"     , intern_table_find(p_intern_table, "k3", &id) == 1 && id == 5 );
+    print_test(name, "intern_table_find_X"   , intern_table_find(p_intern_table, X_key, 0) == 0 );
+    print_test(name, "intern_table_string"   , intern_table_string(p_intern_table, 0) == p_A && strcmp(intern_table_string(p_intern_table, 5), "k3") == 0 );
+    print_test(name, "intern_table_string_X" , intern_table_string(p_intern_table, 2 * DICT_SMALL_MAX + 2) == 0 );
+    print_test(name, "intern_table_count"    , intern_table_count(p_intern_table) == 2 * DICT_SMALL_MAX + 2 );
+    print_test(name, "intern_table_destroy"  , intern_table_destroy(&p_intern_table) == 1 && p_intern_table == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+// The most recently evicted property
+const char *evicted_key   = 0;
+void       *evicted_value = 0;
+
+void lru_evict ( const char *const key, void *const value )
+{
+
+    // Store the property
+    evicted_key   = key;
+    evicted_value = value;
+}
+
+int test_lru ( char *name )
+{
+
+    // Initialized data
+    dict *p_dict = 0,
+         *p_copy = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    print_test(name, "dict_construct_lru"  , dict_construct_lru(&p_dict, 4, 3, lru_evict, 0) == 1 );
+    print_test(name, "dict_construct_lru_0", dict_construct_lru(&p_copy, 4, 0, lru_evict, 0) == 0 );
+    dict_add(p_dict, A_key, A_value);
+    dict_add(p_dict, B_key, B_value);
+    dict_add(p_dict, C_key, C_value);
+    print_test(name, "under_capacity"      , evicted_key == 0 && dict_keys(p_dict, 0) == 3 );
+
+    // A is used, so B is the least recently used
+    dict_get(p_dict, A_key);
+    print_test(name, "evict_B"             , dict_add(p_dict, D_key, D_value) == 1 && evicted_key == B_key && evicted_value == B_value );
+    print_test(name, "dict_get_B"          , dict_get(p_dict, B_key) == 0 && dict_keys(p_dict, 0) == 3 );
+
+    // Updating C marks it as used, so A is the least recently used
+    dict_add(p_dict, C_key, X_value);
+    print_test(name, "evict_A"             , dict_add(p_dict, B_key, B_value) == 1 && evicted_key == A_key );
+
+    // A copy keeps the order, so D is the least recently used
+    print_test(name, "dict_copy"           , dict_copy(p_dict, &p_copy) == 1 && dict_add(p_copy, A_key, A_value) == 1 && evicted_key == D_key );
+
+    // [B,C,D] -> pop(C) -> add(A) -> [A,B,D]
+    evicted_key = 0;
+    print_test(name, "dict_pop_C"          , dict_pop(p_dict, C_key, 0) == 1 && dict_add(p_dict, A_key, A_value) == 1 && evicted_key == 0 );
+    print_test(name, "dict_add_C"          , dict_add(p_dict, C_key, C_value) == 1 && evicted_key == D_key && dict_get(p_dict, D_key) == 0 );
+    print_test(name, "dict_clear"          , dict_clear(p_dict) == 1 && dict_add(p_dict, A_key, A_value) == 1 && dict_keys(p_dict, 0) == 1 );
+    print_test(name, "dict_destroy"        , dict_destroy(&p_dict) == 1 && dict_destroy(&p_copy) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+timestamp dict_test_clock ( void )
+{
+
+    // Done
+    return ( test_clock ) ? test_clock : timer_high_precision();
+}
+
+void ttl_wait ( timestamp ttl )
+{
+
+    // Initialized data
+    timestamp until = timer_high_precision() + ttl;
+
+    // Spin
+    while ( timer_high_precision() < until );
+}
+
+void *expire_starter ( void *p_parameter )
+{
+
+    // Start the expiry thread, and return whether this call started it
+    return (void *) (intptr_t) dict_expire_start(p_parameter, timer_seconds_divisor() / 1000, 0);
+}
+
+int test_ttl ( char *name )
+{
+
+    // Initialized data
+    dict        *p_dict     = 0,
+                *p_copy     = 0;
+    timestamp    ms         = timer_seconds_divisor() / 1000,
+                 hour       = timer_seconds_divisor() * 3600;
+    pthread_t    threads[4] = { 0 };
+    void        *p_started  = 0;
+    size_t       started    = 0;
+    long long    value      = 7;
+    const void  *p_value    = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    // Drive the expiry clock by hand
+    test_clock = hour;
+
+    evicted_key = 0;
+    print_test(name, "dict_construct"      , dict_construct(&p_dict, 4, 0) == 1 && dict_on_evict(p_dict, lru_evict) == 1 );
+    print_test(name, "dict_add_ttl_0"      , dict_add_ttl(p_dict, A_key, A_value, 0) == 0 );
+    print_test(name, "dict_add_ttl"        , dict_add_ttl(p_dict, A_key, A_value, 5 * ms) == 1 && dict_add_ttl(p_dict, B_key, B_value, 5 * ms) == 1 );
+    dict_add(p_dict, C_key, C_value);
+    dict_add_ttl(p_dict, D_key, D_value, hour);
+    print_test(name, "dict_get_A"          , dict_get(p_dict, A_key) == A_value && dict_keys(p_dict, 0) == 4 );
+
+    // Expired properties are counted until they are removed
+    test_clock += 10 * ms;
+    print_test(name, "dict_keys_expired"   , dict_keys(p_dict, 0) == 4 );
+    print_test(name, "dict_get_A_expired"  , dict_get(p_dict, A_key) == 0 && evicted_key == A_key && dict_keys(p_dict, 0) == 3 );
+    print_test(name, "dict_expire_B"       , dict_expire(p_dict, 0) == 1 && evicted_key == B_key && dict_keys(p_dict, 0) == 2 );
+    print_test(name, "dict_expire_none"    , dict_expire(p_dict, 0) == 0 && dict_get(p_dict, D_key) == D_value );
+
+    // An expired property can not be popped
+    evicted_key = 0;
+    dict_add_ttl(p_dict, A_key, A_value, 5 * ms);
+    test_clock += 10 * ms;
+    print_test(name, "dict_pop_expired"    , dict_pop(p_dict, A_key, 0) == 0 && evicted_key == A_key && dict_keys(p_dict, 0) == 2 );
+
+    // A plain add clears the expiry
+    dict_add_ttl(p_dict, C_key, C_value, 5 * ms);
+    dict_add(p_dict, C_key, X_value);
+    test_clock += 10 * ms;
+    print_test(name, "dict_add_clears_ttl" , dict_expire(p_dict, 0) == 0 && dict_get(p_dict, C_key) == X_value );
+
+    // A popped property is no longer scheduled
+    dict_add_ttl(p_dict, A_key, A_value, 5 * ms);
+    print_test(name, "dict_pop_ttl"        , dict_pop(p_dict, A_key, 0) == 1 );
+    test_clock += 10 * ms;
+    print_test(name, "dict_expire_popped"  , dict_expire(p_dict, 0) == 0 && dict_keys(p_dict, 0) == 2 );
+
+    // A copy keeps the expiry
+    dict_add_ttl(p_dict, A_key, A_value, 5 * ms);
+    print_test(name, "dict_copy"           , dict_copy(p_dict, &p_copy) == 1 && dict_keys(p_copy, 0) == 3 );
+    test_clock += 10 * ms;
+    print_test(name, "dict_copy_expire"    , dict_expire(p_copy, 0) == 1 && dict_keys(p_copy, 0) == 2 );
+
+    // The background thread removes A from the original
+    print_test(name, "dict_expire_start"   , dict_expire_start(p_dict, ms, 0) == 1 && dict_expire_start(p_dict, ms, 0) == 0 );
+    for (size_t i = 0; i < 1000 && dict_keys(p_dict, 0) > 2; i++) ttl_wait(ms);
+    print_test(name, "dict_expire_stop"    , dict_expire_stop(p_dict) == 1 && dict_keys(p_dict, 0) == 2 );
+
+    // A running thread is stopped by dict_destroy
+    dict_add_ttl(p_dict, B_key, B_value, 5 * ms);
+    dict_expire_start(p_dict, ms, 0);
+    print_test(name, "dict_clear"          , dict_clear(p_dict) == 1 && dict_expire(p_dict, 0) == 0 );
+    print_test(name, "dict_destroy"        , dict_destroy(&p_dict) == 1 && dict_destroy(&p_copy) == 1 );
+
+    // Of concurrent starters, one starts the thread
+    dict_construct(&p_dict, 4, 0);
+    for (size_t i = 0; i < 4; i++) pthread_create(&threads[i], 0, expire_starter, p_dict);
+    for (size_t i = 0; i < 4; i++) pthread_join(threads[i], &p_started), started += (size_t) (intptr_t) p_started;
+    print_test(name, "dict_expire_start_race", started == 1 && dict_expire_stop(p_dict) == 1 && dict_expire_start(p_dict, ms, 0) == 1 );
+    dict_destroy(&p_dict);
+
+    // Inline values never move, so a populated dictionary can not take its first expiry
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    dict_add(p_dict, A_key, &value);
+    p_value = dict_get(p_dict, A_key);
+    print_test(name, "dict_add_ttl_sized"  , dict_add_ttl(p_dict, B_key, &value, hour) == 0 && dict_expire_start(p_dict, ms, 0) == 0 && dict_get(p_dict, A_key) == p_value && dict_get(p_dict, B_key) == 0 );
+    dict_destroy(&p_dict);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    dict_add_ttl(p_dict, B_key, &value, hour);
+    print_test(name, "dict_add_ttl_sized_first", dict_add(p_dict, A_key, &value) == 1 && dict_add_ttl(p_dict, C_key, &value, hour) == 1 && *(const long long *) dict_get(p_dict, C_key) == 7 );
+    dict_destroy(&p_dict);
+
+    // A property that expires in the next round of the top level is not late
+    test_clock = ( ( (timestamp) 1 << 24 ) - 5 ) * ms;
+    dict_construct(&p_dict, 4, 0);
+    dict_add_ttl(p_dict, A_key, A_value, 10 * ms);
+    test_clock += 11 * ms;
+    print_test(name, "dict_expire_round"   , dict_expire(p_dict, 0) == 1 && dict_keys(p_dict, 0) == 0 );
+    dict_destroy(&p_dict);
+
+    // Follow the timer again
+    test_clock = 0;
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_memory ( char *name )
+{
+
+    // Initialized data
+    dict          *p_dict         = 0,
+                  *p_probe        = 0;
+    intern_table  *p_intern_table = 0;
+    dict_memory    memory         = { 0 },
+                   probe          = { 0 };
+    size_t         node           = 0;
+    const void    *p_value        = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    // A small dictionary is only the struct
+    print_test(name, "dict_memory_usage_small", dict_construct(&p_dict, 16, 0) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.buckets == 0 && memory.nodes == 0 && memory.total == memory.dict );
+    print_test(name, "dict_memory_usage_null" , dict_memory_usage(p_dict, 0) == 0 && dict_memory_usage(0, &memory) == 0 );
+
+    // Outgrow the small layout
+    for (size_t i = 0; i < DICT_SMALL_MAX + 1; i++)
+    {
+        char *keys[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16" };
+        dict_add(p_dict, keys[i], A_value);
+    }
+    dict_memory_usage(p_dict, &memory);
+    print_test(name, "dict_memory_usage_hash" , memory.buckets == 16 * sizeof(void *) && memory.nodes % ( DICT_SMALL_MAX + 1 ) == 0 && memory.iterables > 0 && memory.keys == 0 );
+    print_test(name, "dict_memory_usage_total", memory.total == memory.dict + memory.buckets + memory.nodes + memory.iterables + memory.keys + memory.wheel );
+
+    // Plain properties carry no recency, expiry or index links
+    node = memory.nodes / ( DICT_SMALL_MAX + 1 );
+    print_test(name, "dict_memory_usage_node" , node <= 5 * sizeof(void *) );
+
+    // The index and expiries add links to every property, which keep their values
+    print_test(name, "dict_memory_usage_index", dict_index_enable(p_dict, true) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.nodes > node * ( DICT_SMALL_MAX + 1 ) && dict_get(p_dict, "7") == A_value );
+    node = memory.nodes / ( DICT_SMALL_MAX + 1 );
+    print_test(name, "dict_memory_usage_ttl"  , dict_add_ttl(p_dict, "16", B_value, 60 * timer_seconds_divisor()) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.nodes > node * ( DICT_SMALL_MAX + 1 ) && dict_get(p_dict, "16") == B_value && dict_get(p_dict, "0") == A_value );
+
+    // Dropping the index drops its links
+    node = memory.nodes;
+    print_test(name, "dict_memory_usage_drop" , dict_index_enable(p_dict, false) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.nodes < node && dict_get(p_dict, "16") == B_value && dict_keys(p_dict, 0) == DICT_SMALL_MAX + 2 );
+    dict_destroy(&p_dict);
+
+    // Inline values never move, so a populated dictionary can not take the index
+    dict_construct_sized(&p_dict, 16, sizeof(size_t), 0);
+    for (size_t i = 0; i < DICT_SMALL_MAX + 1; i++)
+    {
+        char *keys[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16" };
+        dict_add(p_dict, keys[i], &i);
+    }
+    p_value = dict_get(p_dict, "8");
+    print_test(name, "dict_memory_relayout_sized", dict_index_enable(p_dict, true) == 0 && dict_get(p_dict, "8") == p_value && *(const size_t *) p_value == 8 );
+    dict_destroy(&p_dict);
+
+    // An empty one takes it, and keeps the links when it is dropped
+    dict_construct_sized(&p_dict, 16, sizeof(size_t), 0);
+    dict_index_enable(p_dict, true);
+    for (size_t i = 0; i < DICT_SMALL_MAX + 1; i++)
+    {
+        char *keys[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16" };
+        dict_add(p_dict, keys[i], &i);
+    }
+    p_value = dict_get(p_dict, "8");
+    print_test(name, "dict_memory_index_sized"   , dict_index_enable(p_dict, false) == 1 && dict_get(p_dict, "8") == p_value && dict_index_enable(p_dict, true) == 1 && dict_get(p_dict, "8") == p_value && *(const size_t *) p_value == 8 );
+    dict_destroy(&p_dict);
+
+    // Measure [A,B] with no limit
+    print_test(name, "dict_construct_budget_0", dict_construct_budget(&p_probe, 4, 0, 0, 0) == 0 && dict_construct_budget(&p_probe, 4, 1, 0, 0) == 0 );
+    dict_construct_budget(&p_probe, 4, SIZE_MAX, 0, 0);
+    dict_add(p_probe, A_key, A_value);
+    dict_add(p_probe, B_key, B_value);
+    dict_memory_usage(p_probe, &probe);
+
+    // Fail fast
+    print_test(name, "dict_construct_budget"  , dict_construct_budget(&p_dict, 4, probe.total, 0, 0) == 1 );
+    print_test(name, "dict_add_in_budget"     , dict_add(p_dict, A_key, A_value) == 1 && dict_add(p_dict, B_key, B_value) == 1 );
+    print_test(name, "dict_add_over_budget"   , dict_add(p_dict, C_key, C_value) == 0 && dict_get(p_dict, C_key) == 0 && dict_keys(p_dict, 0) == 2 );
+    print_test(name, "dict_update_in_budget"  , dict_add(p_dict, A_key, X_value) == 1 && dict_get(p_dict, A_key) == X_value );
+    print_test(name, "dict_memory_usage"      , dict_memory_usage(p_dict, &memory) == 1 && memory.total == probe.total );
+    dict_destroy(&p_dict);
+
+    // Evict the least recently used
+    evicted_key = 0;
+    print_test(name, "dict_construct_evict"   , dict_construct_budget(&p_dict, 4, probe.total, lru_evict, 0) == 1 );
+    dict_add(p_dict, A_key, A_value);
+    dict_add(p_dict, B_key, B_value);
+    print_test(name, "dict_add_evict_A"       , dict_add(p_dict, C_key, C_value) == 1 && evicted_key == A_key && dict_keys(p_dict, 0) == 2 );
+
+    // B is used, so C is the next to go. Evicting A shrank the iterables, so it may take a few adds
+    dict_get(p_dict, B_key);
+    evicted_key = 0;
+    for (size_t i = 0; i < 8 && evicted_key == 0; i++)
+    {
+        char *keys[] = { "0", "1", "2", "3", "4", "5", "6", "7" };
+        dict_add(p_dict, keys[i], D_value);
+    }
+    print_test(name, "dict_add_evict_C"       , evicted_key == C_key && dict_get(p_dict, B_key) == B_value );
+    print_test(name, "dict_memory_in_budget"  , dict_memory_usage(p_dict, &memory) == 1 && memory.total <= probe.total );
+    print_test(name, "dict_destroy"           , dict_destroy(&p_dict) == 1 && dict_destroy(&p_probe) == 1 );
+
+    // Intern tables own their strings
+    intern_table_construct(&p_intern_table, 4);
+    intern_table_intern(p_intern_table, "abc", 0, 0);
+    intern_table_intern(p_intern_table, "de", 0, 0);
+    print_test(name, "intern_table_memory"    , intern_table_memory_usage(p_intern_table, &memory) == 1 && memory.keys == 7 && memory.total == memory.dict + memory.buckets + memory.nodes + memory.iterables + memory.keys + memory.wheel );
+    intern_table_destroy(&p_intern_table);
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool keys_are ( dict *p_dict, const char **expected, size_t count )
+{
+
+    // Initialized data
+    const char *keys[16] = { 0 };
+
+    // Check the count
+    if ( dict_keys(p_dict, 0) != count ) return false;
+
+    // Check the order
+    dict_keys(p_dict, keys);
+    for (size_t i = 0; i < count; i++)
+        if ( strcmp(keys[i], expected[i]) ) return false;
+
+    // Success
+    return true;
+}
+
+int test_order ( char *name )
+{
+
+    // Initialized data
+    dict       *p_dict  = 0,
+               *p_copy  = 0;
+    const char *keys[]  = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11" };
+    void       *values[4] = { 0 };
+
+    log_info("Scenario: %s\n", name);
+
+    // Small dictionaries shift down over a pop
+    dict_construct(&p_dict, 4, 0);
+    dict_add(p_dict, A_key, A_value);
+    dict_add(p_dict, B_key, B_value);
+    dict_add(p_dict, C_key, C_value);
+    dict_add(p_dict, D_key, D_value);
+    print_test(name, "small_pop_B"         , dict_pop(p_dict, B_key, 0) == 1 && keys_are(p_dict, (const char *[]) { "A", "C", "D" }, 3) );
+    print_test(name, "small_add_B"         , dict_add(p_dict, B_key, B_value) == 1 && keys_are(p_dict, (const char *[]) { "A", "C", "D", "B" }, 4) );
+    print_test(name, "small_update_A"      , dict_add(p_dict, A_key, X_value) == 1 && keys_are(p_dict, (const char *[]) { "A", "C", "D", "B" }, 4) );
+    print_test(name, "small_values"        , dict_values(p_dict, values) == 1 && values[0] == X_value && values[1] == C_value && values[3] == B_value );
+    dict_destroy(&p_dict);
+
+    // Hashed dictionaries leave tombstones
+    dict_construct(&p_dict, 4, 0);
+    for (size_t i = 0; i < 12; i++) dict_add(p_dict, keys[i], A_value);
+    dict_pop(p_dict, keys[0], 0);
+    dict_pop(p_dict, keys[5], 0);
+    dict_pop(p_dict, keys[11], 0);
+    print_test(name, "hash_pop"            , keys_are(p_dict, (const char *[]) { "1", "2", "3", "4", "6", "7", "8", "9", "10" }, 9) );
+    print_test(name, "hash_add"            , dict_add(p_dict, keys[0], A_value) == 1 && keys_are(p_dict, (const char *[]) { "1", "2", "3", "4", "6", "7", "8", "9", "10", "0" }, 10) );
+
+    // Compaction keeps the order
+    for (size_t i = 1; i < 9; i++) if ( i != 5 ) dict_pop(p_dict, keys[i], 0);
+    print_test(name, "hash_compact"        , keys_are(p_dict, (const char *[]) { "9", "10", "0" }, 3) && dict_get(p_dict, keys[10]) == A_value );
+    print_test(name, "dict_copy"           , dict_copy(p_dict, &p_copy) == 1 && keys_are(p_copy, (const char *[]) { "9", "10", "0" }, 3) );
+    print_test(name, "dict_destroy"        , dict_destroy(&p_dict) == 1 && dict_destroy(&p_copy) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool cursor_is ( dict_cursor *p_cursor, const char **expected, size_t count )
+{
+
+    // Initialized data
+    const char *key = 0;
+    size_t      i   = 0;
+
+    // Walk the cursor
+    while ( dict_cursor_next(p_cursor, &key, 0) )
+        if ( i >= count || strcmp(key, expected[i++]) ) return dict_cursor_close(p_cursor), false;
+
+    // Check the count
+    return i == count;
+}
+
+int test_index ( char *name )
+{
+
+    // Initialized data
+    dict        *p_dict = 0,
+                *p_copy = 0;
+    dict_cursor  cursor = { 0 };
+    const char  *keys[] = { "cherry", "band", "apple", "bandana", "apricot", "banana" };
+    const void  *value  = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    dict_construct(&p_dict, 4, 0);
+    for (size_t i = 0; i < 6; i++) dict_add(p_dict, keys[i], A_value);
+    print_test(name, "dict_range_no_index" , dict_range(p_dict, 0, 0, &cursor) == 0 );
+    print_test(name, "dict_index_enable"   , dict_index_enable(p_dict, true) == 1 );
+
+    // Full scan, in key order
+    dict_range(p_dict, 0, 0, &cursor);
+    print_test(name, "dict_range_all"      , cursor_is(&cursor, (const char *[]) { "apple", "apricot", "banana", "band", "bandana", "cherry" }, 6) );
+
+    // Half open ranges
+    dict_range(p_dict, "b", "c", &cursor);
+    print_test(name, "dict_range_b_c"      , cursor_is(&cursor, (const char *[]) { "banana", "band", "bandana" }, 3) );
+    dict_range(p_dict, "apricot", "band", &cursor);
+    print_test(name, "dict_range_exclusive", cursor_is(&cursor, (const char *[]) { "apricot", "banana" }, 2) );
+    dict_range(p_dict, "d", 0, &cursor);
+    print_test(name, "dict_range_empty"    , cursor_is(&cursor, 0, 0) );
+
+    // Prefixes
+    dict_prefix(p_dict, "ap", &cursor);
+    print_test(name, "dict_prefix_ap"      , cursor_is(&cursor, (const char *[]) { "apple", "apricot" }, 2) );
+    dict_prefix(p_dict, "band", &cursor);
+    print_test(name, "dict_prefix_band"    , cursor_is(&cursor, (const char *[]) { "band", "bandana" }, 2) );
+
+    // The index follows adds and pops
+    dict_pop(p_dict, "band", 0);
+    dict_add(p_dict, "bane", B_value);
+    dict_prefix(p_dict, "ban", &cursor);
+    print_test(name, "dict_prefix_ban"     , cursor_is(&cursor, (const char *[]) { "banana", "bandana", "bane" }, 3) );
+
+    // Closing early unlocks the dictionary
+    dict_prefix(p_dict, "bane", &cursor);
+    print_test(name, "dict_cursor_value"   , dict_cursor_next(&cursor, 0, &value) == true && value == B_value );
+    print_test(name, "dict_cursor_close"   , dict_cursor_close(&cursor) == 1 && dict_cursor_close(&cursor) == 1 && dict_add(p_dict, "date", A_value) == 1 );
+
+    // Copies keep the index
+    print_test(name, "dict_copy"           , dict_copy(p_dict, &p_copy) == 1 && dict_range(p_copy, "c", 0, &cursor) == 1 && cursor_is(&cursor, (const char *[]) { "cherry", "date" }, 2) );
+    print_test(name, "dict_index_disable"  , dict_index_enable(p_dict, false) == 1 && dict_range(p_dict, 0, 0, &cursor) == 0 );
+    print_test(name, "dict_destroy"        , dict_destroy(&p_dict) == 1 && dict_destroy(&p_copy) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void *set_conflict ( const char *const key, void *const value, void *const other_value )
+{
+
+    // Suppress warnings
+    (void) key;
+
+    // Add the values
+    return (void *) ( (size_t) value + (size_t) other_value );
+}
+
+int test_set ( char *name )
+{
+
+    // Initialized data
+    dict *p_abc    = 0,
+         *p_bcd    = 0,
+         *p_sized  = 0,
+         *p_result = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    construct_AB_addC_ABC(&p_abc);
+    dict_construct(&p_bcd, 4, 0);
+    dict_add(p_bcd, B_key, B_value);
+    dict_add(p_bcd, C_key, X_value);
+    dict_add(p_bcd, D_key, D_value);
+
+    // Intersection keeps the first dictionary's values, unless resolved
+    print_test(name, "dict_intersect"         , dict_intersect(p_abc, p_bcd, &p_result, 0) == 1 && keys_are(p_result, (const char *[]) { "B", "C" }, 2) && dict_get(p_result, C_key) == C_value );
+    dict_destroy(&p_result);
+    print_test(name, "dict_intersect_conflict", dict_intersect(p_bcd, p_abc, &p_result, set_conflict) == 1 && dict_get(p_result, B_key) == (void *) 4 );
+    dict_destroy(&p_result);
+
+    // Difference
+    print_test(name, "dict_difference"        , dict_difference(p_abc, p_bcd, &p_result) == 1 && keys_are(p_result, (const char *[]) { "A" }, 1) );
+    dict_destroy(&p_result);
+    print_test(name, "dict_difference_self"   , dict_difference(p_abc, p_abc, &p_result) == 1 && dict_keys(p_result, 0) == 0 );
+    dict_destroy(&p_result);
+
+    // Merge appends new keys, and takes the other side's values
+    print_test(name, "dict_merge"             , dict_merge(p_abc, p_bcd, 0) == 1 && keys_are(p_abc, (const char *[]) { "A", "B", "C", "D" }, 4) && dict_get(p_abc, C_key) == X_value );
+    print_test(name, "dict_merge_conflict"    , dict_merge(p_abc, p_bcd, set_conflict) == 1 && dict_get(p_abc, B_key) == (void *) 4 && dict_get(p_abc, A_key) == A_value );
+    print_test(name, "dict_merge_null"        , dict_merge(p_abc, 0, 0) == 0 && dict_intersect(p_abc, p_bcd, 0, 0) == 0 );
+
+    // Values of different sizes do not mix
+    dict_construct_sized(&p_sized, 4, sizeof(long long), 0);
+    dict_add(p_sized, X_key, &(long long) { 5 });
+    print_test(name, "dict_merge_value_size"  , dict_merge(p_abc, p_sized, 0) == 0 && dict_merge(p_sized, p_abc, 0) == 0 && dict_keys(p_abc, 0) == 4 && dict_keys(p_sized, 0) == 1 );
+    print_test(name, "dict_set_value_size"    , dict_intersect(p_abc, p_sized, &p_result, 0) == 0 && dict_difference(p_sized, p_abc, &p_result) == 0 && p_result == 0 );
+    dict_destroy(&p_sized);
+    print_test(name, "dict_destroy"           , dict_destroy(&p_abc) == 1 && dict_destroy(&p_bcd) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void upsert_count ( const char *const key, void **const pp_value, bool inserted, void *const p_context )
+{
+
+    // Suppress warnings
+    (void) key;
+
+    // Count the inserts
+    if ( inserted ) (*(size_t *) p_context)++;
+
+    // Increment the counter
+    *pp_value = (void *) ( (size_t) *pp_value + 1 );
+}
+
+void upsert_count_inline ( const char *const key, void **const pp_value, bool inserted, void *const p_context )
+{
+
+    // Suppress warnings
+    (void) key, (void) inserted, (void) p_context;
+
+    // Increment the stored counter in place
+    (*(size_t *) *pp_value)++;
+}
+
+int test_upsert ( char *name )
+{
+
+    // Initialized data
+    dict       *p_dict   = 0;
+    const void *p_value  = 0,
+               *p_first  = 0;
+    bool        inserted = false,
+                found    = true;
+    size_t      inserts  = 0,
+                counter  = 5;
+    char        keys[2 * DICT_SMALL_MAX][4] = { 0 };
+
+    log_info("Scenario: %s\n", name);
+
+    // Memoization keeps the first value
+    dict_construct(&p_dict, 4, 0);
+    print_test(name, "dict_get_or_insert_A"       , dict_get_or_insert(p_dict, A_key, A_value, &p_value, &inserted) == 1 && inserted == true && p_value == A_value );
+    print_test(name, "dict_get_or_insert_A_again" , dict_get_or_insert(p_dict, A_key, B_value, &p_value, &inserted) == 1 && inserted == false && p_value == A_value );
+    print_test(name, "dict_get_or_insert_null"    , dict_get_or_insert(p_dict, A_key, B_value, 0, 0) == 0 && dict_update(p_dict, A_key, 0, 0) == 0 );
+
+    // Counters, small and hashed
+    for (size_t i = 0; i < 2 * DICT_SMALL_MAX; i++)
+    {
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i);
+        for (size_t j = 0; j <= i; j++)
+            found &= dict_update(p_dict, keys[i], upsert_count, &inserts) == 1;
+    }
+    for (size_t i = 0; i < 2 * DICT_SMALL_MAX; i++)
+        found &= dict_get(p_dict, keys[i]) == (void *) ( i + 1 );
+
+    print_test(name, "dict_update_count"          , found && inserts == 2 * DICT_SMALL_MAX );
+    print_test(name, "dict_update_A"              , dict_update(p_dict, A_key, upsert_count, &inserts) == 1 && dict_get(p_dict, A_key) == (void *) ( (size_t) A_value + 1 ) );
+    dict_destroy(&p_dict);
+
+    // Inline values are zeroed on insert, and edited in place
+    dict_construct_sized(&p_dict, 4, sizeof(size_t), 0);
+    print_test(name, "dict_update_inline"         , dict_update(p_dict, A_key, upsert_count_inline, 0) == 1 && dict_update(p_dict, A_key, upsert_count_inline, 0) == 1 && *(size_t *) dict_get(p_dict, A_key) == 2 );
+    print_test(name, "dict_get_or_insert_inline"  , dict_get_or_insert(p_dict, B_key, &counter, &p_first, &inserted) == 1 && inserted == true && p_first != &counter && *(size_t *) p_first == 5 );
+    counter = 9;
+    print_test(name, "dict_get_or_insert_inline_2", dict_get_or_insert(p_dict, B_key, &counter, &p_value, &inserted) == 1 && inserted == false && p_value == p_first && *(size_t *) p_value == 5 );
+    print_test(name, "dict_destroy"               , dict_destroy(&p_dict) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+static const char *atomic_keys[16] = { "c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9", "c10", "c11", "c12", "c13", "c14", "c15" };
+
+void *atomic_bump ( void *p_parameter )
+{
+
+    // Initialized data
+    sharded_dict *p_sharded_dict = p_parameter;
+
+    // Bump every counter
+    for (size_t i = 0; i < 4096; i++)
+        sharded_dict_fetch_add(p_sharded_dict, atomic_keys[i % 16], 1, 0);
+
+    // Done
+    return 0;
+}
+
+int test_atomic ( char *name )
+{
+
+    // Initialized data
+    dict         *p_dict         = 0;
+    sharded_dict *p_sharded_dict = 0;
+    pthread_t     threads[4]     = { 0 };
+    long long     previous       = -1,
+                  expected       = 0,
+                  desired        = 0;
+    bool          found          = true;
+
+    log_info("Scenario: %s\n", name);
+
+    // Compare and swap
+    construct_AB_addC_ABC(&p_dict);
+    print_test(name, "dict_cas_B"            , dict_cas(p_dict, B_key, B_value, X_value) == 1 && dict_get(p_dict, B_key) == X_value );
+    print_test(name, "dict_cas_B_changed"    , dict_cas(p_dict, B_key, B_value, D_value) == 0 && dict_get(p_dict, B_key) == X_value );
+    print_test(name, "dict_cas_X"            , dict_cas(p_dict, X_key, 0, D_value) == 0 && dict_get(p_dict, X_key) == 0 );
+
+    // Counters, missing ones start at zero
+    print_test(name, "dict_fetch_add_X"      , dict_fetch_add(p_dict, X_key, 5, &previous) == 1 && previous == 0 && dict_get(p_dict, X_key) == (void *) 5 );
+    print_test(name, "dict_fetch_add_X_again", dict_fetch_add(p_dict, X_key, -7, &previous) == 1 && previous == 5 && dict_get(p_dict, X_key) == (void *) (intptr_t) -2 );
+    print_test(name, "dict_fetch_add_null"   , dict_fetch_add(p_dict, 0, 1, 0) == 0 && dict_cas(0, X_key, 0, 0) == 0 );
+    dict_destroy(&p_dict);
+
+    // Inline counters, hashed
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    for (size_t i = 0; i < 16; i++)
+        found &= dict_fetch_add(p_dict, atomic_keys[i], (long long) i, 0) == 1 && dict_fetch_add(p_dict, atomic_keys[i], 1, &previous) == 1 && previous == (long long) i;
+
+    print_test(name, "dict_fetch_add_inline" , found && *(long long *) dict_get(p_dict, "c9") == 10 );
+    expected = 10, desired = 20;
+    print_test(name, "dict_cas_inline"       , dict_cas(p_dict, "c9", &expected, &desired) == 1 && *(long long *) dict_get(p_dict, "c9") == 20 && dict_cas(p_dict, "c9", &expected, &desired) == 0 );
+    print_test(name, "dict_cas_inline_null"  , dict_cas(p_dict, "c9", 0, &desired) == 0 );
+    dict_destroy(&p_dict);
+
+    // Many threads, one counter per key
+    sharded_dict_construct(&p_sharded_dict, 4, 16, 0);
+    for (size_t i = 0; i < 4; i++) pthread_create(&threads[i], 0, atomic_bump, p_sharded_dict);
+    for (size_t i = 0; i < 4; i++) pthread_join(threads[i], 0);
+
+    found = true;
+    for (size_t i = 0; i < 16; i++)
+        found &= sharded_dict_get(p_sharded_dict, atomic_keys[i]) == (void *) ( 4 * 4096 / 16 );
+
+    print_test(name, "sharded_dict_fetch_add", found );
+    print_test(name, "sharded_dict_cas"      , sharded_dict_cas(p_sharded_dict, "c0", (void *) 1024, A_value) == 1 && sharded_dict_get(p_sharded_dict, "c0") == A_value );
+    print_test(name, "sharded_dict_destroy"  , sharded_dict_destroy(&p_sharded_dict) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void *batch_swap ( void *p_parameter )
+{
+
+    // Initialized data
+    dict       *p_dict  = p_parameter;
+    dict_batch *p_batch = 0;
+
+    // Swap the same two keys in and out, one batch at a time
+    dict_batch_construct(&p_batch, 4);
+    for (size_t i = 0; i < 1024; i++)
+    {
+        dict_batch_clear(p_batch);
+        dict_batch_pop(p_batch, ( i & 1 ) ? C_key : A_key);
+        dict_batch_add(p_batch, ( i & 1 ) ? A_key : C_key, D_value);
+        dict_apply_batch(p_dict, p_batch);
+    }
+    dict_batch_destroy(&p_batch);
+
+    // Done
+    return 0;
+}
+
+int test_batch ( char *name )
+{
+
+    // Initialized data
+    dict       *p_dict   = 0;
+    dict_batch *p_batch  = 0;
+    pthread_t   thread   = { 0 };
+    const char *keys[]   = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15" };
+    dict_memory memory   = { 0 };
+    bool        whole    = true;
+
+    log_info("Scenario: %s\n", name);
+
+    // Mixed operations, in order
+    construct_AB_addC_ABC(&p_dict);
+    print_test(name, "dict_batch_construct"   , dict_batch_construct(&p_batch, 1) == 1 && dict_batch_construct(0, 1) == 0 );
+    dict_batch_add(p_batch, D_key, D_value);
+    dict_batch_pop(p_batch, A_key);
+    dict_batch_add(p_batch, B_key, X_value);
+    dict_batch_pop(p_batch, X_key);
+    print_test(name, "dict_apply_batch"       , dict_apply_batch(p_dict, p_batch) == 1 && keys_are(p_dict, (const char *[]) { "B", "C", "D" }, 3) && dict_get(p_dict, B_key) == X_value );
+
+    // Add then pop the same key
+    dict_batch_clear(p_batch);
+    dict_batch_add(p_batch, X_key, X_value);
+    dict_batch_pop(p_batch, X_key);
+    print_test(name, "dict_apply_batch_add_pop", dict_apply_batch(p_dict, p_batch) == 1 && dict_get(p_dict, X_key) == 0 && dict_keys(p_dict, 0) == 3 );
+
+    // Outgrow the small dictionary, in insertion order
+    dict_batch_clear(p_batch);
+    for (size_t i = 0; i < 16; i++) dict_batch_add(p_batch, keys[i], (void *) keys[i]);
+    print_test(name, "dict_apply_batch_many"  , dict_apply_batch(p_dict, p_batch) == 1 && dict_keys(p_dict, 0) == 19 && dict_get(p_dict, "15") == keys[15] );
+    dict_destroy(&p_dict);
+
+    // A batch that does not fit is not applied
+    dict_construct_budget(&p_dict, 4, 1024, 0, 0);
+    print_test(name, "dict_apply_batch_budget", dict_apply_batch(p_dict, p_batch) == 0 && dict_keys(p_dict, 0) == 0 );
+    dict_destroy(&p_dict);
+
+    // Eviction that can not make room rejects the whole batch
+    dict_construct_budget(&p_dict, 4, SIZE_MAX, lru_evict, 0);
+    dict_memory_usage(p_dict, &memory);
+    dict_destroy(&p_dict);
+    dict_construct_budget(&p_dict, 4, memory.total + 8, lru_evict, 0);
+    print_test(name, "dict_apply_batch_evict" , dict_apply_batch(p_dict, p_batch) == 0 && dict_keys(p_dict, 0) == 0 );
+    dict_destroy(&p_dict);
+
+    // A batch that would evict its own adds is not applied
+    dict_construct_lru(&p_dict, 4, 4, 0, 0);
+    print_test(name, "dict_apply_batch_lru"   , dict_apply_batch(p_dict, p_batch) == 0 && dict_keys(p_dict, 0) == 0 );
+
+    // Eviction passes over the properties the batch names
+    for (size_t i = 0; i < 4; i++) dict_add(p_dict, keys[i], (void *) keys[i]);
+    dict_batch_clear(p_batch);
+    dict_batch_add(p_batch, keys[4], (void *) keys[4]);
+    dict_batch_add(p_batch, keys[5], (void *) keys[5]);
+    dict_batch_add(p_batch, keys[0], X_value);
+    print_test(name, "dict_apply_batch_named" , dict_apply_batch(p_dict, p_batch) == 1 && keys_are(p_dict, (const char *[]) { "0", "3", "4", "5" }, 4) && dict_get(p_dict, keys[0]) == X_value );
+    dict_destroy(&p_dict);
+
+    // Other threads never see half a batch
+    construct_AB_addC_ABC(&p_dict);
+    dict_pop(p_dict, C_key, 0);
+    pthread_create(&thread, 0, batch_swap, p_dict);
+    for (size_t i = 0; i < 4096; i++) whole &= dict_keys(p_dict, 0) == 2;
+    pthread_join(thread, 0);
+    print_test(name, "dict_apply_batch_whole" , whole );
+    print_test(name, "dict_batch_destroy"     , dict_batch_destroy(&p_batch) == 1 && p_batch == 0 && dict_destroy(&p_dict) == 1 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+long journal_size ( const char *path )
+{
+
+    // Initialized data
+    FILE *f    = fopen(path, "rb");
+    long  size = -1;
+
+    // Error check
+    if ( f == (void *) 0 ) return -1;
+
+    // Measure the file
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fclose(f);
+
+    // Done
+    return size;
+}
+
+int test_journal ( char *name )
+{
+
+    // Initialized data
+    const char          *path      = "dict_test.journal";
+    const char          *keys[]    = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15" };
+    dict                *p_dict    = 0;
+    dict_journal_config  batched   = { .sync = DICT_JOURNAL_SYNC_NONE, .batch = 4096 },
+                         threaded  = { .sync = DICT_JOURNAL_SYNC_INTERVAL, .interval = timer_seconds_divisor() / 1000, .compact = 512 };
+    long                 size      = 0;
+    long long            values[]  = { 1, 2, 3, 4, 24 };
+    bool                 found     = true;
+    FILE                *f         = 0;
+
+    log_info("Scenario: %s\n", name);
+
+    // Start from an empty log
+    remove(path);
+
+    // Pointer values would not survive a restart
+    dict_construct(&p_dict, 4, 0);
+    print_test(name, "dict_journal_pointer"     , dict_journal_open(p_dict, path, 0) == 0 && journal_size(path) < 0 );
+    dict_destroy(&p_dict);
+
+    // Each change is logged
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    print_test(name, "dict_journal_open"        , dict_journal_open(p_dict, path, 0) == 1 && dict_journal_open(p_dict, path, 0) == 0 );
+    dict_add(p_dict, A_key, &values[0]);
+    dict_add(p_dict, B_key, &values[1]);
+    dict_add(p_dict, C_key, &values[2]);
+    dict_pop(p_dict, B_key, 0);
+    dict_add(p_dict, A_key, &values[4]);
+    print_test(name, "dict_journal_flush"       , dict_journal_flush(p_dict) == 1 );
+    dict_destroy(&p_dict);
+
+    // A restart replays the log
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    print_test(name, "dict_journal_replay"      , dict_journal_open(p_dict, path, 0) == 1 && keys_are(p_dict, (const char *[]) { "A", "C" }, 2) && *(const long long *) dict_get(p_dict, A_key) == 24 );
+
+    // Clears are logged
+    dict_clear(p_dict);
+    dict_add(p_dict, D_key, &values[3]);
+    dict_destroy(&p_dict);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    print_test(name, "dict_journal_clear"       , dict_journal_open(p_dict, path, 0) == 1 && keys_are(p_dict, (const char *[]) { "D" }, 1) );
+    dict_destroy(&p_dict);
+
+    // A torn record is cut off
+    size = journal_size(path);
+    f    = fopen(path, "ab");
+    fwrite("A\x05\0\0", 1, 4, f);
+    fclose(f);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    print_test(name, "dict_journal_torn"        , dict_journal_open(p_dict, path, 0) == 1 && journal_size(path) == size && *(const long long *) dict_get(p_dict, D_key) == 4 );
+    dict_destroy(&p_dict);
+
+    // Inline counters, buffered, across the small layout and the hash table
+    remove(path);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    dict_journal_open(p_dict, path, &batched);
+    for (size_t i = 0; i < 16; i++)
+        for (size_t j = 0; j <= i; j++)
+            dict_fetch_add(p_dict, keys[i], 1, 0);
+    print_test(name, "dict_journal_batch"       , journal_size(path) == 16 && dict_journal_flush(p_dict) == 1 && journal_size(path) > 16 );
+    dict_destroy(&p_dict);
+    dict_construct_sized(&p_dict, 4, sizeof(int), 0);
+    print_test(name, "dict_journal_value_size"  , dict_journal_open(p_dict, path, 0) == 0 );
+    dict_destroy(&p_dict);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    dict_journal_open(p_dict, path, 0);
+    for (size_t i = 0; i < 16; i++) found &= dict_get(p_dict, keys[i]) && *(const long long *) dict_get(p_dict, keys[i]) == (long long) i + 1;
+    print_test(name, "dict_journal_inline"      , found );
+
+    // Compaction keeps one add per property
+    size = journal_size(path);
+    print_test(name, "dict_journal_compact"     , dict_journal_compact(p_dict) == 1 && journal_size(path) < size && journal_size(path) == 16 + 16 * ( 17 + 8 ) + 10 + 2 * 6 );
+    dict_fetch_add(p_dict, keys[0], 1, 0);
+    dict_destroy(&p_dict);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    print_test(name, "dict_journal_compact_open", dict_journal_open(p_dict, path, 0) == 1 && dict_keys(p_dict, 0) == 16 && *(const long long *) dict_get(p_dict, keys[0]) == 2 );
+    dict_destroy(&p_dict);
+
+    // The journal thread compacts the log once it grows
+    remove(path);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    dict_journal_open(p_dict, path, &threaded);
+    for (long long i = 0; i < 256; i++) dict_add(p_dict, A_key, &i);
+    for (size_t i = 0; i < 1000 && journal_size(path) > 512; i++) ttl_wait(timer_seconds_divisor() / 1000);
+    print_test(name, "dict_journal_thread"      , journal_size(path) <= 512 );
+    dict_destroy(&p_dict);
+    dict_construct_sized(&p_dict, 4, sizeof(long long), 0);
+    print_test(name, "dict_journal_thread_open" , dict_journal_open(p_dict, path, 0) == 1 && *(const long long *) dict_get(p_dict, A_key) == 255 );
+    print_test(name, "dict_journal_null"        , dict_journal_open(0, path, 0) == 0 && dict_journal_flush(0) == 0 && dict_journal_compact(0) == 0 );
+    dict_destroy(&p_dict);
+
+    // Clean up
+    remove(path);
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool shm_keys_are ( shm_dict *p_shm_dict, const char **expected, size_t count )
+{
+
+    // Initialized data
+    const char *keys[16] = { 0 };
+
+    // Check the count
+    if ( shm_dict_keys(p_shm_dict, 0) != count || count > 16 ) return false;
+
+    // Check each key, in order
+    shm_dict_keys(p_shm_dict, keys);
+    for (size_t i = 0; i < count; i++)
+        if ( strcmp(keys[i], expected[i]) ) return false;
+
+    // Done
+    return true;
+}
+
+int test_shm ( char *name )
+{
+
+    // Initialized data
+    const char  *region         = "/dict_test_shm",
+                *keys[]         = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15" };
+    static char  filler[4096]   = { 0 };
+    shm_dict    *p_shm_dict     = 0,
+                *p_other        = 0;
+    const void  *p_value        = 0;
+    size_t       size           = 0,
+                 generation     = 0;
+    pid_t        pid            = 0;
+    int          status         = -1;
+    bool         found          = true;
+
+    log_info("Scenario: %s\n", name);
+
+    // Start without the region
+    shm_dict_unlink(region);
+
+    // Build [A,B,C]
+    print_test(name, "shm_dict_create"       , shm_dict_create(&p_shm_dict, region, 16, 1 << 16) == 1 && shm_dict_create(&p_other, region, 16, 1 << 16) == 0 );
+    shm_dict_add(p_shm_dict, A_key, "alpha", 6);
+    shm_dict_add(p_shm_dict, B_key, "beta" , 5);
+    shm_dict_add(p_shm_dict, C_key, "gamma", 6);
+    p_value = shm_dict_get(p_shm_dict, B_key, &size);
+    print_test(name, "shm_dict_get"          , p_value && size == 5 && strcmp(p_value, "beta") == 0 && shm_dict_get(p_shm_dict, X_key, 0) == 0 );
+
+    // Another process attaches by name, reads, and changes the dictionary
+    pid = fork();
+    if ( pid == 0 )
+    {
+        found = shm_dict_open(&p_other, region) == 1
+             && strcmp(shm_dict_get(p_other, A_key, 0), "alpha") == 0
+             && shm_dict_pop(p_other, B_key, 0) == 1
+             && shm_dict_add(p_other, D_key, "delta", 6) == 1
+             && shm_dict_close(&p_other) == 1;
+        _exit(found ? 0 : 1);
+    }
+    waitpid(pid, &status, 0);
+    print_test(name, "shm_dict_open"         , WIFEXITED(status) && WEXITSTATUS(status) == 0 );
+    print_test(name, "shm_dict_shared"       , shm_keys_are(p_shm_dict, (const char *[]) { "A", "C", "D" }, 3) && strcmp(shm_dict_get(p_shm_dict, D_key, 0), "delta") == 0 );
+
+    // An update leaves the old value readable
+    p_value = shm_dict_get(p_shm_dict, A_key, 0);
+    shm_dict_add(p_shm_dict, A_key, "ALPHA", 6);
+    print_test(name, "shm_dict_update"       , strcmp(p_value, "alpha") == 0 && strcmp(shm_dict_get(p_shm_dict, A_key, 0), "ALPHA") == 0 && shm_keys_are(p_shm_dict, (const char *[]) { "A", "C", "D" }, 3) );
+
+    // A second mapping in this process sees the same properties at another address
+    shm_dict_open(&p_other, region);
+    print_test(name, "shm_dict_mapping"      , shm_dict_get(p_other, C_key, 0) != shm_dict_get(p_shm_dict, C_key, 0) && strcmp(shm_dict_get(p_other, C_key, 0), "gamma") == 0 );
+    shm_dict_close(&p_other);
+
+    // Pops leave tombstones, which are squeezed out in order
+    shm_dict_clear(p_shm_dict);
+    for (size_t i = 0; i < 16; i++) shm_dict_add(p_shm_dict, keys[i], &i, sizeof(i));
+    for (size_t i = 0; i < 16; i++) if ( i % 4 ) shm_dict_pop(p_shm_dict, keys[i], 0);
+    shm_dict_add(p_shm_dict, keys[1], keys[1], 2);
+    print_test(name, "shm_dict_order"        , shm_keys_are(p_shm_dict, (const char *[]) { "0", "4", "8", "12", "1" }, 5) );
+    for (size_t i = 0; i < 16; i += 4) found &= shm_dict_get(p_shm_dict, keys[i], &size) && size == sizeof(size_t) && *(const size_t *) shm_dict_get(p_shm_dict, keys[i], 0) == i;
+    print_test(name, "shm_dict_values"       , found && shm_dict_values(p_shm_dict, 0) == 5 );
+    print_test(name, "shm_dict_pop_X"        , shm_dict_pop(p_shm_dict, X_key, 0) == 0 );
+    print_test(name, "shm_dict_close"        , shm_dict_close(&p_shm_dict) == 1 && p_shm_dict == 0 );
+    print_test(name, "shm_dict_unlink"       , shm_dict_unlink(region) == 1 && shm_dict_open(&p_other, region) == 0 );
+
+    // An anonymous region is shared with forked processes
+    shm_dict_create(&p_shm_dict, 0, 4, 4096);
+    pid = fork();
+    if ( pid == 0 ) _exit(shm_dict_add(p_shm_dict, A_key, "alpha", 6) ? 0 : 1);
+    waitpid(pid, &status, 0);
+    print_test(name, "shm_dict_anonymous"    , WIFEXITED(status) && WEXITSTATUS(status) == 0 && strcmp(shm_dict_get(p_shm_dict, A_key, 0), "alpha") == 0 );
+
+    // A full region fails the add, and keeps every property
+    for (size = 0; size < 4096 && shm_dict_add(p_shm_dict, keys[size % 16], filler, 256); size++);
+    print_test(name, "shm_dict_full"         , size < 4096 && shm_dict_add(p_shm_dict, X_key, filler, 4096) == 0 && shm_dict_get(p_shm_dict, X_key, 0) == 0 && strcmp(shm_dict_get(p_shm_dict, A_key, 0), "alpha") == 0 );
+    generation = shm_dict_generation(p_shm_dict);
+    print_test(name, "shm_dict_clear"        , shm_dict_clear(p_shm_dict) == 1 && shm_dict_keys(p_shm_dict, 0) == 0 && shm_dict_add(p_shm_dict, X_key, filler, 2048) == 1 );
+    print_test(name, "shm_dict_generation"   , shm_dict_generation(p_shm_dict) == generation + 1 && shm_dict_add(p_shm_dict, A_key, "alpha", 6) == 1 && shm_dict_generation(p_shm_dict) == generation + 1 );
+    shm_dict_close(&p_shm_dict);
+
+    // A region that fills while the iterable array grows keeps the old array
+    found = true;
+    for (size_t bytes = 256; bytes <= 1536; bytes += 8)
+    {
+        if ( shm_dict_create(&p_shm_dict, 0, 1, bytes) == 0 ) continue;
+        for (size = 0; size < 16 && shm_dict_add(p_shm_dict, keys[size], &size, sizeof(size)); size++);
+        shm_dict_add(p_shm_dict, keys[0], &size, sizeof(size));
+        found &= size < 16 && shm_keys_are(p_shm_dict, keys, size);
+        shm_dict_close(&p_shm_dict);
+    }
+    print_test(name, "shm_dict_full_grow"    , found );
+    print_test(name, "shm_dict_too_large"    , shm_dict_create(&p_shm_dict, 0, SIZE_MAX / 4, 4096) == 0 && shm_dict_create(&p_shm_dict, 0, 4, SIZE_MAX) == 0 );
+    print_test(name, "shm_dict_null"         , shm_dict_create(0, region, 4, 4096) == 0 && shm_dict_create(&p_shm_dict, region, 4, 64) == 0 && shm_dict_open(&p_shm_dict, 0) == 0 && shm_dict_get(0, A_key, 0) == 0 && shm_dict_add(0, A_key, 0, 0) == 0 && shm_dict_close(0) == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_placement ( char *name )
+{
+
+    // Initialized data
+    static char            arena[150000][8] = { { 0 } };
+    static const char     *keys[150000]     = { 0 },
+                          *out[150000]      = { 0 };
+    dict                  *p_dict           = 0,
+                          *p_copy           = 0;
+    dict_placement_config  thp              = { .pages = DICT_PAGES_TRANSPARENT },
+                           hugetlb          = { .pages = DICT_PAGES_EXPLICIT },
+                           bind             = { .numa = DICT_NUMA_BIND, .nodes = 1 },
+                           interleave       = { .pages = DICT_PAGES_TRANSPARENT, .numa = DICT_NUMA_INTERLEAVE },
+                           absent           = { .numa = DICT_NUMA_BIND, .nodes = 1ULL << 63 },
+                           unknown          = { .pages = (enum dict_pages_e) 3 };
+    size_t                 count            = sizeof(keys) / sizeof(*keys);
+    bool                   found            = true;
+
+    log_info("Scenario: %s\n", name);
+
+    // Name each key
+    for (size_t i = 0; i < count; i++) snprintf(arena[i], sizeof(arena[i]), "%zu", i), keys[i] = arena[i];
+
+    // The hash table and iterables outgrow the heap, and shrink back onto it
+    print_test(name, "dict_construct_placed"   , dict_construct_placed(&p_dict, 1 << 18, 0, &thp, 0) == 1 );
+    for (size_t i = 0; i < count; i++) dict_add(p_dict, keys[i], (void *) ( i + 1 ));
+    for (size_t i = 0; i < count; i++) found &= dict_get(p_dict, keys[i]) == (void *) ( i + 1 );
+    dict_keys(p_dict, out);
+    for (size_t i = 0; i < count; i++) found &= out[i] == keys[i];
+    print_test(name, "dict_placed_grow"        , found && dict_keys(p_dict, 0) == count );
+    print_test(name, "dict_placed_copy"        , dict_copy(p_dict, &p_copy) == 1 && dict_get(p_copy, keys[count - 1]) == (void *) count && dict_destroy(&p_copy) == 1 );
+    for (size_t i = 16; i < count; i++) dict_pop(p_dict, keys[i], 0);
+    for (size_t i = 0; i < 16; i++) found &= dict_get(p_dict, keys[i]) == (void *) ( i + 1 );
+    print_test(name, "dict_placed_shrink"      , found && dict_keys(p_dict, 0) == 16 );
+    print_test(name, "dict_placed_destroy"     , dict_destroy(&p_dict) == 1 );
+
+    // Inline values, on explicit huge pages, or transparent ones if none are reserved
+    print_test(name, "dict_placed_sized"       , dict_construct_placed(&p_dict, 1 << 18, sizeof(long long), &hugetlb, 0) == 1 && dict_add(p_dict, A_key, &(long long) { 42 }) == 1 && *(const long long *) dict_get(p_dict, A_key) == 42 );
+    dict_destroy(&p_dict);
+
+    // NUMA policies
+    print_test(name, "dict_placed_bind"        , dict_construct_placed(&p_dict, 1 << 18, 0, &bind, 0) == 1 && dict_add(p_dict, A_key, A_value) == 1 && dict_get(p_dict, A_key) == A_value );
+    dict_destroy(&p_dict);
+    print_test(name, "dict_placed_interleave"  , dict_construct_placed(&p_dict, 1 << 18, 0, &interleave, 0) == 1 && dict_add(p_dict, A_key, A_value) == 1 );
+    dict_destroy(&p_dict);
+    print_test(name, "dict_placed_absent_node" , dict_construct_placed(&p_dict, 1 << 18, 0, &absent, 0) == 0 && p_dict == 0 );
+
+    // Small hash tables stay on the heap, so any node mask is fine
+    print_test(name, "dict_placed_small"       , dict_construct_placed(&p_dict, 16, 0, &absent, 0) == 1 && dict_add(p_dict, A_key, A_value) == 1 && dict_destroy(&p_dict) == 1 );
+    print_test(name, "dict_placed_null"        , dict_construct_placed(0, 16, 0, &thp, 0) == 0 && dict_construct_placed(&p_dict, 16, 0, 0, 0) == 0 && dict_construct_placed(&p_dict, 16, 0, &unknown, 0) == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_filter ( char *name )
+{
+
+    // Initialized data
+    static char      arena[600][8] = { { 0 } };
+    dict            *p_dict        = 0,
+                    *p_copy        = 0;
+    dict_memory      memory        = { 0 };
+    size_t           count         = sizeof(arena) / sizeof(*arena) / 2,
+                     let_through   = 0;
+    bool             found         = true;
+
+    log_info("Scenario: %s\n", name);
+
+    // Name each key. The first half are added, the second half never are
+    for (size_t i = 0; i < 2 * count; i++) snprintf(arena[i], sizeof(arena[i]), "%zu", i);
+
+    // Enabling counts the properties already in a small dictionary
+    dict_construct(&p_dict, 64, 0);
+    dict_add(p_dict, A_key, A_value);
+    dict_add(p_dict, B_key, B_value);
+    print_test(name, "dict_filter_enable"     , dict_filter_enable(p_dict, 4000) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.filter == 4096 );
+    print_test(name, "dict_filter_small"      , dict_get(p_dict, A_key) == A_value && dict_get(p_dict, B_key) == B_value && dict_get(p_dict, X_key) == 0 );
+
+    // No false negatives, through the promotion to a hash table and half the keys popped
+    for (size_t i = 0; i < count; i++) dict_add(p_dict, arena[i], (void *) ( i + 1 ));
+    for (size_t i = 0; i < count; i += 2) found &= dict_pop(p_dict, arena[i], 0) == 1;
+    for (size_t i = 0; i < count; i++) found &= dict_get(p_dict, arena[i]) == ( ( i % 2 ) ? (void *) ( i + 1 ) : 0 );
+    print_test(name, "dict_filter_add_pop"    , found && dict_get(p_dict, A_key) == A_value );
+    print_test(name, "dict_filter_pop_absent" , dict_pop(p_dict, arena[count], 0) == 0 && dict_pop(p_dict, arena[0], 0) == 0 );
+
+    // Nearly every absent key is answered by the filter
+    #ifdef BUILD_DICT_WITH_STATS
+    {
+
+        // Initialized data
+        dict_statistics statistics = { 0 };
+
+        dict_stats_enable(p_dict, true);
+        for (size_t i = count; i < 2 * count; i++) dict_get(p_dict, arena[i]);
+        dict_stats(p_dict, &statistics);
+        let_through = statistics.misses - statistics.filtered;
+        print_test(name, "dict_filter_filtered"   , statistics.misses == count && let_through < count / 10 );
+        dict_stats_enable(p_dict, false);
+    }
+    #else
+        (void) let_through;
+    #endif
+
+    // Copies keep the filter, clears empty it
+    print_test(name, "dict_filter_copy"       , dict_copy(p_dict, &p_copy) == 1 && dict_get(p_copy, arena[1]) == (void *) 2 && dict_get(p_copy, arena[0]) == 0 && dict_memory_usage(p_copy, &memory) == 1 && memory.filter == 4096 );
+    print_test(name, "dict_filter_clear"      , dict_clear(p_copy) == 1 && dict_get(p_copy, arena[1]) == 0 && dict_add(p_copy, arena[1], A_value) == 1 && dict_get(p_copy, arena[1]) == A_value );
+    dict_destroy(&p_copy);
+
+    // Dropping the filter leaves the properties in place
+    print_test(name, "dict_filter_disable"    , dict_filter_enable(p_dict, 0) == 1 && dict_get(p_dict, arena[1]) == (void *) 2 && dict_memory_usage(p_dict, &memory) == 1 && memory.filter == 0 );
+    dict_destroy(&p_dict);
+
+    // Every key collides, so the counters saturate, and stay saturated after the pops
+    dict_construct(&p_dict, 4, hash_constant);
+    dict_filter_enable(p_dict, 64);
+    for (size_t i = 0; i < count; i++) dict_add(p_dict, arena[i], (void *) ( i + 1 ));
+    for (size_t i = 1; i < count; i++) dict_pop(p_dict, arena[i], 0);
+    print_test(name, "dict_filter_saturated"  , dict_get(p_dict, arena[0]) == (void *) 1 && dict_get(p_dict, arena[1]) == 0 );
+    dict_destroy(&p_dict);
+
+    // The filter is kept where the small properties were, so a small dictionary is promoted, and disabling no filter leaves it small
+    dict_construct(&p_dict, 4, 0);
+    dict_add(p_dict, A_key, A_value);
+    print_test(name, "dict_filter_none_small" , dict_filter_enable(p_dict, 0) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.buckets == 0 );
+    print_test(name, "dict_filter_small"      , dict_filter_enable(p_dict, 64) == 1 && dict_memory_usage(p_dict, &memory) == 1 && memory.buckets > 0 && memory.filter == 64 && dict_get(p_dict, A_key) == A_value );
+    dict_destroy(&p_dict);
+
+    print_test(name, "dict_filter_enable_null", dict_filter_enable(0, 64) == 0 );
+
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
 int print_test ( const char *scenario_name, const char *test_name, bool passed )
 {
 
@@ -15,6 +15,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 // sync module
@@ -36,9 +37,29 @@
 #define DICT_REALLOC(p, sz) realloc(p,sz)
 #endif
 
+// Statistics
+#define DICT_STATS_HISTOGRAM_SIZE 16
+
+// Small dictionaries store up to this many properties inline, without a hash table
+#ifndef DICT_SMALL_MAX
+#define DICT_SMALL_MAX 8
+#endif
+
 // Forward declarations
 struct dict_item_s;
 struct dict_s;
+struct sharded_dict_s;
+struct replicated_dict_s;
+struct int_dict_s;
+struct intern_table_s;
+struct shm_dict_s;
+struct dict_statistics_s;
+struct dict_analysis_s;
+struct dict_memory_s;
+struct dict_cursor_s;
+struct dict_batch_s;
+struct dict_journal_config_s;
+struct dict_placement_config_s;
 
 // Type definitions
 /** !
@@ -46,6 +67,157 @@ struct dict_s;
  */
 typedef struct dict_s dict;
 
+/** !
+ *  @brief The type definition of a sharded dictionary struct
+ */
+typedef struct sharded_dict_s sharded_dict;
+
+/** !
+ *  @brief The type definition of a per NUMA node replicated dictionary struct
+ */
+typedef struct replicated_dict_s replicated_dict;
+
+/** !
+ *  @brief The type definition of an integer keyed dictionary struct
+ */
+typedef struct int_dict_s int_dict;
+
+/** !
+ *  @brief The type definition of a string interning table struct
+ */
+typedef struct intern_table_s intern_table;
+
+/** !
+ *  @brief The type definition of a shared memory dictionary struct
+ */
+typedef struct shm_dict_s shm_dict;
+
+/** !
+ *  @brief The type definition of a dictionary statistics struct
+ */
+typedef struct dict_statistics_s dict_statistics;
+
+/** !
+ *  @brief The type definition of a dictionary analysis struct
+ */
+typedef struct dict_analysis_s dict_analysis;
+
+/** !
+ *  @brief The type definition of a dictionary memory usage struct
+ */
+typedef struct dict_memory_s dict_memory;
+
+/** !
+ *  @brief The type definition of a sorted index cursor struct
+ */
+typedef struct dict_cursor_s dict_cursor;
+
+/** !
+ *  @brief The type definition of a batch of dictionary operations
+ */
+typedef struct dict_batch_s dict_batch;
+
+/** !
+ *  @brief The type definition of a journal configuration struct
+ */
+typedef struct dict_journal_config_s dict_journal_config;
+
+/** !
+ *  @brief The type definition of a memory placement configuration struct
+ */
+typedef struct dict_placement_config_s dict_placement_config;
+
+// Enumeration definitions
+enum dict_journal_sync_e
+{
+    DICT_JOURNAL_SYNC_NONE     = 0, // Leave flushing the log to the operating system
+    DICT_JOURNAL_SYNC_WRITE    = 1, // fsync after each write of buffered records
+    DICT_JOURNAL_SYNC_INTERVAL = 2  // fsync once per interval, from the journal thread
+};
+
+enum dict_pages_e
+{
+    DICT_PAGES_DEFAULT     = 0, // Heap allocations
+    DICT_PAGES_TRANSPARENT = 1, // Mappings aligned on 2 MiB and advised with MADV_HUGEPAGE
+    DICT_PAGES_EXPLICIT    = 2  // MAP_HUGETLB mappings, from the vm.nr_hugepages pool, else transparent huge pages
+};
+
+enum dict_numa_e
+{
+    DICT_NUMA_DEFAULT    = 0, // The process's memory policy, usually local to the first thread to touch a page
+    DICT_NUMA_BIND       = 1, // Only the given nodes
+    DICT_NUMA_INTERLEAVE = 2  // Round robin across the given nodes, page by page
+};
+
+// Structure definitions
+struct dict_statistics_s
+{
+    size_t    gets,              // Calls to dict_get
+              hits,              // Calls to dict_get that found the key
+              misses,            // Calls to dict_get that did not find the key
+              filtered,          // Misses the membership filter answered without searching
+              adds,              // New properties
+              updates,           // Calls to dict_add on an existing property
+              pops,              // Properties removed
+              resizes,           // Reallocations of the dictionary's arrays
+              lock_acquisitions; // Lock acquisitions
+    timestamp lock_wait;         // Time spent waiting for the lock, in units of timer_seconds_divisor()
+    size_t    entries,           // Properties, when the statistics were taken
+              buckets;           // Hash table entries, when the statistics were taken
+
+    size_t probe_histogram[DICT_STATS_HISTOGRAM_SIZE]; // Properties compared per dict_get. The last bucket holds longer probes
+    size_t chain_histogram[DICT_STATS_HISTOGRAM_SIZE]; // Buckets by chain length, when the statistics were taken. The last bucket holds longer chains
+};
+
+struct dict_analysis_s
+{
+    size_t entries,        // Properties
+           buckets,        // Hash table entries
+           empty_buckets,  // Hash table entries with no properties
+           max_chain;      // Properties in the longest chain
+    double load_factor,    // entries / buckets
+           empty_fraction, // empty_buckets / buckets
+           mean_chain,     // Mean length of the non empty chains
+           chi_squared,    // Pearson's chi-squared statistic of the chain lengths against a uniform distribution
+           uniformity;     // chi_squared / ( buckets - 1 ). About 1 for a good hash, much larger for a degenerate one
+};
+
+struct dict_memory_s
+{
+    size_t dict,      // The dictionary struct, including the inline small layout
+           buckets,   // Hash table
+           nodes,     // Properties, including inline values
+           iterables, // Iterable key and value arrays
+           keys,      // Key strings owned by the container. Dictionaries borrow their keys, except those recovered by a journal
+           wheel,     // Timer wheel, if a property was given a TTL
+           filter,    // Membership filter counters
+           total;     // Sum of the above
+};
+
+struct dict_journal_config_s
+{
+    enum dict_journal_sync_e sync;     // When to fsync the log
+    size_t                   batch;    // Bytes of records to buffer before writing them, or 0 to write each change as it happens
+    timestamp                interval; // Time between background flushes and compaction checks, in units of timer_seconds_divisor(), or 0 for no thread
+    size_t                   compact;  // Log bytes that trigger a background compaction, once the log is also twice its last snapshot, or 0 for never
+};
+
+struct dict_placement_config_s
+{
+    enum dict_pages_e  pages; // Page size of the hash table and iterable arrays
+    enum dict_numa_e   numa;  // NUMA policy of the hash table and iterable arrays
+    unsigned long long nodes; // Bit i selects NUMA node i, or 0 for every node the process may use
+};
+
+struct dict_cursor_s
+{
+    dict               *p_dict;        // Locked while the cursor is open -OR- null pointer once it is closed
+    struct dict_item_s *p_next;        // The next property to visit
+    const char         *hi,            // Keys at or after this end the range -OR- null pointer
+                       *prefix;        // Keys without this prefix end the range -OR- null pointer
+    size_t              prefix_length; // strlen(prefix)
+};
+
 // Initializer
 /** !
  * This gets called at runtime before main. 
@@ -56,6 +228,26 @@ typedef struct dict_s dict;
  */
 DLLEXPORT void dict_init ( void ) __attribute__((constructor));
 
+// Hash
+/** !
+ *  The default hash function. Two lanes of CRC-32C (Castagnoli, reflected polynomial
+ *  0x82F63B78) run over the key as zero padded, little endian 8 byte words, the 
+ *  first lane seeded with 0xFFFFFFFF, the second seeded with 0x9E3779B9 and fed each
+ *  word rotated by 32 bits. The lanes are packed high:low, XORed with the key length
+ *  times 0x9E3779B97F4A7C15, and mixed with the MurmurHash3 finalizer. 
+ *
+ *  dict_init selects the SSE4.2 crc32 instruction when the processor has it, or a
+ *  table driven kernel otherwise. Both produce the same result on every platform.
+ *
+ * @param k pointer to the key
+ * @param l length of the key in bytes
+ *
+ * @sa dict_construct
+ *
+ * @return the hash of the key
+ */
+DLLEXPORT unsigned long long dict_hash ( const void *const k, size_t l );
+
 // Allocaters
 /** !
  *  Allocate memory for a dictionary
@@ -74,7 +266,7 @@ DLLEXPORT int dict_create ( dict **const pp_dict );
  *
  * @param pp_dict           return
  * @param size              number of hash table entries. 
- * @param pfn_hash_function pointer to a hash function, or 0 for default
+ * @param pfn_hash_function pointer to a hash function, or 0 for dict_hash
  *
  * @sa dict_create
  * @sa dict_destroy
@@ -83,6 +275,82 @@ DLLEXPORT int dict_create ( dict **const pp_dict );
  */
 DLLEXPORT int dict_construct ( dict **const pp_dict, size_t size, fn_hash64 pfn_hash_function );
 
+/** !
+ *  Construct a dictionary that stores fixed size values inline. dict_add copies 
+ *  value_size bytes from p_value into the property, or zeroes them if p_value is 
+ *  null. dict_get, dict_values and dict_foreach return pointers into the dictionary,
+ *  which are valid until the property is removed. 
+ *
+ * @param pp_dict           return
+ * @param size              number of hash table entries. 
+ * @param value_size        size of each value in bytes
+ * @param pfn_hash_function pointer to a hash function, or 0 for dict_hash
+ *
+ * @sa dict_construct
+ * @sa dict_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_construct_sized ( dict **const pp_dict, size_t size, size_t value_size, fn_hash64 pfn_hash_function );
+
+/** !
+ *  Construct a dictionary that holds at most capacity properties. dict_get and 
+ *  dict_add mark a property as used. When dict_add goes over capacity, the least
+ *  recently used property is removed, after pfn_evict is called with its key and
+ *  value. pfn_evict runs with the dictionary locked, and must not call back into it.
+ *
+ * @param pp_dict           return
+ * @param size              number of hash table entries. 
+ * @param capacity          most properties in the dictionary
+ * @param pfn_evict         called on each evicted property -OR- null pointer
+ * @param pfn_hash_function pointer to a hash function, or 0 for dict_hash
+ *
+ * @sa dict_construct
+ * @sa dict_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_construct_lru ( dict **const pp_dict, size_t size, size_t capacity, void (*pfn_evict)(const char *const key, void *const value), fn_hash64 pfn_hash_function );
+
+/** !
+ *  Construct a dictionary that allocates at most budget bytes, as counted by 
+ *  dict_memory_usage. When a new property would not fit, dict_add fails, or, if 
+ *  pfn_evict is set, passes least recently used properties to pfn_evict and removes 
+ *  them until it fits. pfn_evict runs with the dictionary locked, and must not call back into it.
+ *
+ * @param pp_dict           return
+ * @param size              number of hash table entries. 
+ * @param budget            most bytes the dictionary may allocate
+ * @param pfn_evict         called on each evicted property -OR- null pointer to fail instead
+ * @param pfn_hash_function pointer to a hash function, or 0 for dict_hash
+ *
+ * @sa dict_construct
+ * @sa dict_memory_usage
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_construct_budget ( dict **const pp_dict, size_t size, size_t budget, void (*pfn_evict)(const char *const key, void *const value), fn_hash64 pfn_hash_function );
+
+/** !
+ *  Construct a dictionary whose hash table and iterable arrays are backed by huge 
+ *  pages, and bound or interleaved across NUMA nodes. Arrays under 1 MiB stay on the
+ *  heap. The hash table is allocated here, so a placement the system cannot honor 
+ *  fails construction. Properties are allocated from the heap. Placement needs 
+ *  POSIX memory mappings; elsewhere, any placement fails.
+ *
+ * @param pp_dict           return
+ * @param size              number of hash table entries. 
+ * @param value_size        bytes of each value, stored inline as with dict_construct_sized -OR- 0 for pointer values
+ * @param p_placement       page size and NUMA policy
+ * @param pfn_hash_function pointer to a hash function, or 0 for dict_hash
+ *
+ * @sa dict_construct
+ * @sa dict_construct_sized
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_construct_placed ( dict **const pp_dict, size_t size, size_t value_size, const dict_placement_config *const p_placement, fn_hash64 pfn_hash_function );
+
 /** !
  *  Construct a dictionary from an array of strings
  *
@@ -151,12 +419,154 @@ DLLEXPORT size_t dict_keys ( dict *const p_dict, const char **const keys );
  */
 DLLEXPORT int dict_add ( dict *const p_dict, const char *const key,  void * const p_value );
 
+/** !
+ *  Get a property's value, or add it if it is missing, with one hash and one walk
+ *  of the chain under one lock. For inline values, the returned pointer is the 
+ *  stored value itself.
+ *
+ * @param p_dict     dictionary
+ * @param key        the name of the property
+ * @param p_value    the value to add, if the property is missing
+ * @param pp_value   return the stored value
+ * @param p_inserted return true if the property was added, else false -OR- null pointer
+ *
+ * @sa dict_update
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_get_or_insert ( dict *const p_dict, const char *const key, void *const p_value, const void **const pp_value, bool *const p_inserted );
+
+/** !
+ *  Compute a property's new value in place, under the lock. A missing property is 
+ *  added first, with a null value, or zeroed inline value. pfn_update sees the value 
+ *  slot, and stores the new value through it. For inline values, it may instead edit
+ *  the bytes the slot points to. pfn_update must not call back into the dictionary.
+ *
+ * @param p_dict     dictionary
+ * @param key        the name of the property
+ * @param pfn_update called once, with the value slot
+ * @param p_context  passed to pfn_update
+ *
+ * @sa dict_get_or_insert
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_update ( dict *const p_dict, const char *const key, void (*pfn_update)(const char *const key, void **const pp_value, bool inserted, void *const p_context), void *const p_context );
+
+/** !
+ *  Replace a property's value with desired, if it is still expected. Both are 
+ *  pointers to the bytes of inline values. One lock acquisition, one hash, and 
+ *  one walk of the chain.
+ *
+ * @param p_dict   dictionary
+ * @param key      the name of the property
+ * @param expected the value to compare with
+ * @param desired  the new value
+ *
+ * @sa dict_fetch_add
+ *
+ * @return 1 if the value was replaced, 0 if it was missing, changed, or on error
+ */
+DLLEXPORT int dict_cas ( dict *const p_dict, const char *const key, const void *const expected, void *const desired );
+
+/** !
+ *  Add delta to a counter. Pointer values hold the count themselves, and inline
+ *  values must be a long long. A missing counter is added at zero first.
+ *
+ * @param p_dict     dictionary
+ * @param key        the name of the counter
+ * @param delta      the amount to add
+ * @param p_previous return the count before the add -OR- null pointer
+ *
+ * @sa dict_cas
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_fetch_add ( dict *const p_dict, const char *const key, long long delta, long long *const p_previous );
+
+/** !
+ *  Add a property that expires ttl after now. An expired property is removed by
+ *  the next dict_get that finds it, or by the timer wheel; until then, it is still
+ *  counted by dict_values and dict_keys. A plain dict_add on the key clears the expiry.
+ *  Properties only carry an expiry once the dictionary has one, so the first TTL
+ *  moves every property. A dictionary with inline values, whose pointers dict_get 
+ *  hands out, must call dict_expire_start or add its first TTL before any other add.
+ *
+ * @param p_dict  dictionary
+ * @param key     the name of the property
+ * @param p_value the value of the property
+ * @param ttl     time to live, in timer_high_precision units. Divide timer_seconds_divisor() for seconds
+ *
+ * @sa dict_add
+ * @sa dict_expire
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_add_ttl ( dict *const p_dict, const char *const key, void *const p_value, timestamp ttl );
+
+/** !
+ *  Set the callback that sees each evicted or expired property before it is freed. 
+ *  The callback runs with the dictionary locked, and must not call back into it.
+ *
+ * @param p_dict    dictionary
+ * @param pfn_evict called on each evicted property -OR- null pointer
+ *
+ * @sa dict_construct_lru
+ * @sa dict_add_ttl
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_on_evict ( dict *const p_dict, void (*pfn_evict)(const char *const key, void *const value) );
+
+// Expiry
+/** !
+ *  Advance the timer wheel toward now, and remove each expired property. Each wheel
+ *  tick is a millisecond, so bounding max_ticks bounds the time spent in one call.
+ *
+ * @param p_dict    dictionary
+ * @param max_ticks most wheel ticks to process -OR- 0 for no limit
+ *
+ * @sa dict_add_ttl
+ * @sa dict_expire_start
+ *
+ * @return number of properties removed
+ */
+DLLEXPORT size_t dict_expire ( dict *const p_dict, size_t max_ticks );
+
+/** !
+ *  Start a background thread that calls dict_expire every interval. The thread 
+ *  needs POSIX threads; elsewhere, this fails, and dict_expire does the work.
+ *  Like the first dict_add_ttl, this moves every property. Two concurrent calls 
+ *  start one thread; the other call fails.
+ *
+ * @param p_dict    dictionary
+ * @param interval  time between steps, in timer_high_precision units
+ * @param max_ticks most wheel ticks to process per step -OR- 0 for no limit
+ *
+ * @sa dict_expire
+ * @sa dict_expire_stop
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_expire_start ( dict *const p_dict, timestamp interval, size_t max_ticks );
+
+/** !
+ *  Stop the background expiry thread, if it is running. dict_destroy also stops it.
+ *
+ * @param p_dict dictionary
+ *
+ * @sa dict_expire_start
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_expire_stop ( dict *const p_dict );
+
 /** !
  *  Remove a property from a dictionary. 
  *
  * @param p_dict   dictionary
  * @param key      the name of the property
- * @param pp_value return
+ * @param pp_value return -OR- null pointer. Must be null if the dictionary stores values inline
  *
  * @sa dict_add
  *
@@ -175,6 +585,106 @@ DLLEXPORT int dict_pop ( dict *const p_dict, const char *const key, const void *
 */
 DLLEXPORT int dict_foreach ( dict *const p_dict, void (*function)(const void *const, size_t i) );
 
+// Sorted index
+/** !
+ *  Maintain a sorted index of the keys alongside the hash table, for dict_range 
+ *  and dict_prefix. Enabling indexes the existing properties. Each add and pop 
+ *  then costs an extra O(log n). Keys sort by strcmp. The index links live in
+ *  each property, so enabling it moves every property. A dictionary with inline
+ *  values must enable it before its first add, since dict_get hands out pointers 
+ *  to them; dropping it there leaves the links in place.
+ *
+ * @param p_dict dictionary
+ * @param enable true to build and maintain the index, false to drop it
+ *
+ * @sa dict_range
+ * @sa dict_prefix
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_index_enable ( dict *const p_dict, bool enable );
+
+/** !
+ *  Maintain a counting Bloom filter of the keys in front of the hash table. A get
+ *  or pop of a key the filter rules out returns without reading a bucket or
+ *  comparing a key, and so do the lookups of dict_merge, dict_intersect and
+ *  dict_difference. Each add and pop then updates 3 one byte counters. About 10
+ *  counters per property let fewer than 1 in 50 absent keys through to the search.
+ *  Enabling counts the existing properties, and moves a small dictionary's into a
+ *  hash table.
+ *
+ * @param p_dict   dictionary
+ * @param counters number of counters, rounded up to a power of two, or 0 to drop the filter
+ *
+ * @sa dict_get
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_filter_enable ( dict *const p_dict, size_t counters );
+
+/** !
+ *  Open a cursor over the properties with lo <= key < hi, in key order.
+ *
+ *  WARNING: The cursor holds the dictionary's lock until dict_cursor_next returns
+ *  false or dict_cursor_close is called. Calling any other function on the same
+ *  dictionary while the cursor is open, from this thread, deadlocks. That includes
+ *  dict_get, dict_add and dict_pop inside the loop. Collect the keys, close the
+ *  cursor, then act on them.
+ *
+ * @param p_dict   dictionary with a sorted index
+ * @param lo       the first key -OR- null pointer for no lower bound
+ * @param hi       the key after the last -OR- null pointer for no upper bound
+ * @param p_cursor return
+ *
+ * @sa dict_index_enable
+ * @sa dict_cursor_next
+ * @sa dict_cursor_close
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_range ( dict *const p_dict, const char *const lo, const char *const hi, dict_cursor *const p_cursor );
+
+/** !
+ *  Open a cursor over the properties whose keys start with prefix, in key order.
+ *
+ *  WARNING: The cursor holds the dictionary's lock until it is exhausted or closed,
+ *  as with dict_range. Calling into the same dictionary inside the loop deadlocks.
+ *
+ * @param p_dict   dictionary with a sorted index
+ * @param prefix   the prefix
+ * @param p_cursor return
+ *
+ * @sa dict_range
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_prefix ( dict *const p_dict, const char *const prefix, dict_cursor *const p_cursor );
+
+/** !
+ *  Visit the next property in a cursor's range. Returns false, and closes the 
+ *  cursor, once the range is exhausted.
+ *
+ * @param p_cursor cursor
+ * @param p_key    return -OR- null pointer
+ * @param pp_value return -OR- null pointer
+ *
+ * @sa dict_cursor_close
+ *
+ * @return true if a property was returned, else false
+ */
+DLLEXPORT bool dict_cursor_next ( dict_cursor *const p_cursor, const char **const p_key, const void **const pp_value );
+
+/** !
+ *  Close a cursor, and unlock its dictionary. Closing a closed cursor does nothing.
+ *
+ * @param p_cursor cursor
+ *
+ * @sa dict_range
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_cursor_close ( dict_cursor *const p_cursor );
+
 // Shallow copy
 /** !
  *  Make a shallow copy of a dictionary
@@ -188,42 +698,892 @@ DLLEXPORT int dict_foreach ( dict *const p_dict, void (*function)(const void *co
  */
 DLLEXPORT int dict_copy ( dict *const p_dict, dict **const pp_dict );
 
-// Clear all items
+// Set operations
 /** !
- *  Remove all properties from a dictionary
+ *  Add each of another dictionary's properties to a dictionary. Both dictionaries
+ *  are locked once, for the whole merge. Stored hashes are reused when both 
+ *  dictionaries share a hash function. pfn_conflict runs with both locked. Both
+ *  dictionaries must store values of the same size.
  *
- * @param p_dict dictionary
+ * @param p_dict       dictionary to merge into
+ * @param p_other      dictionary to merge from
+ * @param pfn_conflict returns the value for a key in both -OR- null pointer to take p_other's value
  *
- * @sa dict_copy
+ * @sa dict_intersect
+ * @sa dict_difference
  *
  * @return 1 on success, 0 on error
  */
-DLLEXPORT int dict_clear ( dict *const p_dict );
+DLLEXPORT int dict_merge ( dict *const p_dict, dict *const p_other, void *(*pfn_conflict)(const char *const key, void *const value, void *const other_value) );
 
 /** !
- *  Remove all properties from a dictionary, and deallocate values with free_func
+ *  Construct a dictionary of the properties whose keys are in both dictionaries. 
+ *  The smaller side is visited, and the larger probed. Both dictionaries must 
+ *  store values of the same size.
  *
  * @param p_dict       dictionary
- * @param free_fun_ptr pointer to deallocator function 
- * 
- * @sa dict_clear
- * @sa dict_copy
+ * @param p_other      dictionary
+ * @param pp_dict      return
+ * @param pfn_conflict returns the value for each key -OR- null pointer to take p_dict's value
+ *
+ * @sa dict_merge
  *
  * @return 1 on success, 0 on error
  */
-DLLEXPORT int dict_free_clear ( dict *const p_dict, void (*const free_func)(const void *const) );
+DLLEXPORT int dict_intersect ( dict *const p_dict, dict *const p_other, dict **const pp_dict, void *(*pfn_conflict)(const char *const key, void *const value, void *const other_value) );
 
-// Destructors
 /** !
- *  Destroy and deallocate a dictionary
+ *  Construct a dictionary of the properties in p_dict whose keys are not in p_other.
+ *  Both dictionaries must store values of the same size.
  *
- * @param pp_dict dictionary
+ * @param p_dict  dictionary
+ * @param p_other dictionary of keys to leave out
+ * @param pp_dict return
  *
- * @sa dict_create
+ * @sa dict_merge
  *
  * @return 1 on success, 0 on error
  */
-DLLEXPORT int dict_destroy ( dict **const pp_dict );
+DLLEXPORT int dict_difference ( dict *const p_dict, dict *const p_other, dict **const pp_dict );
+
+// Batches
+/** !
+ *  Construct a batch, to record adds and pops for dict_apply_batch. A batch 
+ *  borrows its keys and values until it is applied, and is not thread safe.
+ *
+ * @param pp_batch return
+ * @param size     the number of operations to make room for
+ *
+ * @sa dict_apply_batch
+ * @sa dict_batch_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_batch_construct ( dict_batch **const pp_batch, size_t size );
+
+/** !
+ *  Record an add, or an update, in a batch
+ *
+ * @param p_batch batch
+ * @param key     the name of the property
+ * @param p_value the value of the property
+ *
+ * @sa dict_add
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_batch_add ( dict_batch *const p_batch, const char *const key, void *const p_value );
+
+/** !
+ *  Record a pop in a batch
+ *
+ * @param p_batch batch
+ * @param key     the name of the property
+ *
+ * @sa dict_pop
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_batch_pop ( dict_batch *const p_batch, const char *const key );
+
+/** !
+ *  Apply a batch's operations, in order, in one critical section, so other threads 
+ *  see all of them or none of them. Keys are hashed, and new properties allocated,
+ *  before the lock is taken. The iterables are resized at most once. Pops of missing
+ *  properties do nothing. If the batch does not fit, none of it is applied.
+ *
+ *  In a dictionary with a capacity or a budget, the batch is checked before any of
+ *  it is applied. Eviction only takes properties the batch does not name, so the
+ *  properties the batch adds or updates have to fit in the capacity, and eviction
+ *  has to be able to make room for them in the budget, or the batch is rejected.
+ *
+ * @param p_dict  dictionary
+ * @param p_batch batch. It is not cleared
+ *
+ * @sa dict_batch_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_apply_batch ( dict *const p_dict, dict_batch *const p_batch );
+
+/** !
+ *  Forget a batch's operations, so it can be reused
+ *
+ * @param p_batch batch
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_batch_clear ( dict_batch *const p_batch );
+
+/** !
+ *  Destroy a batch
+ *
+ * @param pp_batch pointer to batch pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_batch_destroy ( dict_batch **const pp_batch );
+
+// Journal
+/** !
+ *  Replay a dictionary's log file, then append every later change to it. Adds, 
+ *  updates, pops, evictions and clears are each logged as a small binary record,
+ *  buffered up to p_config->batch bytes and written together. A torn record at the
+ *  end of the file, left by a crash, is cut off. Inline values are logged byte for
+ *  byte. A dictionary of pointer values is refused, since its pointers would not 
+ *  survive a restart. Expiry is not logged. Recovered keys are owned by the journal,
+ *  which lives until the dictionary is destroyed. A small dictionary is moved into
+ *  a hash table first. Journals need POSIX file I/O; elsewhere, this fails.
+ *
+ * @param p_dict   dictionary with inline values, and no journal
+ * @param path     path to the log file, created if missing
+ * @param p_config sync, batching and compaction policy -OR- null pointer for a write and fsync per change
+ *
+ * @sa dict_journal_flush
+ * @sa dict_journal_compact
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_journal_open ( dict *const p_dict, const char *const path, const dict_journal_config *const p_config );
+
+/** !
+ *  Write a journal's buffered records, and fsync the log file unless the sync policy
+ *  is DICT_JOURNAL_SYNC_NONE
+ *
+ * @param p_dict dictionary with a journal
+ *
+ * @return 1 on success, 0 on error, or if a write has failed since the journal was opened
+ */
+DLLEXPORT int dict_journal_flush ( dict *const p_dict );
+
+/** !
+ *  Rewrite a journal's log file as one add per property. Changes made while the 
+ *  snapshot is written are copied over after it, and the new file replaces the old
+ *  one with a rename. The dictionary is only locked to take the snapshot, and to 
+ *  copy the changes.
+ *
+ * @param p_dict dictionary with a journal
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_journal_compact ( dict *const p_dict );
+
+// Clear all items
+/** !
+ *  Remove all properties from a dictionary
+ *
+ * @param p_dict dictionary
+ *
+ * @sa dict_copy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_clear ( dict *const p_dict );
+
+/** !
+ *  Remove all properties from a dictionary, and deallocate values with free_func
+ *
+ * @param p_dict       dictionary
+ * @param free_fun_ptr pointer to deallocator function 
+ * 
+ * @sa dict_clear
+ * @sa dict_copy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_free_clear ( dict *const p_dict, void (*const free_func)(const void *const) );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a dictionary
+ *
+ * @param pp_dict dictionary
+ *
+ * @sa dict_create
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_destroy ( dict **const pp_dict );
+
+// Statistics
+/** !
+ *  Start or stop recording statistics on a dictionary. Requires BUILD_DICT_WITH_STATS.
+ *  The counters are allocated by the first start, and kept by a stop.
+ *
+ * @param p_dict dictionary
+ * @param enable true to record statistics, false to stop
+ *
+ * @sa dict_stats
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_stats_enable ( dict *const p_dict, bool enable );
+
+/** !
+ *  Get a dictionary's statistics. Counters accumulate while statistics are enabled;
+ *  the chain histogram is measured on each call.
+ *
+ * @param p_dict       dictionary
+ * @param p_statistics return
+ *
+ * @sa dict_stats_enable
+ * @sa dict_stats_reset
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_stats ( dict *const p_dict, dict_statistics *const p_statistics );
+
+/** !
+ *  Zero a dictionary's statistics
+ *
+ * @param p_dict dictionary
+ *
+ * @sa dict_stats
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_stats_reset ( dict *const p_dict );
+
+// Diagnostics
+/** !
+ *  Measure how evenly a dictionary's hash function spreads its keys over the 
+ *  hash table. Walks every bucket under the lock.
+ *
+ * @param p_dict     dictionary
+ * @param p_analysis return
+ *
+ * @sa dict_stats
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_analyze ( dict *const p_dict, dict_analysis *const p_analysis );
+
+/** !
+ *  Count the bytes a dictionary has allocated, by component
+ *
+ * @param p_dict   dictionary
+ * @param p_memory return
+ *
+ * @sa dict_construct_budget
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int dict_memory_usage ( dict *const p_dict, dict_memory *const p_memory );
+
+// Sharded dictionary
+/** !
+ *  Construct a sharded dictionary. Each key is routed by the high bits of its hash
+ *  to one of several independent dictionaries, each with its own lock, so writers
+ *  on different shards do not contend. 
+ *
+ * @param pp_sharded_dict   return
+ * @param shards            number of shards, rounded up to a power of two
+ * @param size              number of hash table entries, divided evenly among the shards
+ * @param pfn_hash_function pointer to a hash function, or 0 for dict_hash
+ *
+ * @sa sharded_dict_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_construct ( sharded_dict **const pp_sharded_dict, size_t shards, size_t size, fn_hash64 pfn_hash_function );
+
+/** !
+ *  Get a property's value from a sharded dictionary
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param key            the name of the property
+ *
+ * @sa dict_get
+ *
+ * @return pointer to specified property's value on success, null pointer on error
+ */
+DLLEXPORT const void *sharded_dict_get ( sharded_dict *const p_sharded_dict, const char *const key );
+
+/** !
+ *  Get a sharded dictionarys' values, or the number of properties in the sharded 
+ *  dictionary. Each shard is locked in turn, so the result is not a snapshot
+ *  across shards.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param values         return -OR- null pointer
+ *
+ * @sa dict_values
+ *
+ * @return 1 on success, 0 on error, if values != null, else number of properties in sharded dictionary
+ */
+DLLEXPORT size_t sharded_dict_values ( sharded_dict *const p_sharded_dict, void **const values );
+
+/** !
+ *  Get a sharded dictionarys' keys, or the number of properties in the sharded 
+ *  dictionary. Each shard is locked in turn, so the result is not a snapshot
+ *  across shards.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param keys           return -OR- null pointer
+ *
+ * @sa dict_keys
+ *
+ * @return 1 on success, 0 on error, if keys != null, else number of properties in sharded dictionary
+ */
+DLLEXPORT size_t sharded_dict_keys ( sharded_dict *const p_sharded_dict, const char **const keys );
+
+/** !
+ *  Add a property to a sharded dictionary. Only the key's shard is locked.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param key            the name of the property
+ * @param p_value        the value of the property
+ *
+ * @sa dict_add
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_add ( sharded_dict *const p_sharded_dict, const char *const key, void *const p_value );
+
+/** !
+ *  Compare and swap a property in a sharded dictionary. Only the key's shard is locked.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param key            the name of the property
+ * @param expected       the value to compare with
+ * @param desired        the new value
+ *
+ * @sa dict_cas
+ *
+ * @return 1 if the value was replaced, 0 if it was missing, changed, or on error
+ */
+DLLEXPORT int sharded_dict_cas ( sharded_dict *const p_sharded_dict, const char *const key, const void *const expected, void *const desired );
+
+/** !
+ *  Add delta to a counter in a sharded dictionary. Only the key's shard is locked.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param key            the name of the counter
+ * @param delta          the amount to add
+ * @param p_previous     return the count before the add -OR- null pointer
+ *
+ * @sa dict_fetch_add
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_fetch_add ( sharded_dict *const p_sharded_dict, const char *const key, long long delta, long long *const p_previous );
+
+/** !
+ *  Remove a property from a sharded dictionary. Only the key's shard is locked.
+ *
+ * @param p_sharded_dict sharded dictionary
+ * @param key            the name of the property
+ * @param pp_value       return
+ *
+ * @sa dict_pop
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_pop ( sharded_dict *const p_sharded_dict, const char *const key, const void **const pp_value );
+
+/** !
+ *  Call a function on each value in a sharded dictionary
+ * 
+ * @param p_sharded_dict sharded dictionary
+ * @param function       the function to call. 
+ * 
+ * @sa dict_foreach
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_foreach ( sharded_dict *const p_sharded_dict, void (*function)(const void *const, size_t i) );
+
+/** !
+ *  Remove all properties from every shard of a sharded dictionary
+ *
+ * @param p_sharded_dict sharded dictionary
+ *
+ * @sa dict_clear
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_clear ( sharded_dict *const p_sharded_dict );
+
+/** !
+ *  Destroy and deallocate a sharded dictionary
+ *
+ * @param pp_sharded_dict sharded dictionary
+ *
+ * @sa sharded_dict_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_dict_destroy ( sharded_dict **const pp_sharded_dict );
+
+// Replicated dictionary
+/** !
+ *  Construct a replicated dictionary, for read mostly data. Each NUMA node has its
+ *  own copy of the properties, with its hash table bound to the node, so readers
+ *  never cross the interconnect. Writers append to an operation log, which each
+ *  replica applies when it is next read. Writes cost more, and memory grows with
+ *  the number of nodes.
+ *
+ *  Keys and values are borrowed until every replica has applied their removal.
+ *  Call replicated_dict_sync before freeing a removed key.
+ *
+ * @param pp_replicated_dict return
+ * @param size               number of hash table entries in each replica
+ * @param nodes              bit mask of the NUMA nodes to replicate on, or 0 for every node the process may allocate from
+ * @param pfn_hash_function  pointer to a hash function, or 0 for dict_hash
+ *
+ * @sa replicated_dict_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int replicated_dict_construct ( replicated_dict **const pp_replicated_dict, size_t size, unsigned long long nodes, fn_hash64 pfn_hash_function );
+
+/** !
+ *  Get a property's value from the calling thread's NUMA node's replica
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param key               the name of the property
+ *
+ * @sa dict_get
+ *
+ * @return pointer to specified property's value on success, null pointer on error
+ */
+DLLEXPORT const void *replicated_dict_get ( replicated_dict *const p_replicated_dict, const char *const key );
+
+/** !
+ *  Get a property's value from a NUMA node's replica. Threads pinned to a node can
+ *  skip looking their node up. Nodes without a replica read another node's.
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param node              NUMA node
+ * @param key               the name of the property
+ *
+ * @sa replicated_dict_get
+ *
+ * @return pointer to specified property's value on success, null pointer on error
+ */
+DLLEXPORT const void *replicated_dict_get_node ( replicated_dict *const p_replicated_dict, size_t node, const char *const key );
+
+/** !
+ *  Get a replicated dictionary's values from the calling thread's replica, or the
+ *  number of properties in the replicated dictionary
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param values            return -OR- null pointer
+ *
+ * @sa dict_values
+ *
+ * @return 1 on success, 0 on error, if values != null, else number of properties in replicated dictionary
+ */
+DLLEXPORT size_t replicated_dict_values ( replicated_dict *const p_replicated_dict, void **const values );
+
+/** !
+ *  Get a replicated dictionary's keys from the calling thread's replica, or the
+ *  number of properties in the replicated dictionary
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param keys              return -OR- null pointer
+ *
+ * @sa dict_keys
+ *
+ * @return 1 on success, 0 on error, if keys != null, else number of properties in replicated dictionary
+ */
+DLLEXPORT size_t replicated_dict_keys ( replicated_dict *const p_replicated_dict, const char **const keys );
+
+/** !
+ *  Add a property to a replicated dictionary. The calling thread's replica is
+ *  updated now, and the others when they are next read.
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param key               the name of the property
+ * @param p_value           the value of the property
+ *
+ * @sa dict_add
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int replicated_dict_add ( replicated_dict *const p_replicated_dict, const char *const key, void *const p_value );
+
+/** !
+ *  Remove a property from a replicated dictionary. The calling thread's replica is
+ *  updated now, and the others when they are next read.
+ *
+ * @param p_replicated_dict replicated dictionary
+ * @param key               the name of the property
+ * @param pp_value          return -OR- null pointer
+ *
+ * @sa dict_pop
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int replicated_dict_pop ( replicated_dict *const p_replicated_dict, const char *const key, const void **const pp_value );
+
+/** !
+ *  Remove all properties from a replicated dictionary
+ *
+ * @param p_replicated_dict replicated dictionary
+ *
+ * @sa dict_clear
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int replicated_dict_clear ( replicated_dict *const p_replicated_dict );
+
+/** !
+ *  Apply every logged operation to every replica, and empty the log
+ *
+ * @param p_replicated_dict replicated dictionary
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int replicated_dict_sync ( replicated_dict *const p_replicated_dict );
+
+/** !
+ *  Destroy and deallocate a replicated dictionary
+ *
+ * @param pp_replicated_dict replicated dictionary
+ *
+ * @sa replicated_dict_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int replicated_dict_destroy ( replicated_dict **const pp_replicated_dict );
+
+// Integer keyed dictionary
+/** !
+ *  Construct an integer keyed dictionary. Keys are 64-bit integers, stored by value 
+ *  and hashed with an integer mixer, so no string is formatted, hashed or compared.
+ *
+ * @param pp_int_dict return
+ * @param size        number of hash table entries. 
+ *
+ * @sa int_dict_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int int_dict_construct ( int_dict **const pp_int_dict, size_t size );
+
+/** !
+ *  Get a property's value from an integer keyed dictionary
+ *
+ * @param p_int_dict integer keyed dictionary
+ * @param key        the key of the property
+ *
+ * @sa dict_get
+ *
+ * @return pointer to specified property's value on success, null pointer on error
+ */
+DLLEXPORT const void *int_dict_get ( int_dict *const p_int_dict, uint64_t key );
+
+/** !
+ *  Get an integer keyed dictionarys' values, or the number of properties in the 
+ *  dictionary.
+ *
+ * @param p_int_dict integer keyed dictionary
+ * @param values     return -OR- null pointer
+ *
+ * @sa dict_values
+ *
+ * @return 1 on success, 0 on error, if values != null, else number of properties in dictionary
+ */
+DLLEXPORT size_t int_dict_values ( int_dict *const p_int_dict, void **const values );
+
+/** !
+ *  Get an integer keyed dictionarys' keys, or the number of properties in the 
+ *  dictionary.
+ *
+ * @param p_int_dict integer keyed dictionary
+ * @param keys       return -OR- null pointer
+ *
+ * @sa dict_keys
+ *
+ * @return 1 on success, 0 on error, if keys != null, else number of properties in dictionary
+ */
+DLLEXPORT size_t int_dict_keys ( int_dict *const p_int_dict, uint64_t *const keys );
+
+/** !
+ *  Add a property to an integer keyed dictionary. If the key is already in the 
+ *  dictionary, its value is updated.
+ *
+ * @param p_int_dict integer keyed dictionary
+ * @param key        the key of the property
+ * @param p_value    the value of the property
+ *
+ * @sa dict_add
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int int_dict_add ( int_dict *const p_int_dict, uint64_t key, void *const p_value );
+
+/** !
+ *  Remove a property from an integer keyed dictionary
+ *
+ * @param p_int_dict integer keyed dictionary
+ * @param key        the key of the property
+ * @param pp_value   return -OR- null pointer
+ *
+ * @sa dict_pop
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int int_dict_pop ( int_dict *const p_int_dict, uint64_t key, const void **const pp_value );
+
+/** !
+ *  Call a function on each value in an integer keyed dictionary
+ * 
+ * @param p_int_dict integer keyed dictionary
+ * @param function   the function to call. 
+ * 
+ * @sa dict_foreach
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int int_dict_foreach ( int_dict *const p_int_dict, void (*function)(const void *const, size_t i) );
+
+/** !
+ *  Remove all properties from an integer keyed dictionary
+ *
+ * @param p_int_dict integer keyed dictionary
+ *
+ * @sa dict_clear
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int int_dict_clear ( int_dict *const p_int_dict );
+
+/** !
+ *  Destroy and deallocate an integer keyed dictionary
+ *
+ * @param pp_int_dict integer keyed dictionary
+ *
+ * @sa int_dict_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int int_dict_destroy ( int_dict **const pp_int_dict );
+
+// String interning
+/** !
+ *  Construct a string interning table. Each distinct string is copied once, and 
+ *  given a dense integer ID, counting up from 0. IDs and canonical strings are 
+ *  stable until the table is destroyed, so interned strings compare by ID.
+ *
+ * @param pp_intern_table return
+ * @param size            number of hash table entries. 
+ *
+ * @sa intern_table_destroy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int intern_table_construct ( intern_table **const pp_intern_table, size_t size );
+
+/** !
+ *  Intern a string. If the string is new, it is copied and given the next ID.
+ *
+ * @param p_intern_table string interning table
+ * @param string         the string
+ * @param p_id           return -OR- null pointer
+ * @param pp_string      return the canonical copy of the string -OR- null pointer
+ *
+ * @sa intern_table_find
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int intern_table_intern ( intern_table *const p_intern_table, const char *const string, size_t *const p_id, const char **const pp_string );
+
+/** !
+ *  Find the ID of a string, without interning it
+ *
+ * @param p_intern_table string interning table
+ * @param string         the string
+ * @param p_id           return -OR- null pointer
+ *
+ * @sa intern_table_intern
+ *
+ * @return 1 if the string is interned, else 0
+ */
+DLLEXPORT int intern_table_find ( intern_table *const p_intern_table, const char *const string, size_t *const p_id );
+
+/** !
+ *  Get the canonical string for an ID
+ *
+ * @param p_intern_table string interning table
+ * @param id             the ID
+ *
+ * @return the canonical string on success, null pointer on error
+ */
+DLLEXPORT const char *intern_table_string ( intern_table *const p_intern_table, size_t id );
+
+/** !
+ *  Get the number of interned strings, which is also the next ID
+ *
+ * @param p_intern_table string interning table
+ *
+ * @return number of interned strings
+ */
+DLLEXPORT size_t intern_table_count ( intern_table *const p_intern_table );
+
+/** !
+ *  Count the bytes an intern table has allocated, including its canonical strings
+ *
+ * @param p_intern_table intern table
+ * @param p_memory       return
+ *
+ * @sa dict_memory_usage
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int intern_table_memory_usage ( intern_table *const p_intern_table, dict_memory *const p_memory );
+
+/** !
+ *  Destroy and deallocate a string interning table, and its canonical strings
+ *
+ * @param pp_intern_table string interning table
+ *
+ * @sa intern_table_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int intern_table_destroy ( intern_table **const pp_intern_table );
+
+// Shared memory dictionary
+/** !
+ *  Construct a dictionary in a shared memory region. Buckets, properties, keys and
+ *  the iterable array are addressed by offsets into the region, so other processes
+ *  can map it anywhere and query it in place. Keys and values are copied into the
+ *  region, which never grows; an add that does not fit fails. Nothing in the region
+ *  is reused until shm_dict_clear, so a value from shm_dict_get stays valid after an
+ *  update or a pop, until the generation changes. The keys are hashed with dict_hash. Shared memory dictionaries
+ *  need POSIX shared memory; elsewhere, every shm_dict function fails.
+ *
+ * @param pp_shm_dict return
+ * @param name        the shared memory object to create, like "/name", which must not exist -OR- null pointer for an anonymous region, shared with processes forked after this call
+ * @param size        number of hash table entries
+ * @param bytes       size of the region, including the hash table
+ *
+ * @sa shm_dict_open
+ * @sa shm_dict_close
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int shm_dict_create ( shm_dict **const pp_shm_dict, const char *const name, size_t size, size_t bytes );
+
+/** !
+ *  Attach to a shared memory dictionary created by another process
+ *
+ * @param pp_shm_dict return
+ * @param name        the shared memory object passed to shm_dict_create
+ *
+ * @sa shm_dict_create
+ * @sa shm_dict_close
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int shm_dict_open ( shm_dict **const pp_shm_dict, const char *const name );
+
+/** !
+ *  Get a property's value from a shared memory dictionary. Lookups only take the
+ *  read side of the process shared lock, so processes query in parallel.
+ *
+ * @param p_shm_dict shared memory dictionary
+ * @param key        the name of the property
+ * @param p_size     return the bytes of the value -OR- null pointer
+ *
+ * @return a pointer to the value in this process's mapping if it exists, else null pointer
+ */
+DLLEXPORT const void *shm_dict_get ( shm_dict *const p_shm_dict, const char *const key, size_t *const p_size );
+
+/** !
+ *  Get a list of a shared memory dictionary's values, in insertion order
+ *
+ * @param p_shm_dict shared memory dictionary
+ * @param values     return -OR- null pointer
+ *
+ * @return the number of properties if values is null pointer, else 1 on success, 0 on error
+ */
+DLLEXPORT size_t shm_dict_values ( shm_dict *const p_shm_dict, const void **const values );
+
+/** !
+ *  Get a list of a shared memory dictionary's keys, in insertion order
+ *
+ * @param p_shm_dict shared memory dictionary
+ * @param keys       return -OR- null pointer
+ *
+ * @return the number of properties if keys is null pointer, else 1 on success, 0 on error
+ */
+DLLEXPORT size_t shm_dict_keys ( shm_dict *const p_shm_dict, const char **const keys );
+
+/** !
+ *  Add or update a property in a shared memory dictionary, copying the key and
+ *  size bytes of the value into the region
+ *
+ * @param p_shm_dict shared memory dictionary
+ * @param key        the name of the property
+ * @param p_value    the value
+ * @param size       bytes of the value
+ *
+ * @return 1 on success, 0 if the region is full or on error
+ */
+DLLEXPORT int shm_dict_add ( shm_dict *const p_shm_dict, const char *const key, const void *const p_value, size_t size );
+
+/** !
+ *  Remove a property from a shared memory dictionary
+ *
+ * @param p_shm_dict shared memory dictionary
+ * @param key        the name of the property
+ * @param pp_value   return -OR- null pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int shm_dict_pop ( shm_dict *const p_shm_dict, const char *const key, const void **const pp_value );
+
+/** !
+ *  Remove every property from a shared memory dictionary, and reclaim the region.
+ *  Values from shm_dict_get and shm_dict_pop are invalid afterwards, in every 
+ *  process, and the generation is incremented before the region is reused.
+ *
+ * @param p_shm_dict shared memory dictionary
+ *
+ * @sa shm_dict_generation
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int shm_dict_clear ( shm_dict *const p_shm_dict );
+
+/** !
+ *  Get a shared memory dictionary's generation, which each shm_dict_clear increments.
+ *  A reader that may race a clear in another process reads the generation, gets and
+ *  copies a value, then reads the generation again. The copy is good if they match.
+ *
+ * @param p_shm_dict shared memory dictionary
+ *
+ * @return the generation, or 0 on error
+ */
+DLLEXPORT unsigned long long shm_dict_generation ( shm_dict *const p_shm_dict );
+
+/** !
+ *  Unmap a shared memory dictionary from this process. The region lives on in other
+ *  processes, and under its name until shm_dict_unlink.
+ *
+ * @param pp_shm_dict shared memory dictionary
+ *
+ * @sa shm_dict_create
+ * @sa shm_dict_open
+ * @sa shm_dict_unlink
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int shm_dict_close ( shm_dict **const pp_shm_dict );
+
+/** !
+ *  Remove a shared memory dictionary's name, so no more processes can attach
+ *
+ * @param name the shared memory object passed to shm_dict_create
+ *
+ * @sa shm_dict_create
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int shm_dict_unlink ( const char *const name );
 
 // Cleanup
 /** !
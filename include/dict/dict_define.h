@@ -0,0 +1,379 @@
+/** !
+ * @file dict/dict_define.h
+ *
+ * @author Jacob Smith
+ *
+ * Header only generator for type specialized dictionaries.
+ *
+ *     DICT_DEFINE(name, key_t, value_t, hash, eq)
+ *
+ * emits a dictionary type "name", keyed by key_t, that stores value_t by value.
+ * "hash" is called as hash(key) and returns a 64-bit hash. "eq" is called as
+ * eq(a, b) and returns nonzero if the keys are equal. Both may be functions
+ * or macros, and are inlined into the generated code.
+ *
+ * The generated functions are the dict surface, with values passed by value:
+ *
+ *     int    name_construct ( name **pp_dict, size_t size );
+ *     int    name_get       ( name  *p_dict, key_t key, value_t *p_value );
+ *     size_t name_values    ( name  *p_dict, value_t *values );
+ *     size_t name_keys      ( name  *p_dict, key_t *keys );
+ *     int    name_add       ( name  *p_dict, key_t key, value_t value );
+ *     int    name_pop       ( name  *p_dict, key_t key, value_t *p_value );
+ *     int    name_foreach   ( name  *p_dict, void (*function)(value_t *, size_t) );
+ *     int    name_clear     ( name  *p_dict );
+ *     int    name_destroy   ( name **pp_dict );
+ *
+ * Properties are chained by hash, and stored in dense key, value and link
+ * arrays, so there is no allocation per property, and keys and values export
+ * with one memcpy. DICT_DEFINE_TABLE emits just the table and its unlocked
+ * helpers, for a container with its own public functions; int_dict is one.
+ */
+
+// Include guard
+#pragma once
+
+// dict
+#include <dict/dict.h>
+
+/** !
+ *  Mix a 64-bit integer into a hash, with the MurmurHash3 finalizer
+ *
+ * @param k the integer
+ *
+ * @return the hash of the integer
+ */
+static inline uint64_t dict_mix64 ( uint64_t k )
+{
+
+    // Mix
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+
+    // Done
+    return k;
+}
+
+// Equality for keys that compare with ==
+#define DICT_EQ(a, b) ( (a) == (b) )
+
+// Table generator. Emits struct name##_s, and the unlocked helpers prefix##_find,
+// prefix##_resize, prefix##_insert and prefix##_remove. The caller holds the lock
+#define DICT_DEFINE_TABLE(name, prefix, key_t, value_t, hash, eq)                                        \
+                                                                                                         \
+struct name##_s                                                                                          \
+{                                                                                                        \
+    struct                                                                                               \
+    {                                                                                                    \
+        size_t *data; /* Index + 1 of the first property in each bucket, or 0 */                         \
+        size_t  max;  /* Hash table elements */                                                          \
+    } buckets;                                                                                           \
+                                                                                                         \
+    struct                                                                                               \
+    {                                                                                                    \
+        key_t    *keys;   /* Keys */                                                                     \
+        value_t  *values; /* Values */                                                                   \
+        size_t   *next,   /* Index + 1 of the next property in the same bucket, or 0 */                  \
+                  count,  /* Entries */                                                                  \
+                  max;    /* Entry array bound */                                                        \
+    } entries;                                                                                           \
+                                                                                                         \
+    mutex _lock;                                                                                         \
+};                                                                                                       \
+                                                                                                         \
+/* Find a key. Returns the link that holds its index + 1, or the empty link at the end of the chain */   \
+static inline size_t *prefix##_find ( struct name##_s *const p_dict, key_t key )                         \
+{                                                                                                        \
+    size_t *p_link = &p_dict->buckets.data[(uint64_t) (hash(key)) % p_dict->buckets.max];                \
+                                                                                                         \
+    /* Walk the chain */                                                                                 \
+    while ( *p_link && !(eq(p_dict->entries.keys[*p_link - 1], key)) )                                   \
+        p_link = &p_dict->entries.next[*p_link - 1];                                                     \
+                                                                                                         \
+    return p_link;                                                                                       \
+}                                                                                                        \
+                                                                                                         \
+/* Resize the entry arrays. The new arrays are committed with the bound only when all three              \
+   allocations succeed, so on error the dictionary is untouched */                                       \
+static inline int prefix##_resize ( struct name##_s *const p_dict, size_t max )                          \
+{                                                                                                        \
+    key_t    *keys   = DICT_REALLOC(0, max * sizeof(key_t));                                             \
+    value_t  *values = DICT_REALLOC(0, max * sizeof(value_t));                                           \
+    size_t   *next   = DICT_REALLOC(0, max * sizeof(size_t));                                            \
+                                                                                                         \
+    if ( keys == (void *) 0 || values == (void *) 0 || next == (void *) 0 )                              \
+    {                                                                                                    \
+        if ( keys   ) keys = DICT_REALLOC(keys, 0);                                                      \
+        if ( values ) values = DICT_REALLOC(values, 0);                                                  \
+        if ( next   ) next = DICT_REALLOC(next, 0);                                                      \
+        return 0;                                                                                        \
+    }                                                                                                    \
+                                                                                                         \
+    /* Copy the properties */                                                                            \
+    if ( p_dict->entries.count )                                                                         \
+    {                                                                                                    \
+        memcpy(keys  , p_dict->entries.keys  , p_dict->entries.count * sizeof(key_t));                   \
+        memcpy(values, p_dict->entries.values, p_dict->entries.count * sizeof(value_t));                 \
+        memcpy(next  , p_dict->entries.next  , p_dict->entries.count * sizeof(size_t));                  \
+    }                                                                                                    \
+                                                                                                         \
+    /* Commit */                                                                                         \
+    if ( p_dict->entries.keys   ) p_dict->entries.keys = DICT_REALLOC(p_dict->entries.keys, 0);          \
+    if ( p_dict->entries.values ) p_dict->entries.values = DICT_REALLOC(p_dict->entries.values, 0);      \
+    if ( p_dict->entries.next   ) p_dict->entries.next = DICT_REALLOC(p_dict->entries.next, 0);          \
+    p_dict->entries.keys   = keys;                                                                       \
+    p_dict->entries.values = values;                                                                     \
+    p_dict->entries.next   = next;                                                                       \
+    p_dict->entries.max    = max;                                                                        \
+                                                                                                         \
+    return 1;                                                                                            \
+}                                                                                                        \
+                                                                                                         \
+/* Add or update a property. Returns 0 if the entry arrays can not grow */                               \
+static inline int prefix##_insert ( struct name##_s *const p_dict, key_t key, value_t value )            \
+{                                                                                                        \
+    size_t *p_link = prefix##_find(p_dict, key),                                                         \
+            idx    = 0;                                                                                  \
+                                                                                                         \
+    /* Update an existing property */                                                                    \
+    if ( *p_link )                                                                                       \
+    {                                                                                                    \
+        p_dict->entries.values[*p_link - 1] = value;                                                     \
+        return 1;                                                                                        \
+    }                                                                                                    \
+                                                                                                         \
+    /* Grow the entry arrays? The link may move with them */                                             \
+    if ( p_dict->entries.count == p_dict->entries.max )                                                  \
+    {                                                                                                    \
+        if ( prefix##_resize(p_dict, ( p_dict->entries.max ) ? p_dict->entries.max * 2 : DICT_SMALL_MAX) == 0 ) return 0; \
+        p_link = prefix##_find(p_dict, key);                                                             \
+    }                                                                                                    \
+                                                                                                         \
+    /* Append the property, and link it into the chain */                                                \
+    idx = p_dict->entries.count++;                                                                       \
+    p_dict->entries.keys[idx]   = key;                                                                   \
+    p_dict->entries.values[idx] = value;                                                                 \
+    p_dict->entries.next[idx]   = 0;                                                                     \
+    *p_link = idx + 1;                                                                                   \
+                                                                                                         \
+    return 1;                                                                                            \
+}                                                                                                        \
+                                                                                                         \
+/* Remove a property. Returns 0 if the key is not in the dictionary */                                   \
+static inline int prefix##_remove ( struct name##_s *const p_dict, key_t key, value_t *const p_value )   \
+{                                                                                                        \
+    size_t *p_link = prefix##_find(p_dict, key),                                                         \
+            idx    = 0,                                                                                  \
+            last   = 0;                                                                                  \
+                                                                                                         \
+    if ( *p_link == 0 ) return 0;                                                                        \
+                                                                                                         \
+    /* Return the value, and unlink the property */                                                      \
+    idx  = *p_link - 1;                                                                                  \
+    last = p_dict->entries.count - 1;                                                                    \
+    if ( p_value ) *p_value = p_dict->entries.values[idx];                                               \
+    *p_link = p_dict->entries.next[idx];                                                                 \
+                                                                                                         \
+    /* Move the last property into the hole */                                                           \
+    if ( idx != last )                                                                                   \
+    {                                                                                                    \
+        *prefix##_find(p_dict, p_dict->entries.keys[last]) = idx + 1;                                    \
+        p_dict->entries.keys[idx]   = p_dict->entries.keys[last];                                        \
+        p_dict->entries.values[idx] = p_dict->entries.values[last];                                      \
+        p_dict->entries.next[idx]   = p_dict->entries.next[last];                                        \
+    }                                                                                                    \
+    p_dict->entries.count--;                                                                             \
+                                                                                                         \
+    /* Shrink the entry arrays? The property is already removed, and a failed shrink leaves */           \
+    /* the larger arrays and their bound in place, so the result does not change the outcome */          \
+    if ( p_dict->entries.max > DICT_SMALL_MAX && p_dict->entries.count <= p_dict->entries.max / 4 )      \
+        (void) prefix##_resize(p_dict, p_dict->entries.max / 2);                                         \
+                                                                                                         \
+    return 1;                                                                                            \
+}
+
+// Generator
+#define DICT_DEFINE(name, key_t, value_t, hash, eq)                                                      \
+                                                                                                         \
+typedef struct name##_s name;                                                                            \
+                                                                                                         \
+DICT_DEFINE_TABLE(name, name, key_t, value_t, hash, eq)                                                  \
+                                                                                                         \
+static inline int name##_construct ( name **const pp_dict, size_t size )                                 \
+{                                                                                                        \
+    name *p_dict = 0;                                                                                    \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( pp_dict == (void *) 0 || size == 0 ) return 0;                                                  \
+                                                                                                         \
+    /* Allocate a dictionary */                                                                          \
+    p_dict = DICT_REALLOC(0, sizeof(name));                                                              \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+    memset(p_dict, 0, sizeof(name));                                                                     \
+                                                                                                         \
+    /* Allocate "size" buckets */                                                                        \
+    p_dict->buckets.data = DICT_REALLOC(0, size * sizeof(size_t));                                       \
+    p_dict->buckets.max  = size;                                                                         \
+    if ( p_dict->buckets.data == (void *) 0 ) goto failed;                                               \
+    memset(p_dict->buckets.data, 0, size * sizeof(size_t));                                              \
+                                                                                                         \
+    /* Create a mutex */                                                                                 \
+    if ( mutex_create(&p_dict->_lock) == 0 ) goto failed;                                                \
+                                                                                                         \
+    /* Return a pointer to the caller */                                                                 \
+    *pp_dict = p_dict;                                                                                   \
+                                                                                                         \
+    return 1;                                                                                            \
+                                                                                                         \
+    failed:                                                                                              \
+        if ( p_dict->buckets.data && DICT_REALLOC(p_dict->buckets.data, 0) ) return 0;                   \
+        if ( DICT_REALLOC(p_dict, 0) ) return 0;                                                         \
+        return 0;                                                                                        \
+}                                                                                                        \
+                                                                                                         \
+static inline int name##_get ( name *const p_dict, key_t key, value_t *const p_value )                   \
+{                                                                                                        \
+    size_t link = 0;                                                                                     \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Find the property, and copy out its value */                                                      \
+    link = *name##_find(p_dict, key);                                                                    \
+    if ( link && p_value ) *p_value = p_dict->entries.values[link - 1];                                  \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    /* Found? */                                                                                         \
+    return link != 0;                                                                                    \
+}                                                                                                        \
+                                                                                                         \
+static inline size_t name##_values ( name *const p_dict, value_t *const values )                         \
+{                                                                                                        \
+    size_t entry_count = 0;                                                                              \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Counting branch? */                                                                               \
+    entry_count = p_dict->entries.count;                                                                 \
+    if ( values && entry_count ) memcpy(values, p_dict->entries.values, entry_count * sizeof(value_t));  \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    return ( values ) ? 1 : entry_count;                                                                 \
+}                                                                                                        \
+                                                                                                         \
+static inline size_t name##_keys ( name *const p_dict, key_t *const keys )                               \
+{                                                                                                        \
+    size_t entry_count = 0;                                                                              \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Counting branch? */                                                                               \
+    entry_count = p_dict->entries.count;                                                                 \
+    if ( keys && entry_count ) memcpy(keys, p_dict->entries.keys, entry_count * sizeof(key_t));          \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    return ( keys ) ? 1 : entry_count;                                                                   \
+}                                                                                                        \
+                                                                                                         \
+static inline int name##_add ( name *const p_dict, key_t key, value_t value )                            \
+{                                                                                                        \
+    int result = 0;                                                                                      \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Add or update the property */                                                                     \
+    result = name##_insert(p_dict, key, value);                                                          \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    return result;                                                                                       \
+}                                                                                                        \
+                                                                                                         \
+static inline int name##_pop ( name *const p_dict, key_t key, value_t *const p_value )                   \
+{                                                                                                        \
+    int result = 0;                                                                                      \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Remove the property */                                                                            \
+    result = name##_remove(p_dict, key, p_value);                                                        \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    return result;                                                                                       \
+}                                                                                                        \
+static inline int name##_foreach ( name *const p_dict, void (*function)(value_t *, size_t) )             \
+{                                                                                                        \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 || function == (void *) 0 ) return 0;                                      \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Call the function on each value */                                                                \
+    for (size_t i = 0; i < p_dict->entries.count; i++)                                                   \
+        function(&p_dict->entries.values[i], i);                                                         \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    return 1;                                                                                            \
+}                                                                                                        \
+                                                                                                         \
+static inline int name##_clear ( name *const p_dict )                                                    \
+{                                                                                                        \
+    /* Argument check */                                                                                 \
+    if ( p_dict == (void *) 0 ) return 0;                                                                \
+                                                                                                         \
+    mutex_lock(&p_dict->_lock);                                                                          \
+                                                                                                         \
+    /* Empty every bucket. The entry arrays are kept for reuse */                                        \
+    memset(p_dict->buckets.data, 0, p_dict->buckets.max * sizeof(size_t));                               \
+    p_dict->entries.count = 0;                                                                           \
+                                                                                                         \
+    mutex_unlock(&p_dict->_lock);                                                                        \
+                                                                                                         \
+    return 1;                                                                                            \
+}                                                                                                        \
+                                                                                                         \
+static inline int name##_destroy ( name **const pp_dict )                                                \
+{                                                                                                        \
+    name *p_dict = 0;                                                                                    \
+                                                                                                         \
+    /* Argument check */                                                                                 \
+    if ( pp_dict == (void *) 0 || *pp_dict == (void *) 0 ) return 0;                                     \
+                                                                                                         \
+    /* No more pointer for end user */                                                                   \
+    p_dict   = *pp_dict;                                                                                 \
+    *pp_dict = (name *) 0;                                                                               \
+                                                                                                         \
+    /* Free the entry arrays, and the hash table */                                                      \
+    if ( p_dict->entries.keys   && DICT_REALLOC(p_dict->entries.keys  , 0) ) return 0;                   \
+    if ( p_dict->entries.values && DICT_REALLOC(p_dict->entries.values, 0) ) return 0;                   \
+    if ( p_dict->entries.next   && DICT_REALLOC(p_dict->entries.next  , 0) ) return 0;                   \
+    if ( DICT_REALLOC(p_dict->buckets.data, 0) ) return 0;                                               \
+                                                                                                         \
+    /* Destroy the mutex, and free the dictionary */                                                     \
+    mutex_destroy(&p_dict->_lock);                                                                       \
+    if ( DICT_REALLOC(p_dict, 0) ) return 0;                                                             \
+                                                                                                         \
+    return 1;                                                                                            \
+}